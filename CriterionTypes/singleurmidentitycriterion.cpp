@@ -1,4 +1,5 @@
 #include "singleurmidentitycriterion.h"
+#include "internedString.h"
 
 SingleURMIdentityCriterion::SingleURMIdentityCriterion(const QString& urmName, float weight, bool penaltyStatus)
-    : Criterion(weight, penaltyStatus), urmName(urmName) {}
+    : Criterion(weight, penaltyStatus), urmName(urmName), urmID(InternedString::intern(urmName)) {}
@@ -7,6 +7,7 @@
 class SingleURMIdentityCriterion : public Criterion {
 public:
     QString urmName;
+    int urmID;          // the ID of urmName among the interned responses, resolved once so that scoring compares integers
 
     SingleURMIdentityCriterion(const QString& urmName, float weight, bool penaltyStatus);
 };
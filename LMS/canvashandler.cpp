@@ -12,6 +12,8 @@
 #include <QTimer>
 #include <QUrlQuery>
 #include <QVBoxLayout>
+#include <QtConcurrentRun>
+#include <functional>
 
 CanvasHandler::CanvasHandler(QWidget *parent) : LMS(parent), parent(parent) {
     initOAuth2();
@@ -643,73 +645,133 @@ QUrl CanvasHandler::getQuizResultsURL(const int courseID, const int quizID) {
     return {quizReportFileURL.first()};
 }
 
+//////////////////
+// Download all the pages of results, pipelined: the request for each page is sent as soon as the previous page's headers give its URL,
+// rather than after the previous page has fully downloaded, and each page is parsed on a worker thread while the others are downloading.
+//////////////////
 void CanvasHandler::getPaginatedCanvasResults(const QString &initialURL, const QStringList &stringParams, QList<QStringList*> &stringVals,
                                                                          const QStringList &intParams, QList<QList<int>*> &intVals,
                                                                          const QStringList &stringInSubobjectParams, QList<QStringList*> &stringInSubobjectVals,
                                                                          const QStringList &intInSubArrayParams, QList<QList<int>*> &intInSubArrayVals) {
-    QEventLoop loop;
-    QNetworkReply *reply = nullptr;
-    QString url = baseURL+initialURL, replyHeader;
-    QByteArray replyBody;
-    QJsonDocument json_doc;
-    QJsonArray json_array;
-    int numPages = 0;
-
-    do {
-        reply = OAuthFlow->get(url);
+    // ask for as many results per page as Canvas allows, to minimize the number of pages
+    QUrl url(baseURL+initialURL);
+    QUrlQuery query(url);
+    if(!query.hasQueryItem("per_page")) {
+        query.addQueryItem("per_page", QString::number(MAX_RESULTS_PER_PAGE));
+        url.setQuery(query);
+    }
 
-        connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-        loop.exec();
-        if(reply->bytesAvailable() == 0) {
-            //qDebug() << "no reply";
-            reply->deleteLater();
+    QEventLoop loop;
+    QList<QFuture<CanvasPage>> pages;       // in order, each filled in when that page has downloaded
+    int numRepliesPending = 0;
+    bool stopRequesting = false;
+    std::function<void(const QUrl &)> requestPage;
+    const auto requestNextPage = [&requestPage, &pages, &stopRequesting](QNetworkReply *reply) {
+        if(stopRequesting || reply->property("nextPageRequested").toBool()) {
             return;
         }
-
-        replyHeader = reply->rawHeader("Link");
-        replyBody = reply->readAll();
-        //qDebug() << replyBody;
-        json_doc = QJsonDocument::fromJson(replyBody);
-        if(json_doc.isArray()) {
-            json_array = json_doc.array();
+        static const QRegularExpression nextURL(R"(^.*\<(.*?)\>; rel="next")");
+        const QString nextURLString = nextURL.match(reply->rawHeader("Link")).captured(1);
+        if(reply->rawHeader("Link").isEmpty() && !reply->isFinished()) {
+            return;         // the headers aren't here yet
         }
-        else if(json_doc.isObject()) {
-            json_array << json_doc.object();
+        reply->setProperty("nextPageRequested", true);
+        if(!nextURLString.isEmpty() && (pages.size() < NUM_PAGES_TO_LOAD)) {
+            requestPage(QUrl(nextURLString));
         }
-        else {
-            //empty or null
+    };
+    requestPage = [&](const QUrl &pageURL) {
+        const int pageNum = int(pages.size());
+        pages.append(QFuture<CanvasPage>());
+        QNetworkReply *reply = OAuthFlow->get(pageURL);
+        numRepliesPending++;
+
+        connect(reply, &QNetworkReply::metaDataChanged, &loop, [&requestNextPage, reply]() {requestNextPage(reply);});
+        connect(reply, &QNetworkReply::finished, &loop, [&, reply, pageNum]() {
+            requestNextPage(reply);
+            const QByteArray replyBody = reply->readAll();
+            reply->deleteLater();
+            if(replyBody.isEmpty()) {
+                //qDebug() << "no reply";
+                stopRequesting = true;
+            }
+            pages[pageNum] = QtConcurrent::run(&CanvasHandler::parseCanvasPage, replyBody,
+                                               stringParams, intParams, stringInSubobjectParams, intInSubArrayParams);
+            numRepliesPending--;
+            if(numRepliesPending == 0) {
+                loop.quit();
+            }
+        });
+    };
+    requestPage(url);
+    loop.exec();
+
+    // collect the results in page order, stopping at the first page that was empty or unreadable
+    for(auto &page : pages) {
+        const CanvasPage results = page.result();
+        if(!results.valid) {
             break;
         }
+        for(int i = 0; i < stringParams.size(); i++) {
+            *(stringVals[i]) << results.stringVals.at(i);
+        }
+        for(int i = 0; i < intParams.size(); i++) {
+            *(intVals[i]) << results.intVals.at(i);
+        }
+        for(int i = 0; i < stringInSubobjectParams.size(); i++) {
+            *(stringInSubobjectVals[i]) << results.stringInSubobjectVals.at(i);
+        }
+        for(int i = 0; i < intInSubArrayParams.size(); i++) {
+            *(intInSubArrayVals[i]) << results.intInSubArrayVals.at(i);
+        }
+    }
+}
 
-        for(const auto &value : qAsConst(json_array)) {
-            const QJsonObject json_obj = value.toObject();
-            for(int i = 0; i < stringParams.size(); i++) {
-                *(stringVals[i]) << json_obj[stringParams.at(i)].toString("");
-            }
-            for(int i = 0; i < intParams.size(); i++) {
-                *(intVals[i]) << json_obj[intParams.at(i)].toInt();
-            }
-            for(int i = 0; i < stringInSubobjectParams.size(); i++) {
-                const QStringList subobjectAndParamName = stringInSubobjectParams.at(i).split('/');   // "subobject_name/string_paramater_name"
-                const QJsonObject object = json_obj[subobjectAndParamName.at(0)].toObject();
-                *(stringInSubobjectVals[i]) << object[subobjectAndParamName.at(1)].toString();
-            }
-            for(int i = 0; i < intInSubArrayParams.size(); i++) {
-                const QStringList subarrayAndParamName = intInSubArrayParams.at(i).split('/');   // "subarray_name/int_paramater_name"
-                const QJsonArray array = json_obj[subarrayAndParamName.at(0)].toArray();
-                for(const auto &item : array) {
-                    QJsonObject subobj = item.toObject();
-                    *(intInSubArrayVals[i]) << subobj[subarrayAndParamName.at(1)].toInt();
-                }
+CanvasHandler::CanvasPage CanvasHandler::parseCanvasPage(const QByteArray &replyBody, const QStringList &stringParams, const QStringList &intParams,
+                                                         const QStringList &stringInSubobjectParams, const QStringList &intInSubArrayParams) {
+    CanvasPage page;
+    //qDebug() << replyBody;
+    const QJsonDocument json_doc = QJsonDocument::fromJson(replyBody);
+    QJsonArray json_array;
+    if(json_doc.isArray()) {
+        json_array = json_doc.array();
+    }
+    else if(json_doc.isObject()) {
+        json_array << json_doc.object();
+    }
+    else {
+        //empty or null
+        return page;
+    }
+
+    page.valid = true;
+    page.stringVals.resize(stringParams.size());
+    page.intVals.resize(intParams.size());
+    page.stringInSubobjectVals.resize(stringInSubobjectParams.size());
+    page.intInSubArrayVals.resize(intInSubArrayParams.size());
+    for(const auto &value : qAsConst(json_array)) {
+        const QJsonObject json_obj = value.toObject();
+        for(int i = 0; i < stringParams.size(); i++) {
+            page.stringVals[i] << json_obj[stringParams.at(i)].toString("");
+        }
+        for(int i = 0; i < intParams.size(); i++) {
+            page.intVals[i] << json_obj[intParams.at(i)].toInt();
+        }
+        for(int i = 0; i < stringInSubobjectParams.size(); i++) {
+            const QStringList subobjectAndParamName = stringInSubobjectParams.at(i).split('/');   // "subobject_name/string_paramater_name"
+            const QJsonObject object = json_obj[subobjectAndParamName.at(0)].toObject();
+            page.stringInSubobjectVals[i] << object[subobjectAndParamName.at(1)].toString();
+        }
+        for(int i = 0; i < intInSubArrayParams.size(); i++) {
+            const QStringList subarrayAndParamName = intInSubArrayParams.at(i).split('/');   // "subarray_name/int_paramater_name"
+            const QJsonArray array = json_obj[subarrayAndParamName.at(0)].toArray();
+            for(const auto &item : array) {
+                QJsonObject subobj = item.toObject();
+                page.intInSubArrayVals[i] << subobj[subarrayAndParamName.at(1)].toInt();
             }
         }
-        static const QRegularExpression nextURL(R"(^.*\<(.*?)\>; rel="next")");
-        const QRegularExpressionMatch nextURLMatch = nextURL.match(replyHeader);
-        url = nextURLMatch.captured(1);
     }
-    while(!url.isNull() && ++numPages < NUM_PAGES_TO_LOAD);
-
-    reply->deleteLater();
+    return page;
 }
 
 void CanvasHandler::postToCanvasGetSingleResult(const QString &URL, const QByteArray &postData,
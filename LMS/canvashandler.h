@@ -46,6 +46,10 @@ private:
     int getQuizID(const QString &quizName);
     QUrl getQuizResultsURL(const int courseID, const int quizID);
 
+    struct CanvasPage {bool valid = false; QList<QStringList> stringVals; QList<QList<int>> intVals;
+                       QList<QStringList> stringInSubobjectVals; QList<QList<int>> intInSubArrayVals;};
+    static CanvasPage parseCanvasPage(const QByteArray &replyBody, const QStringList &stringParams, const QStringList &intParams,
+                                      const QStringList &stringInSubobjectParams, const QStringList &intInSubArrayParams);
     void getPaginatedCanvasResults(const QString &initialURL, const QStringList &stringParams, QList<QStringList*> &stringVals,
                                                               const QStringList &intParams, QList<QList<int>*> &intVals,
                                                               const QStringList &stringInSubobjectParams, QList<QStringList*> &stringInSubobjectVals,
@@ -72,6 +76,7 @@ private:
     std::function<void(QAbstractOAuth::Stage stage, QMultiMap<QString, QVariant> *parameters)> getModifyParametersFunction() const override;
 
     inline static const int NUM_PAGES_TO_LOAD = 20;
+    inline static const int MAX_RESULTS_PER_PAGE = 100;     // the most that Canvas will return in one page
     inline static const char SCOPES[]{"url:GET|/api/v1/courses "                                             // get list of user's courses
                                       "url:GET|/api/v1/courses/:course_id/users "                            // get roster of students in a course
                                       "url:POST|/api/v1/courses/:course_id/quizzes "                         // create a quiz (i.e., survey)
@@ -1,75 +1,152 @@
 #include "Levenshtein.h"
-#include <vector>
+#include <QVarLengthArray>
+#include <algorithm>
 
-int levenshtein::distance(const QString &source, const QString &target, const Qt::CaseSensitivity cs)
-{
-    // (mostly from https://qgis.org/api/qgsstringutils_8cpp_source.html)
+namespace {
+    // bit masks of the positions at which each character appears in a string of up to 64 code units
+    class PositionMasks
+    {
+    public:
+        explicit PositionMasks(QStringView pattern) {
+            quint64 bit = 1;
+            for(const QChar &ch : pattern) {
+                const char16_t c = ch.unicode();
+                if(c < NUMASCII) {
+                    ascii[c] |= bit;
+                }
+                else {
+                    int i = 0;
+                    while((i < numOther) && (otherChars[i] != c)) {
+                        i++;
+                    }
+                    if(i == numOther) {
+                        otherChars[numOther] = c;
+                        otherMasks[numOther] = 0;
+                        numOther++;
+                    }
+                    otherMasks[i] |= bit;
+                }
+                bit <<= 1;
+            }
+        }
+        quint64 operator[](const QChar &ch) const {
+            const char16_t c = ch.unicode();
+            if(c < NUMASCII) {
+                return ascii[c];
+            }
+            for(int i = 0; i < numOther; i++) {
+                if(otherChars[i] == c) {
+                    return otherMasks[i];
+                }
+            }
+            return 0;
+        }
+        inline static const int MAXLENGTH = 64;
 
-    int sourceLength = int(source.length());
-    int targetLength = int(target.length());
+    private:
+        inline static const int NUMASCII = 128;
+        quint64 ascii[NUMASCII] = {0};
+        char16_t otherChars[MAXLENGTH];
+        quint64 otherMasks[MAXLENGTH];
+        int numOther = 0;
+    };
 
-    if (source.isEmpty()) {
-        return targetLength;
+    // Myers' bit-parallel algorithm, in Hyyro's formulation for edit distance; pattern must be 1 to 64 code units
+    int bitParallelDistance(QStringView pattern, QStringView text, const int maxDistance)
+    {
+        const PositionMasks peq(pattern);
+        const qsizetype textLength = text.length();
+        const quint64 lastBit = quint64(1) << (pattern.length() - 1);
+        quint64 pv = ~quint64(0), mv = 0;
+        int score = int(pattern.length());
+        for(qsizetype j = 0; j < textLength; j++) {
+            const quint64 eq = peq[text[j]];
+            const quint64 xv = eq | mv;
+            const quint64 xh = (((eq & pv) + pv) ^ pv) | eq;
+            quint64 ph = mv | ~(xh | pv);
+            quint64 mh = pv & xh;
+            if(ph & lastBit) {
+                score++;
+            }
+            else if(mh & lastBit) {
+                score--;
+            }
+            // each remaining character of text can lower the score by at most 1
+            if(score - (textLength - j - 1) > maxDistance) {
+                return maxDistance + 1;
+            }
+            ph = (ph << 1) | 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+        }
+        return score;
     }
 
-    if (target.isEmpty()) {
-        return sourceLength;
+    // classic dynamic programming, for longer strings; source is the shorter
+    int dynamicProgrammingDistance(QStringView source, QStringView target, const int maxDistance)
+    {
+        const qsizetype targetLength = target.length();
+        QVarLengthArray<int, 256> prevCol(targetLength + 1), col(targetLength + 1);
+        for(qsizetype j = 0; j <= targetLength; j++) {
+            prevCol[j] = int(j);
+        }
+        for(qsizetype i = 0; i < source.length(); i++) {
+            col[0] = int(i + 1);
+            int colMin = col[0];
+            for(qsizetype j = 0; j < targetLength; j++) {
+                col[j + 1] = std::min({col[j] + 1, prevCol[j + 1] + 1, prevCol[j] + ((source[i] == target[j]) ? 0 : 1)});
+                colMin = std::min(colMin, col[j + 1]);
+            }
+            if(colMin > maxDistance) {
+                return maxDistance + 1;
+            }
+            std::swap(col, prevCol);
+        }
+        return prevCol[targetLength];
     }
+}
 
-    //handle case sensitive flag (or not)
-    QString s1(cs == Qt::CaseInsensitive ? source : source.toLower());
-    QString s2(cs == Qt::CaseInsensitive ? target : target.toLower());
-
-    const QChar *s1Char = s1.constData();
-    const QChar *s2Char = s2.constData();
 
-    //strip out any common prefix
-    int commonPrefixLen = 0;
-    while (sourceLength > 0 && targetLength > 0 && *s1Char == *s2Char) {
-      commonPrefixLen++;
-      sourceLength--;
-      targetLength--;
-      s1Char++;
-      s2Char++;
+int levenshtein::distance(const QString &source, const QString &target, const Qt::CaseSensitivity cs)
+{
+    const int noBound = int(std::max(source.length(), target.length()));
+    if(cs == Qt::CaseInsensitive) {
+        return boundedDistance(source.toCaseFolded(), target.toCaseFolded(), noBound);
     }
+    return boundedDistance(source, target, noBound);
+}
 
-    //strip out any common suffix
-    while ((sourceLength > 0) && (targetLength > 0) && (s1.at(commonPrefixLen + sourceLength - 1) == s2.at(commonPrefixLen + targetLength - 1))) {
-      sourceLength--;
-      targetLength--;
-    }
 
-    //fully checked either string? if so, the answer is easy...
-    if (sourceLength == 0) {
-      return targetLength;
+int levenshtein::boundedDistance(QStringView source, QStringView target, const int maxDistance)
+{
+    //strip out any common prefix and suffix
+    qsizetype commonPrefixLen = 0;
+    while((commonPrefixLen < source.length()) && (commonPrefixLen < target.length()) && (source[commonPrefixLen] == target[commonPrefixLen])) {
+        commonPrefixLen++;
     }
-    if (targetLength == 0) {
-      return sourceLength;
+    source = source.mid(commonPrefixLen);
+    target = target.mid(commonPrefixLen);
+    while(!source.isEmpty() && !target.isEmpty() && (source.back() == target.back())) {
+        source.chop(1);
+        target.chop(1);
     }
 
-    //ensure the inner loop is longer
-    if (sourceLength > targetLength) {
-      std::swap(s1, s2);
-      std::swap(sourceLength, targetLength);
+    //ensure source is the shorter
+    if(source.length() > target.length()) {
+        std::swap(source, target);
     }
 
-    //levenshtein algorithm begins here
-    std::vector<int> col(targetLength+1, 0);
-    std::vector<int> prevCol;
-    prevCol.reserve(targetLength + 1);
-    for (int i = 0; i < targetLength + 1; ++i) {
-      prevCol.push_back(i);
+    //the difference in length is a lower bound, and the answer if either string is fully checked
+    if(target.length() - source.length() > maxDistance) {
+        return maxDistance + 1;
     }
-    const QChar *s2start = s2Char;
-    for (int i = 0; i < sourceLength; ++i) {
-      col[0] = i + 1;
-      s2Char = s2start;
-      for (int j = 0; j < targetLength; ++j) {
-        col[j + 1] = std::min(std::min(1 + col[j], 1 + prevCol[1 + j]), prevCol[j] + ((*s1Char == *s2Char) ? 0 : 1));
-        s2Char++;
-      }
-      col.swap(prevCol);
-      s1Char++;
+    if(source.isEmpty()) {
+        return int(target.length());
+    }
+
+    if(source.length() <= PositionMasks::MAXLENGTH) {
+        return bitParallelDistance(source, target, maxDistance);
     }
-    return prevCol[targetLength];
+    return dynamicProgrammingDistance(source, target, maxDistance);
 }
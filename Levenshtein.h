@@ -2,9 +2,14 @@
 #define Levenshtein_H
 
 #include <QString>
+#include <QStringView>
 
 namespace levenshtein {
     int distance(const QString &source, const QString &target, Qt::CaseSensitivity cs = Qt::CaseSensitive);
+
+    // Distance between two strings that are already normalized (e.g., case folded), without allocating when the shorter one, less
+    // any prefix and suffix in common, is at most 64 code units. Stops early and returns maxDistance + 1 once the distance must exceed maxDistance.
+    int boundedDistance(QStringView source, QStringView target, int maxDistance);
 }
 
 #endif
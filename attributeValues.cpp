@@ -0,0 +1,91 @@
+#include "attributeValues.h"
+
+
+AttributeValues::~AttributeValues()
+{
+    clear();
+}
+
+
+AttributeValues::AttributeValues(const AttributeValues &other)
+{
+    if(other.numValues > INLINECAPACITY) {
+        capacity = other.numValues;
+        heapValues = new int[capacity];
+    }
+    std::copy(other.constBegin(), other.constEnd(), data());
+    numValues = other.numValues;
+}
+
+
+AttributeValues &AttributeValues::operator= (const AttributeValues &other)
+{
+    if(this != &other) {
+        AttributeValues copy(other);
+        clear();
+        takeFrom(copy);
+    }
+    return *this;
+}
+
+
+AttributeValues::AttributeValues(AttributeValues &&other) noexcept
+{
+    takeFrom(other);
+}
+
+
+AttributeValues &AttributeValues::operator= (AttributeValues &&other) noexcept
+{
+    if(this != &other) {
+        clear();
+        takeFrom(other);
+    }
+    return *this;
+}
+
+
+AttributeValues &AttributeValues::operator<< (int value)
+{
+    if(numValues == capacity) {
+        const int newCapacity = 2 * capacity;
+        int *newValues = new int[newCapacity];
+        std::copy(constBegin(), constEnd(), newValues);
+        if(capacity > INLINECAPACITY) {
+            delete[] heapValues;
+        }
+        heapValues = newValues;
+        capacity = newCapacity;
+    }
+    data()[numValues] = value;
+    numValues++;
+    return *this;
+}
+
+
+void AttributeValues::clear()
+{
+    if(capacity > INLINECAPACITY) {
+        delete[] heapValues;
+        capacity = INLINECAPACITY;
+    }
+    numValues = 0;
+}
+
+
+//////////////////
+// Take over the values of other, which is left empty; this must be empty and inline
+//////////////////
+void AttributeValues::takeFrom(AttributeValues &other)
+{
+    if(other.capacity > INLINECAPACITY) {
+        heapValues = other.heapValues;
+    }
+    else {
+        std::copy(other.inlineValues, other.inlineValues + INLINECAPACITY, inlineValues);
+    }
+    numValues = other.numValues;
+    capacity = other.capacity;
+    other.numValues = 0;
+    other.capacity = INLINECAPACITY;
+}
@@ -0,0 +1,45 @@
+#ifndef ATTRIBUTEVALUES_H
+#define ATTRIBUTEVALUES_H
+
+#include <algorithm>
+
+/**
+ * @brief The AttributeValues class holds the values of a student's response to one attribute question.
+ * There are almost always just one or two values, so up to two are stored inline, in the space that otherwise holds the pointer
+ * to values on the heap. At 16 bytes, with no heap allocation for up to two values, it is smaller than a QList<int> (24 bytes plus
+ * a heap allocation), which matters since every student has MAX_ATTRIBUTES of these, most of them often unused.
+ */
+class AttributeValues
+{
+public:
+    AttributeValues() = default;
+    ~AttributeValues();
+    AttributeValues(const AttributeValues &other);
+    AttributeValues &operator= (const AttributeValues &other);
+    AttributeValues(AttributeValues &&other) noexcept;
+    AttributeValues &operator= (AttributeValues &&other) noexcept;
+
+    AttributeValues &operator<< (int value);
+    void clear();
+
+    int size() const {return numValues;};
+    bool isEmpty() const {return numValues == 0;};
+    int first() const {return *data();};
+    bool contains(int value) const {return std::find(constBegin(), constEnd(), value) != constEnd();};
+    const int *constBegin() const {return data();};
+    const int *constEnd() const {return data() + numValues;};
+    const int *begin() const {return constBegin();};
+    const int *end() const {return constEnd();};
+
+private:
+    inline static const int INLINECAPACITY = 2;
+    const int *data() const {return (capacity > INLINECAPACITY)? heapValues : inlineValues;};
+    int *data() {return (capacity > INLINECAPACITY)? heapValues : inlineValues;};
+    void takeFrom(AttributeValues &other);
+
+    union {int inlineValues[INLINECAPACITY] = {}; int *heapValues;};
+    int numValues = 0;
+    int capacity = INLINECAPACITY;
+};
+
+#endif // ATTRIBUTEVALUES_H
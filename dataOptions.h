@@ -5,6 +5,7 @@
 #include <QFileInfo>
 #include <QJsonObject>
 #include <QStringList>
+#include <atomic>
 #include <map>
 #include <set>
 
@@ -65,6 +66,14 @@ public:
     QStringList dayNames;
     QStringList timeNames;
     QString saveStateFileName;
+
+    // identifies the contents of these options, for caching what is built from them; copies share it until one of them is marked as changed
+    quint64 version() const {return contentsVersion;};
+    void markChanged() {contentsVersion = nextContentsVersion++;};
+
+private:
+    quint64 contentsVersion = nextContentsVersion++;
+    inline static std::atomic<quint64> nextContentsVersion = 1;
 };
 
 #endif // DATAOPTIONS_H
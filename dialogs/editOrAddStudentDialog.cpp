@@ -543,23 +543,7 @@ void editOrAddStudentDialog::updateRecord(StudentRecord &student, const DataOpti
                 student.unavailable[day][time] = tempUnavailability[day][time];
             }
         }
-        student.availabilityChart = QObject::tr("Availability:");
-        student.availabilityChart += "<table style='padding: 0px 3px 0px 3px;'><tr><th></th>";
-        for(const auto &dayName : dataOptions->dayNames) {
-            student.availabilityChart += "<th>" + dayName.left(3) + "</th>";   // using first 3 characters in day name as abbreviation
-        }
-        student.availabilityChart += "</tr>";
-        for(int time = 0; time < dataOptions->timeNames.size(); time++) {
-            student.availabilityChart += "<tr><th>" + dataOptions->timeNames.at(time) + "</th>";
-            for(int day = 0; day < dataOptions->dayNames.size(); day++) {
-                student.availabilityChart += QString(student.unavailable[day][time]?
-                                                         "<td align = center> </td>" : "<td align = center bgcolor='PaleGreen'><b>√</b></td>");
-            }
-            student.availabilityChart += "</tr>";
-        }
-        student.availabilityChart += "</table>";
-
-        student.ambiguousSchedule = (student.availabilityChart.count("√") == 0 || student.availabilityChart.count("√") == (dataOptions->dayNames.size() * dataOptions->timeNames.size()));
+        student.refreshAmbiguousSchedule(int(dataOptions->dayNames.size()), int(dataOptions->timeNames.size()));
     }
     if(!dataOptions->prefTeammatesField.empty()) {
         student.prefTeammates = datamultiline[multilinefield++]->toPlainText();
@@ -4,12 +4,12 @@
 #include "LMS/canvashandler.h"
 #include "LMS/googlehandler.h"
 #include "gruepr_globals.h"
+#include "saveStateFile.h"
 #include "dialogs/baseTimeZoneDialog.h"
 #include <QCollator>
 #include <QComboBox>
 #include <QDir>
 #include <QJsonArray>
-#include <QJsonDocument>
 #include <QJsonObject>
 #include <QMessageBox>
 #include <QPainter>
@@ -512,8 +512,8 @@ bool GetGrueprDataDialog::getFromCanvas()
 
 bool GetGrueprDataDialog::getFromPrevWork()
 {
-    QFile savedFile(ui->prevWorkComboBox->currentData().toString(), this);
-    if(!savedFile.open(QIODeviceBase::ReadOnly | QIODeviceBase::Text)) {
+    SaveStateFile savedFile;
+    if(!savedFile.open(ui->prevWorkComboBox->currentData().toString())) {
         return false;
     }
 
@@ -525,13 +525,10 @@ bool GetGrueprDataDialog::getFromPrevWork()
     loadingProgressDialog->setMinimumDuration(0);
     loadingProgressDialog->setStyleSheet(QString(LABEL10PTSTYLE) + PROGRESSBARSTYLE);
 
-    const QJsonDocument doc = QJsonDocument::fromJson(savedFile.readAll());
-    savedFile.close();
+    const QJsonArray studentjsons = savedFile.section(SaveStateFile::Section::students).toArray();
 
     loadingProgressDialog->setValue(1);
 
-    QJsonObject content = doc.object();
-    const QJsonArray studentjsons = content["students"].toArray();
     students.reserve(studentjsons.size());
     int i = 2;
     loadingProgressDialog->setMaximum(studentjsons.size() + 3);
@@ -539,7 +536,8 @@ bool GetGrueprDataDialog::getFromPrevWork()
         students.emplaceBack(studentjson.toObject());
         loadingProgressDialog->setValue(i++);
     }
-    dataOptions = new DataOptions(content["dataoptions"].toObject());
+    dataOptions = new DataOptions(savedFile.section(SaveStateFile::Section::dataOptions).toObject());
+    savedFile.close();
     source = DataOptions::DataSource::fromPrevWork;
     dataOptions->dataSource = source;
 
@@ -979,18 +977,6 @@ bool GetGrueprDataDialog::readData()
         currStudent.parseRecordFromStringList(surveyFile->fieldValues, *dataOptions);
         currStudent.ID = students.size();
 
-        // see if this record is a duplicate; assume it isn't and then check
-        currStudent.duplicateRecord = false;
-        for(auto &student : students) {
-            if((((currStudent.firstname + currStudent.lastname).compare(student.firstname + student.lastname, Qt::CaseInsensitive) == 0) &&
-                 !(currStudent.firstname + currStudent.lastname).isEmpty()) ||
-                ((currStudent.email.compare(student.email, Qt::CaseInsensitive) == 0) &&
-                 !currStudent.email.isEmpty())) {
-                currStudent.duplicateRecord = true;
-                student.duplicateRecord = true;
-            }
-        }
-
         // Figure out what type of gender data was given (if any) -- initialized value is GenderType::adult, and we're checking each student
         // because some values are ambiguous to GenderType (e.g. "nonbinary")
         if(dataOptions->genderIncluded) {
@@ -1059,9 +1045,7 @@ bool GetGrueprDataDialog::readData()
                 currStudent.email = studentOnRoster.email;
                 currStudent.section = studentOnRoster.section;
                 for(auto &day : currStudent.unavailable) {
-                    for(auto &time : day) {
-                        time = false;
-                    }
+                    day.reset();
                 }
                 currStudent.ambiguousSchedule = true;
                 students << currStudent;
@@ -1207,7 +1191,7 @@ bool GetGrueprDataDialog::readData()
             // set numerical value of each student's response and record in dataOptions a tally for each response
             for(auto &student : students) {
                 const QString &currentStudentResponse = student.attributeResponse[attribute];
-                QList<int> &currentStudentAttributeVals = student.attributeVals[attribute];
+                AttributeValues &currentStudentAttributeVals = student.attributeVals[attribute];
                 if(!student.attributeResponse[attribute].isEmpty()) {
                     if(attributeType == DataOptions::AttributeType::ordered) {
                         // for numerical/ordered, set numerical value of students' attribute responses according to the number at the start of the response
@@ -1287,9 +1271,9 @@ bool GetGrueprDataDialog::readData()
 
     loadingProgressDialog->setValue(surveyFile->estimatedNumberRows + 3 + MAX_ATTRIBUTES);
 
-    // set all of the students' tooltips
+    // students' tooltips are created when first displayed, so make sure nothing stale is cached
     for(auto &student : students) {
-        student.createTooltip(*dataOptions);
+        student.invalidateTooltip();
     }
     loadingProgressDialog->setValue(surveyFile->estimatedNumberRows + 4 + MAX_ATTRIBUTES);
     surveyFile->close((source == DataOptions::DataSource::fromGoogle) || (source == DataOptions::DataSource::fromCanvas));
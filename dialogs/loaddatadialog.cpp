@@ -3,15 +3,18 @@
 #include "LMS/googlehandler.h"
 #include "dialogs/baseTimeZoneDialog.h"
 #include "dialogs/categorizingdialog.h"
+#include "saveStateFile.h"
 #include "qcollator.h"
 #include "qcombobox.h"
 #include "qdir.h"
+#include "qeventloop.h"
+#include "qfuturewatcher.h"
 #include "qjsonarray.h"
-#include "qjsondocument.h"
 #include "qsettings.h"
 #include "qstandardpaths.h"
 #include "qtimer.h"
 #include "widgets/dropcsvframe.h"
+#include <QtConcurrentRun>
 
 loadDataDialog::loadDataDialog(StartDialog *parent) : QDialog(parent), parent(parent){
     setWindowTitle(tr("gruepr - Form teams"));
@@ -677,8 +680,8 @@ bool loadDataDialog::getFromCanvas()
 
 bool loadDataDialog::getFromPrevWork()
 {
-    QFile savedFile(prevWorkComboBox->currentData().toString(), this);
-    if(!savedFile.open(QIODeviceBase::ReadOnly | QIODeviceBase::Text)) {
+    SaveStateFile savedFile;
+    if(!savedFile.open(prevWorkComboBox->currentData().toString())) {
         return false;
     }
 
@@ -690,13 +693,10 @@ bool loadDataDialog::getFromPrevWork()
     loadingProgressDialog->setMinimumDuration(0);
     loadingProgressDialog->setStyleSheet(QString(LABEL10PTSTYLE) + PROGRESSBARSTYLE);
 
-    const QJsonDocument doc = QJsonDocument::fromJson(savedFile.readAll());
-    savedFile.close();
+    const QJsonArray studentjsons = savedFile.section(SaveStateFile::Section::students).toArray();
 
     loadingProgressDialog->setValue(1);
 
-    QJsonObject content = doc.object();
-    const QJsonArray studentjsons = content["students"].toArray();
     students.reserve(studentjsons.size());
     int i = 2;
     loadingProgressDialog->setMaximum(studentjsons.size() + 3);
@@ -704,7 +704,8 @@ bool loadDataDialog::getFromPrevWork()
         students.emplaceBack(studentjson.toObject());
         loadingProgressDialog->setValue(i++);
     }
-    dataOptions = new DataOptions(content["dataoptions"].toObject());
+    dataOptions = new DataOptions(savedFile.section(SaveStateFile::Section::dataOptions).toObject());
+    savedFile.close();
     source = DataOptions::DataSource::fromPrevWork;
     dataOptions->dataSource = source;
 
@@ -744,6 +745,55 @@ void loadDataDialog::accept() {
     QDialog::accept();
 }
 
+//////////////////
+// Background worker for readData(): parse each remaining row of the survey file into a student record, reporting them in batches
+//////////////////
+void loadDataDialog::parseStudentRecords(QPromise<QList<StudentRecord>> &promise, CsvFile *const surveyFile, DataOptions *const dataOptions)
+{
+    QList<StudentRecord> batch;
+    batch.reserve(PARSINGBATCHSIZE);
+    int numStudents = 0;
+    StudentRecord currStudent;
+    do {
+        if(promise.isCanceled()) {
+            return;
+        }
+
+        currStudent.clear();
+        currStudent.parseRecordFromStringList(surveyFile->fieldValues, *dataOptions);
+
+        // Figure out what type of gender data was given (if any) -- initialized value is GenderType::adult, and we're checking each student
+        // because some values are ambiguous to GenderType (e.g. "nonbinary")
+        if(dataOptions->genderIncluded) {
+            const QString genderText = surveyFile->fieldValues.at(dataOptions->genderField);
+            if(genderText.contains(tr("male"), Qt::CaseInsensitive)) {  // contains "male" also picks up "female"
+                dataOptions->genderType = GenderType::biol;
+            }
+            else if(genderText.contains(tr("man"), Qt::CaseInsensitive)) {  // contains "man" also picks up "woman"
+                dataOptions->genderType = GenderType::adult;
+            }
+            else if((genderText.contains(tr("girl"), Qt::CaseInsensitive)) || (genderText.contains("boy", Qt::CaseInsensitive))) {
+                dataOptions->genderType = GenderType::child;
+            }
+            else if(genderText.contains(tr("he"), Qt::CaseInsensitive)) {  // contains "he" also picks up "she" and "they"
+                dataOptions->genderType = GenderType::pronoun;
+            }
+        }
+
+        numStudents++;
+        batch << currStudent;
+        if(batch.size() == PARSINGBATCHSIZE) {
+            promise.addResult(batch);
+            batch.clear();
+        }
+    } while(surveyFile->readDataRow() && numStudents < MAX_STUDENTS);
+
+    if(!batch.isEmpty()) {
+        promise.addResult(batch);
+    }
+}
+
+
 bool loadDataDialog::readData()
 {
     auto *loadingProgressDialog = new QProgressDialog(tr("Loading data..."), tr("Cancel"), 0, surveyFile->estimatedNumberRows + MAX_ATTRIBUTES + 6,
@@ -924,53 +974,38 @@ bool loadDataDialog::readData()
         surveyFile->readDataRow();
     }
 
+    // Parse the student records on a background thread, which streams back batches of records as they are read.
+    // While parsing, only the worker touches surveyFile and dataOptions; the records are numbered here as each batch arrives
+    // (duplicates are found by the main window once the students are loaded)
     students.reserve(surveyFile->estimatedNumberRows);
-    int numStudents = 0;
-    StudentRecord currStudent;
-    do {
-        if(loadingProgressDialog->wasCanceled()) {
-            surveyFile->close((source == DataOptions::DataSource::fromGoogle) || (source == DataOptions::DataSource::fromCanvas));
-            return false;
-        }
-
-        currStudent.clear();
-        currStudent.parseRecordFromStringList(surveyFile->fieldValues, *dataOptions);
-        currStudent.ID = students.size();
-
-        // see if this record is a duplicate; assume it isn't and then check
-        currStudent.duplicateRecord = false;
-        for(auto &student : students) {
-            if((((currStudent.firstname + currStudent.lastname).compare(student.firstname + student.lastname, Qt::CaseInsensitive) == 0) &&
-                 !(currStudent.firstname + currStudent.lastname).isEmpty()) ||
-                ((currStudent.email.compare(student.email, Qt::CaseInsensitive) == 0) &&
-                 !currStudent.email.isEmpty())) {
-                currStudent.duplicateRecord = true;
-                student.duplicateRecord = true;
-            }
-        }
-
-        // Figure out what type of gender data was given (if any) -- initialized value is GenderType::adult, and we're checking each student
-        // because some values are ambiguous to GenderType (e.g. "nonbinary")
-        if(dataOptions->genderIncluded) {
-            const QString genderText = surveyFile->fieldValues.at(dataOptions->genderField);
-            if(genderText.contains(tr("male"), Qt::CaseInsensitive)) {  // contains "male" also picks up "female"
-                dataOptions->genderType = GenderType::biol;
-            }
-            else if(genderText.contains(tr("man"), Qt::CaseInsensitive)) {  // contains "man" also picks up "woman"
-                dataOptions->genderType = GenderType::adult;
-            }
-            else if((genderText.contains(tr("girl"), Qt::CaseInsensitive)) || (genderText.contains("boy", Qt::CaseInsensitive))) {
-                dataOptions->genderType = GenderType::child;
-            }
-            else if(genderText.contains(tr("he"), Qt::CaseInsensitive)) {  // contains "he" also picks up "she" and "they"
-                dataOptions->genderType = GenderType::pronoun;
+    QFutureWatcher<QList<StudentRecord>> parsingWatcher;
+    connect(&parsingWatcher, &QFutureWatcher<QList<StudentRecord>>::resultsReadyAt, this, [this, &parsingWatcher, loadingProgressDialog](int beginIndex, int endIndex) {
+        for(int batch = beginIndex; batch < endIndex; batch++) {
+            const QList<StudentRecord> parsedStudents = parsingWatcher.resultAt(batch);
+            for(auto currStudent : parsedStudents) {
+                currStudent.ID = students.size();
+                students << currStudent;
             }
         }
+        loadingProgressDialog->setLabelText(tr("Loading data...") + "\n" + QString::number(students.size()) + tr(" students read"));
+        loadingProgressDialog->setValue(2 + int(students.size()));
+    });
+    connect(loadingProgressDialog, &QProgressDialog::canceled, &parsingWatcher, &QFutureWatcher<QList<StudentRecord>>::cancel);
+    QEventLoop parsingLoop;
+    connect(&parsingWatcher, &QFutureWatcher<QList<StudentRecord>>::finished, &parsingLoop, &QEventLoop::quit);
+    parsingWatcher.setFuture(QtConcurrent::run(&loadDataDialog::parseStudentRecords, surveyFile, dataOptions));
+    parsingLoop.exec();
+
+    if(parsingWatcher.isCanceled()) {
+        // release the partially loaded data right away
+        students.clear();
+        students.squeeze();
+        surveyFile->close((source == DataOptions::DataSource::fromGoogle) || (source == DataOptions::DataSource::fromCanvas));
+        return false;
+    }
 
-        numStudents++;
-        students << currStudent;
-        loadingProgressDialog->setValue(2 + numStudents);
-    } while(surveyFile->readDataRow() && numStudents < MAX_STUDENTS);
+    int numStudents = int(students.size());
+    StudentRecord currStudent;
 
     if(numStudents < MIN_STUDENTS) {
         grueprGlobal::errorMessage(this, tr("Insufficient number of students."),
@@ -1017,9 +1052,7 @@ bool loadDataDialog::readData()
                 currStudent.email = studentOnRoster.email;
                 currStudent.section = studentOnRoster.section;
                 for(auto &day : currStudent.unavailable) {
-                    for(auto &time : day) {
-                        time = false;
-                    }
+                    day.reset();
                 }
                 currStudent.ambiguousSchedule = true;
                 students << currStudent;
@@ -1165,7 +1198,7 @@ bool loadDataDialog::readData()
             // set numerical value of each student's response and record in dataOptions a tally for each response
             for(auto &student : students) {
                 const QString &currentStudentResponse = student.attributeResponse[attribute];
-                QList<int> &currentStudentAttributeVals = student.attributeVals[attribute];
+                AttributeValues &currentStudentAttributeVals = student.attributeVals[attribute];
                 if(!student.attributeResponse[attribute].isEmpty()) {
                     if(attributeType == DataOptions::AttributeType::ordered) {
                         // for numerical/ordered, set numerical value of students' attribute responses according to the number at the start of the response
@@ -1245,9 +1278,9 @@ bool loadDataDialog::readData()
 
     loadingProgressDialog->setValue(surveyFile->estimatedNumberRows + 3 + MAX_ATTRIBUTES);
 
-    // set all of the students' tooltips
+    // students' tooltips are created when first displayed, so make sure nothing stale is cached
     for(auto &student : students) {
-        student.createTooltip(*dataOptions);
+        student.invalidateTooltip();
     }
     loadingProgressDialog->setValue(surveyFile->estimatedNumberRows + 4 + MAX_ATTRIBUTES);
     surveyFile->close((source == DataOptions::DataSource::fromGoogle) || (source == DataOptions::DataSource::fromCanvas));
@@ -6,6 +6,7 @@
 #include "dialogs/startDialog.h"
 #include "qcombobox.h"
 #include "qdialog.h"
+#include "qpromise.h"
 #include "studentRecord.h"
 
 class loadDataDialog : public QDialog
@@ -30,6 +31,7 @@ private:
     bool getFromPrevWork();
     bool getFromDropFile(QString filePathString);
     bool readData();
+    static void parseStudentRecords(QPromise<QList<StudentRecord>> &promise, CsvFile *const surveyFile, DataOptions *const dataOptions);
     bool readQuestionsFromHeader();
     DataOptions::DataSource source = DataOptions::DataSource::fromUploadFile;
     QDialogButtonBox* confirmCancelButtonBox;
@@ -45,6 +47,7 @@ private:
     inline static const int BASEWINDOWHEIGHT = 456;
     inline static const int BASICICONSIZE = 30;
     inline static const int SMALLERICONSIZE = 20;
+    inline static const int PARSINGBATCHSIZE = 25;      // number of student records parsed in the background before handing them to the UI
 
 };
 
@@ -9,7 +9,7 @@
 // A dialog to show progress in optimization
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-progressDialog::progressDialog(const QString &currSection, QChartView *chart, QWidget *parent)
+progressDialog::progressDialog(const QString &currSection, QWidget *chart, QWidget *parent)
     :QDialog (parent)
 {
     //Set up window
@@ -76,9 +76,13 @@ progressDialog::progressDialog(const QString &currSection, QChartView *chart, QW
     adjustSize();
 }
 
-void progressDialog::setText(const QString &text, int generation, float score, bool autostopInProgress)
+void progressDialog::setText(const QString &text, int generation, float score, bool autostopInProgress, float generationsPerSecond)
 {
-    explanationText->setText(tr("Generation ") + QString::number(generation) + " - " + tr("Top Score = ") + QString::number(score));
+    QString explanation = tr("Generation ") + QString::number(generation) + " - " + tr("Top Score = ") + QString::number(score);
+    if(generationsPerSecond > 0) {
+        explanation += " (" + QString::number(generationsPerSecond, 'f', 0) + tr(" generations/sec") + ")";
+    }
+    explanationText->setText(explanation);
     QString action = text;
     if(autostopInProgress && !onlyStopManually->isChecked()) {
         action += tr("\nOptimization will end in ") + QString::number(secsLeftToClose) + tr(" seconds.");
@@ -130,7 +134,7 @@ void progressDialog::reject()
     QDialog::reject();
 }
 
-void progressDialog::statsButtonPushed(QChartView *chart)
+void progressDialog::statsButtonPushed(QWidget *chart)
 {
     graphShown = !graphShown;
 
@@ -2,7 +2,6 @@
 #define PROGRESSDIALOG_H
 
 #include <QDialog>
-#include <QChartView>
 #include <QCheckBox>
 #include <QLabel>
 #include <QProgressBar>
@@ -13,18 +12,18 @@ class progressDialog : public QDialog
     Q_OBJECT
 
 public:
-    explicit progressDialog(const QString &currSection = "", QChartView *chart = nullptr, QWidget *parent = nullptr);
+    explicit progressDialog(const QString &currSection = "", QWidget *chart = nullptr, QWidget *parent = nullptr);
     ~progressDialog() override;
     progressDialog(const progressDialog&) = delete;
     progressDialog operator= (const progressDialog&) = delete;
     progressDialog(progressDialog&&) = delete;
     progressDialog& operator= (progressDialog&&) = delete;
 
-    void setText(const QString &text = "", int generation = 0, float score = 0, bool autostopInProgress = false);
+    void setText(const QString &text = "", int generation = 0, float score = 0, bool autostopInProgress = false, float generationsPerSecond = 0);
     void highlightStopButton();
 
 private slots:
-    void statsButtonPushed(QChartView *chart);
+    void statsButtonPushed(QWidget *chart);
     void updateCountdown();
     void reject() override;
 
@@ -0,0 +1,107 @@
+#include "rosterReconciliationDialog.h"
+#include "gruepr_globals.h"
+#include <QHeaderView>
+#include <QLabel>
+#include <QtConcurrentMap>
+#include <numeric>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// A dialog to resolve, all at once, the names on a roster that were not found in the survey
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+RosterReconciliationDialog::RosterReconciliationDialog(const StudentList &students, const StudentNameIndex &nameIndex, const QList<RosterEntry> &unmatchedRosterEntries,
+                                                       QWidget *parent)
+    :listTableDialog (tr("Roster names not found in the survey"), false, false, parent), students(students)
+{
+    setMinimumSize(LG_DLG_SIZE, SM_DLG_SIZE);
+
+    const int numEntries = int(unmatchedRosterEntries.size());
+    resolutions.resize(numEntries);
+
+    // find the closest survey names to each roster name (a student with the same email address first), all roster names in parallel
+    QList<int> rows(numEntries);
+    std::iota(rows.begin(), rows.end(), 0);
+    const auto findCandidates = [&unmatchedRosterEntries, &nameIndex](const int row) {
+        return nameIndex.closestNames(unmatchedRosterEntries.at(row).name, MAX_CANDIDATES, unmatchedRosterEntries.at(row).email);
+    };
+    const QList<QList<StudentNameIndex::Match>> candidates = QtConcurrent::blockingMapped<QList<QList<StudentNameIndex::Match>>>(rows, findCandidates);
+
+    auto *explanation = new QLabel(this);
+    explanation->setStyleSheet(LABEL10PTSTYLE);
+    explanation->setWordWrap(true);
+    explanation->setText(tr("These students on the roster could not be found in the survey. "
+                            "For each one, select a closely matching name in the survey to merge with, add them as a new student, or ignore them."));
+    theGrid->addWidget(explanation, 1, 1, 1, 1);
+
+    //Table of roster names, each with a selector of the closest survey names
+    theTable->setColumnCount(4);
+    theTable->setHorizontalHeaderLabels({tr("Roster"), tr("Survey"), tr("Name"), tr("Email address")});
+    theTable->setRowCount(numEntries);
+    matchSelectors.reserve(numEntries);
+    useRosterNameCheckboxes.reserve(numEntries);
+    useRosterEmailCheckboxes.reserve(numEntries);
+    rosterEmails.reserve(numEntries);
+    for(int row = 0; row < numEntries; row++) {
+        const RosterEntry &entry = unmatchedRosterEntries.at(row);
+        rosterEmails << entry.email;
+
+        auto *rosterLabel = new QLabel("<b>" + entry.name + "</b>" + (entry.email.isEmpty()? "" : "<br>" + entry.email), this);
+        rosterLabel->setStyleSheet(LABEL10PTSTYLE);
+        theTable->setCellWidget(row, 0, rosterLabel);
+
+        auto *matchSelector = new QComboBox(this);
+        matchSelector->setStyleSheet(COMBOBOXSTYLE);
+        matchSelector->addItem(tr("Ignore this student"), IGNORE);
+        matchSelector->addItem(tr("Add as a new student"), ADDSTUDENT);
+        matchSelector->insertSeparator(2);
+        for(const auto &candidate : candidates.at(row)) {
+            const StudentRecord *const student = students.findByID(candidate.ID);
+            matchSelector->addItem(tr("Merge with ") + student->firstname + " " + student->lastname +
+                                       (student->email.isEmpty()? "" : " (" + student->email + ")"), student->ID);
+        }
+        if(nameIndex.findEmail(entry.email) != -1) {
+            matchSelector->setCurrentIndex(3);
+        }
+        matchSelectors << matchSelector;
+        theTable->setCellWidget(row, 1, matchSelector);
+
+        useRosterNameCheckboxes << new QCheckBox(tr("Use roster name"), this);
+        useRosterNameCheckboxes.last()->setStyleSheet(CHECKBOXSTYLE);
+        theTable->setCellWidget(row, 2, useRosterNameCheckboxes.last());
+        useRosterEmailCheckboxes << new QCheckBox(tr("Use roster email address"), this);
+        useRosterEmailCheckboxes.last()->setStyleSheet(CHECKBOXSTYLE);
+        theTable->setCellWidget(row, 3, useRosterEmailCheckboxes.last());
+
+        connect(matchSelector, &QComboBox::currentIndexChanged, this, [this, row]{updateResolution(row);});
+        connect(useRosterNameCheckboxes.last(), &QCheckBox::clicked, this, [this, row]{updateResolution(row);});
+        connect(useRosterEmailCheckboxes.last(), &QCheckBox::clicked, this, [this, row]{updateResolution(row);});
+        updateResolution(row);
+    }
+    theTable->resizeColumnsToContents();
+    theTable->adjustSize();
+
+    adjustSize();
+}
+
+
+void RosterReconciliationDialog::updateResolution(int row)
+{
+    Resolution &resolution = resolutions[row];
+    const long long selection = matchSelectors.at(row)->currentData().toLongLong();
+    const StudentRecord *const student = ((selection >= 0)? students.findByID(selection) : nullptr);
+    if(student != nullptr) {
+        resolution.action = Action::mergeWithStudent;
+        resolution.studentID = selection;
+    }
+    else {
+        resolution.action = ((selection == ADDSTUDENT)? Action::addStudent : Action::ignore);
+        resolution.studentID = -1;
+    }
+
+    // the roster name and email address can only be chosen over the survey's when merging, and only if they differ
+    const bool emailsDiffer = (student != nullptr) && !rosterEmails.at(row).isEmpty() && (student->email.compare(rosterEmails.at(row), Qt::CaseInsensitive) != 0);
+    useRosterNameCheckboxes.at(row)->setEnabled(student != nullptr);
+    useRosterEmailCheckboxes.at(row)->setEnabled(emailsDiffer);
+    resolution.useRosterName = (student != nullptr) && useRosterNameCheckboxes.at(row)->isChecked();
+    resolution.useRosterEmail = emailsDiffer && useRosterEmailCheckboxes.at(row)->isChecked();
+}
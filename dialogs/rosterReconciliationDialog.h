@@ -0,0 +1,42 @@
+#ifndef ROSTERRECONCILIATIONDIALOG_H
+#define ROSTERRECONCILIATIONDIALOG_H
+
+#include "listTableDialog.h"
+#include "studentNameIndex.h"
+#include "studentRecord.h"
+#include <QCheckBox>
+#include <QComboBox>
+
+class RosterReconciliationDialog : public listTableDialog
+{
+    Q_OBJECT
+
+public:
+    struct RosterEntry {QString name; QString email;};
+    enum class Action {ignore, addStudent, mergeWithStudent};
+    struct Resolution {Action action = Action::ignore; long long studentID = -1; bool useRosterName = false; bool useRosterEmail = false;};
+
+    RosterReconciliationDialog(const StudentList &students, const StudentNameIndex &nameIndex, const QList<RosterEntry> &unmatchedRosterEntries,
+                               QWidget *parent = nullptr);
+    ~RosterReconciliationDialog() override = default;
+    RosterReconciliationDialog(const RosterReconciliationDialog&) = delete;
+    RosterReconciliationDialog operator= (const RosterReconciliationDialog&) = delete;
+    RosterReconciliationDialog(RosterReconciliationDialog&&) = delete;
+    RosterReconciliationDialog& operator= (RosterReconciliationDialog&&) = delete;
+
+    QList<Resolution> resolutions;          // one for each unmatched roster entry, in the same order
+
+private:
+    void updateResolution(int row);
+    QList<QComboBox *> matchSelectors;
+    QList<QCheckBox *> useRosterNameCheckboxes;
+    QList<QCheckBox *> useRosterEmailCheckboxes;
+    QList<QString> rosterEmails;
+    const StudentList &students;
+
+    inline static const int MAX_CANDIDATES = 10;        // number of closest survey names offered for each roster name
+    inline static const int IGNORE = -1;                // data values for the non-student options in the selectors
+    inline static const int ADDSTUDENT = -2;
+};
+
+#endif // ROSTERRECONCILIATIONDIALOG_H
@@ -0,0 +1,67 @@
+#include "teammateNamesReconciliationDialog.h"
+#include "gruepr_globals.h"
+#include <QLabel>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+// A dialog to resolve, all at once, the names of teammates that could not be matched confidently to a student
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TeammateNamesReconciliationDialog::TeammateNamesReconciliationDialog(const StudentList &students, const QList<UnresolvedName> &unresolvedNames,
+                                                                     const int numNamesMatchedAutomatically, QWidget *parent)
+    :listTableDialog (tr("Teammate names not found"), false, true, parent)
+{
+    setMinimumSize(LG_DLG_SIZE, SM_DLG_SIZE);
+
+    const int numNames = int(unresolvedNames.size());
+    resolvedIDs.fill(IGNORE, numNames);
+
+    auto *explanation = new QLabel(this);
+    explanation->setStyleSheet(LABEL10PTSTYLE);
+    explanation->setWordWrap(true);
+    QString explanationText;
+    if(numNamesMatchedAutomatically > 0) {
+        explanationText = QString::number(numNamesMatchedAutomatically) + tr(" name(s) that did not exactly match a student were matched automatically to a clearly closest student. ");
+    }
+    explanationText += tr("These names could not be matched with confidence. For each one, select the student it refers to, or ignore it.");
+    explanation->setText(explanationText);
+    theGrid->addWidget(explanation, 1, 1, 1, 1);
+
+    //Table of names, each with a selector of the closest student names
+    theTable->setColumnCount(2);
+    theTable->setHorizontalHeaderLabels({tr("Name given"), tr("Student")});
+    theTable->setRowCount(numNames);
+    matchSelectors.reserve(numNames);
+    for(int row = 0; row < numNames; row++) {
+        const UnresolvedName &unresolvedName = unresolvedNames.at(row);
+
+        QString nameText = "<b>" + unresolvedName.name + "</b>";
+        if(!unresolvedName.namesOfStudentsWhoAsked.isEmpty()) {
+            nameText += "<br>" + tr("from ") + unresolvedName.namesOfStudentsWhoAsked.join(", ");
+        }
+        auto *nameLabel = new QLabel(nameText, this);
+        nameLabel->setStyleSheet(LABEL10PTSTYLE);
+        theTable->setCellWidget(row, 0, nameLabel);
+
+        // closest student is selected by default
+        auto *matchSelector = new QComboBox(this);
+        matchSelector->setStyleSheet(COMBOBOXSTYLE);
+        matchSelector->addItem(tr("Ignore this name"), IGNORE);
+        matchSelector->insertSeparator(1);
+        for(const auto &candidate : unresolvedName.candidates) {
+            const StudentRecord *const student = students.findByID(candidate.ID);
+            matchSelector->addItem(student->firstname + " " + student->lastname + (student->email.isEmpty()? "" : " (" + student->email + ")"), student->ID);
+        }
+        if(!unresolvedName.candidates.isEmpty()) {
+            matchSelector->setCurrentIndex(2);
+            resolvedIDs[row] = unresolvedName.candidates.constFirst().ID;
+        }
+        matchSelectors << matchSelector;
+        theTable->setCellWidget(row, 1, matchSelector);
+
+        connect(matchSelector, &QComboBox::currentIndexChanged, this, [this, row]{resolvedIDs[row] = matchSelectors.at(row)->currentData().toLongLong();});
+    }
+    theTable->resizeColumnsToContents();
+    theTable->adjustSize();
+
+    adjustSize();
+}
@@ -0,0 +1,32 @@
+#ifndef TEAMMATENAMESRECONCILIATIONDIALOG_H
+#define TEAMMATENAMESRECONCILIATIONDIALOG_H
+
+#include "listTableDialog.h"
+#include "studentNameIndex.h"
+#include "studentRecord.h"
+#include <QComboBox>
+
+class TeammateNamesReconciliationDialog : public listTableDialog
+{
+    Q_OBJECT
+
+public:
+    struct UnresolvedName {QString name; QStringList namesOfStudentsWhoAsked; QList<StudentNameIndex::Match> candidates;};
+
+    TeammateNamesReconciliationDialog(const StudentList &students, const QList<UnresolvedName> &unresolvedNames, const int numNamesMatchedAutomatically,
+                                      QWidget *parent = nullptr);
+    ~TeammateNamesReconciliationDialog() override = default;
+    TeammateNamesReconciliationDialog(const TeammateNamesReconciliationDialog&) = delete;
+    TeammateNamesReconciliationDialog operator= (const TeammateNamesReconciliationDialog&) = delete;
+    TeammateNamesReconciliationDialog(TeammateNamesReconciliationDialog&&) = delete;
+    TeammateNamesReconciliationDialog& operator= (TeammateNamesReconciliationDialog&&) = delete;
+
+    QList<long long> resolvedIDs;           // one for each unresolved name, in the same order; -1 if the name is to be ignored
+
+private:
+    QList<QComboBox *> matchSelectors;
+
+    inline static const int IGNORE = -1;                // data value for the non-student option in the selectors
+};
+
+#endif // TEAMMATENAMESRECONCILIATIONDIALOG_H
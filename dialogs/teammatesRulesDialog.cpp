@@ -8,17 +8,20 @@
 #include "ui_teammatesRulesDialog.h"
 #include "csvfile.h"
 #include "gruepr_globals.h"
-#include "dialogs/findMatchingNameDialog.h"
+#include "dialogs/teammateNamesReconciliationDialog.h"
 #include "studentRecord.h"
 #include <QMenu>
 #include <QMessageBox>
+#include <QtConcurrentMap>
+#include <numeric>
 
-TeammatesRulesDialog::TeammatesRulesDialog(const QList<StudentRecord> &incomingStudents, const DataOptions &dataOptions, const TeamingOptions &teamingOptions,
-                                           const QString &sectionname, const QStringList &currTeamSets, QWidget *parent,
+TeammatesRulesDialog::TeammatesRulesDialog(const QList<StudentRecord> &incomingStudents, std::shared_ptr<const StudentNameIndex> incomingNameIndex,
+                                           const DataOptions &dataOptions, const TeamingOptions &teamingOptions, const QString &sectionname, const QStringList &currTeamSets, QWidget *parent,
                                            bool autoLoadRequired, bool autoLoadPrevented, bool autoLoadRequested, int initialTabIndex) :
     QDialog(parent),
     ui(new Ui::TeammatesRulesDialog),
-    numStudents(incomingStudents.size())
+    numStudents(incomingStudents.size()),
+    nameIndex(std::move(incomingNameIndex))
 {
     ui->setupUi(this);
     setWindowFlags(Qt::Dialog | Qt::WindowTitleHint | Qt::WindowCloseButtonHint);
@@ -31,7 +34,7 @@ TeammatesRulesDialog::TeammatesRulesDialog(const QList<StudentRecord> &incomingS
     //copy data into local versions, including full database of students
     sectionName = sectionname;
     teamSets = currTeamSets;
-    students = incomingStudents;
+    students = StudentList(incomingStudents);
     positiverequestsInSurvey = !dataOptions.prefTeammatesField.empty();
     negativerequestsInSurvey = !dataOptions.prefTeammatesField.empty();
     std::sort(students.begin(), students.end(), [](const StudentRecord &i, const StudentRecord &j)
@@ -160,7 +163,7 @@ TeammatesRulesDialog::TeammatesRulesDialog(const QList<StudentRecord> &incomingS
     for(auto &studentcombobox : studentcomboboxes) {
         studentcombobox->setStyleSheet(COMBOBOXSTYLE);
         for(const auto &student : qAsConst(students)) {
-            if(((sectionName == "") || (sectionName == student.section)) && !student.deleted) {
+            if(((sectionName == "") || (sectionName == student.section.toString())) && !student.deleted) {
                 studentcombobox->addItem(student.lastname + ", " + student.firstname, student.ID);
             }
         }
@@ -394,33 +397,41 @@ void TeammatesRulesDialog::refreshDisplay(TypeOfTeammates typeOfTeammates, int v
     *teammatesSpecified = false;     // assume no teammates specified until we find one
     //include a tool tip when pressed or etc that student they can add only when they have added prev student or include instructions in the beginning, which they can press X and hide)
     // the tradeoff is that they know they can add fields and etc, less decluttered
+    // students are already in order by last name then first name; keep those in the current section being grouped
     QList<StudentRecord *> baseStudents;
-    QList<StudentRecord *> filteredStudents;
-    QList<long long> allIDs;
-
     for(auto &student : students) {
-        //only add students which are in the current section being grouped
-        if(((sectionName == "") || (sectionName == student.section)) && !student.deleted) {
-            allIDs << student.ID;
-            QString fullName = student.firstname + " " + student.lastname;
-            qDebug() << searchBarText;
-            if (fullName.contains(searchBarText, Qt::CaseInsensitive)) { // Case-insensitive match
-                filteredStudents << (&student);
-            }
+        if(((sectionName == "") || (sectionName == student.section.toString())) && !student.deleted) {
             baseStudents << &student;
         }
     }
 
-    std::sort(filteredStudents.begin(), filteredStudents.end(), [](const StudentRecord *const A, const StudentRecord *const B)
-              {return ((A->lastname+A->firstname) < (B->lastname+B->firstname));});
+    // Set up one model of all student names for the completers, and a map from name to student
+    QMap<QString, StudentRecord*> studentNameToIdMap;
+    QStringList studentNames;
+    studentNames.reserve(baseStudents.size());
+    for(auto *student : qAsConst(baseStudents)) {
+        QString fullName = student->firstname + " " + student->lastname;
+        studentNames.append(fullName);
+        studentNameToIdMap[fullName] = student;  // Store name → ID mapping
+    }
+    auto *studentNamesModel = new QStringListModel(studentNames, this);
+
+    // the lowercase names used to filter the rows as the search bar text changes
+    SearchIndex &searchIndex = searchIndexes[static_cast<int>(typeOfTeammates)];
+    searchIndex.lowercaseNames.clear();
+    searchIndex.lowercaseNames.reserve(baseStudents.size());
+    searchIndex.matchingRows.clear();
+    searchIndex.matchingRows.reserve(baseStudents.size());
 
     int row = 0;
-    for(auto *filteredStudent : qAsConst(filteredStudents)) {
+    for(auto *filteredStudent : qAsConst(baseStudents)) {
         bool atLeastOneTeammate = false;
         column = 0;
 
         table->setRowCount(row+1);
         table->setVerticalHeaderItem(row, new QTableWidgetItem(filteredStudent->firstname + "  " + filteredStudent->lastname)); // using two spaces so that can split later
+        searchIndex.lowercaseNames << (filteredStudent->firstname + " " + filteredStudent->lastname).toLower();
+        searchIndex.matchingRows << row;
 
         if(requestsInSurvey) {
             auto *stuPrefText = new QLabel(this);
@@ -435,87 +446,77 @@ void TeammatesRulesDialog::refreshDisplay(TypeOfTeammates typeOfTeammates, int v
             column++;
         }
 
-        bool printStudent;
-        for(const auto studentBID : qAsConst(allIDs)) {
+        // find the students who are X (prevented/required/requested) teammates of baseStudent, in the same order as the rows
+        const QSet<long long> &teammateIDs = ((typeOfTeammates == TypeOfTeammates::required)? filteredStudent->requiredWith :
+                                             ((typeOfTeammates == TypeOfTeammates::prevented)? filteredStudent->preventedWith : filteredStudent->requestedWith));
+        QList<StudentRecord *> teammates;
+        teammates.reserve(teammateIDs.size());
+        for(const auto studentBID : teammateIDs) {
+            StudentRecord *studentB = students.findByID(studentBID);
+            if((studentB != nullptr) && !studentB->deleted && ((sectionName == "") || (sectionName == studentB->section.toString()))) {
+                teammates << studentB;
+            }
+        }
+        std::sort(teammates.begin(), teammates.end());     // all point into students, so this is the students' order
+
+        for(auto *studentB : qAsConst(teammates)) {
+            atLeastOneTeammate = true;
+            *teammatesSpecified = true;
+
+            if(table->columnCount() < column+1) {
+                table->setColumnCount(column+1);
+                table->setHorizontalHeaderItem(column, new QTableWidgetItem(typeText + "\n" + tr("Teammate #") +
+                                                                            QString::number(column + (requestsInSurvey? 0:1))));
+            }
+            auto *box = new QHBoxLayout;
+            auto *label = new QLabel(studentB->firstname + "  " + studentB->lastname, this);        // using two spaces so can split later
+            label->setStyleSheet("QLabel {font-size: 10pt; font-family: 'DM Sans'; color: black;}");
+            //remover should only appear when the text is valid!
+            auto *remover = new QPushButton(QIcon(":/icons_new/trashButton.png"), "", this);
+            remover->setFlat(true);
+            remover->setIconSize(ICONSIZE);
             if(typeOfTeammates == TypeOfTeammates::required) {
-                printStudent = filteredStudent->requiredWith.contains(studentBID);
+                connect(remover, &QPushButton::clicked, this, [this, filteredStudent, studentB, table, &searchIndex]
+                                                        {
+                    int verticalScrollPos = table->verticalScrollBar()->value();
+                    int horizontalScrollPos = table->horizontalScrollBar()->value();
+                                                        filteredStudent->requiredWith.remove(studentB->ID);
+                                                         studentB->requiredWith.remove(filteredStudent->ID);
+                                                         refreshDisplay(TypeOfTeammates::required, verticalScrollPos, horizontalScrollPos, searchIndex.text);
+                                                         initializeTableHeaders(TypeOfTeammates::required, searchIndex.text);
+                });
             }
             else if(typeOfTeammates == TypeOfTeammates::prevented) {
-                printStudent = filteredStudent->preventedWith.contains(studentBID);
+                connect(remover, &QPushButton::clicked, this, [this, filteredStudent, studentB, table, &searchIndex]
+                                                        {
+                    int verticalScrollPos = table->verticalScrollBar()->value();
+                    int horizontalScrollPos = table->horizontalScrollBar()->value();
+                filteredStudent->preventedWith.remove(studentB->ID);
+                                                         studentB->preventedWith.remove(filteredStudent->ID);
+                                                         refreshDisplay(TypeOfTeammates::prevented, verticalScrollPos, horizontalScrollPos, searchIndex.text);
+                                                         initializeTableHeaders(TypeOfTeammates::prevented, searchIndex.text);
+                });
             }
             else {
-                printStudent = filteredStudent->requestedWith.contains(studentBID);
+                connect(remover, &QPushButton::clicked, this, [this, filteredStudent, studentB, table, &searchIndex]
+                                                        {
+                    int verticalScrollPos = table->verticalScrollBar()->value();
+                    int horizontalScrollPos = table->horizontalScrollBar()->value();
+                    filteredStudent->requestedWith.remove(studentB->ID);
+                                                         refreshDisplay(TypeOfTeammates::requested, verticalScrollPos, horizontalScrollPos, searchIndex.text);
+                                                         initializeTableHeaders(TypeOfTeammates::required, searchIndex.text);
+
+                });
             }
-            // add students who X (prevented/required/requested) teammates of baseStudent
-            if(printStudent) {
-                atLeastOneTeammate = true;
-                *teammatesSpecified = true;
-
-                // find studentB from their ID
-                StudentRecord *studentB = nullptr;
-                for(auto &stu : students) {
-                    if((stu.ID == studentBID) && !stu.deleted) {
-                        studentB = &stu;
-                    }
-                }
-                if(studentB == nullptr) {
-                    continue;
-                }
-                if(table->columnCount() < column+1) {
-                    table->setColumnCount(column+1);
-                    table->setHorizontalHeaderItem(column, new QTableWidgetItem(typeText + "\n" + tr("Teammate #") +
-                                                                                QString::number(column + (requestsInSurvey? 0:1))));
-                }
-                auto *box = new QHBoxLayout;
-                auto *label = new QLabel(studentB->firstname + "  " + studentB->lastname, this);        // using two spaces so can split later
-                label->setStyleSheet("QLabel {font-size: 10pt; font-family: 'DM Sans'; color: black;}");
-                //remover should only appear when the text is valid!
-                auto *remover = new QPushButton(QIcon(":/icons_new/trashButton.png"), "", this);
-                remover->setFlat(true);
-                remover->setIconSize(ICONSIZE);
-                if(typeOfTeammates == TypeOfTeammates::required) {
-                    connect(remover, &QPushButton::clicked, this, [this, filteredStudent, studentB, table, searchBarText]
-                                                            {
-                        int verticalScrollPos = table->verticalScrollBar()->value();
-                        int horizontalScrollPos = table->horizontalScrollBar()->value();
-                                                            filteredStudent->requiredWith.remove(studentB->ID);
-                                                             studentB->requiredWith.remove(filteredStudent->ID);
-                                                             refreshDisplay(TypeOfTeammates::required, verticalScrollPos, horizontalScrollPos, searchBarText);
-                                                             initializeTableHeaders(TypeOfTeammates::required, searchBarText);
-                    });
-                }
-                else if(typeOfTeammates == TypeOfTeammates::prevented) {
-                    connect(remover, &QPushButton::clicked, this, [this, filteredStudent, studentB, table, searchBarText]
-                                                            {
-                        int verticalScrollPos = table->verticalScrollBar()->value();
-                        int horizontalScrollPos = table->horizontalScrollBar()->value();
-                    filteredStudent->preventedWith.remove(studentB->ID);
-                                                             studentB->preventedWith.remove(filteredStudent->ID);
-                                                             refreshDisplay(TypeOfTeammates::prevented, verticalScrollPos, horizontalScrollPos, searchBarText);
-                                                             initializeTableHeaders(TypeOfTeammates::prevented, searchBarText);
-                    });
-                }
-                else {
-                    connect(remover, &QPushButton::clicked, this, [this, filteredStudent, studentB, table, searchBarText]
-                                                            {
-                        int verticalScrollPos = table->verticalScrollBar()->value();
-                        int horizontalScrollPos = table->horizontalScrollBar()->value();
-                        filteredStudent->requestedWith.remove(studentB->ID);
-                                                             refreshDisplay(TypeOfTeammates::requested, verticalScrollPos, horizontalScrollPos, searchBarText);
-                                                             initializeTableHeaders(TypeOfTeammates::required, searchBarText);
-
-                    });
-                }
 
-                box->addWidget(label);
-                box->addWidget(remover, 0, Qt::AlignLeft);
-                box->setSpacing(0);
-                auto *widg = new QWidget(this);
-                widg->setLayout(box);
-                widg->setProperty("studentName", label->text());    // used when saving to csv file
-                table->setCellWidget(row, column, widg);
-                column++;
-            }
+            box->addWidget(label);
+            box->addWidget(remover, 0, Qt::AlignLeft);
+            box->setSpacing(0);
+            auto *widg = new QWidget(this);
+            widg->setLayout(box);
+            widg->setProperty("studentName", label->text());    // used when saving to csv file
+            table->setCellWidget(row, column, widg);
+            column++;
         }
         if(atLeastOneTeammate) {
             clearButton->setEnabled(true);
@@ -538,19 +539,8 @@ void TeammatesRulesDialog::refreshDisplay(TypeOfTeammates typeOfTeammates, int v
         lineEdit->setStyleSheet("QLineEdit {font-size: 10pt; font-family: 'DM Sans'; color: black;}");
 
         // Set up the completer with all student names
-        QMap<QString, StudentRecord*> studentNameToIdMap;
-        QStringList studentNames;
-
-        //get all names from baseStudents
-        for (auto *student : baseStudents) {
-            QString fullName = student->firstname + " " + student->lastname;
-            studentNames.append(fullName);
-            studentNameToIdMap[fullName] = student;  // Store name → ID mapping
-        }
         //pressing enter also cancels the dialog
-
-        auto *model = new QStringListModel(studentNames, this);
-        auto *completer = new QCompleter(model, this);
+        auto *completer = new QCompleter(studentNamesModel, this);
         completer->setCaseSensitivity(Qt::CaseInsensitive);
         completer->setFilterMode(Qt::MatchContains);
         lineEdit->setCompleter(completer);
@@ -559,7 +549,7 @@ void TeammatesRulesDialog::refreshDisplay(TypeOfTeammates typeOfTeammates, int v
         confirmButton->setIcon(QIcon(":/icons_new/Checkmark.png"));
 
         if(typeOfTeammates == TypeOfTeammates::required) {
-            connect(confirmButton, &QPushButton::clicked, this, [this, table, lineEdit, filteredStudent, studentNameToIdMap, searchBarText](){
+            connect(confirmButton, &QPushButton::clicked, this, [this, table, lineEdit, filteredStudent, studentNameToIdMap, &searchIndex](){
                 QString newText = lineEdit->text(); //get the current text
                 //check that the student name is valid and that user is not adding the student itself to the list.
                 if (studentNameToIdMap.contains(newText)){
@@ -570,8 +560,8 @@ void TeammatesRulesDialog::refreshDisplay(TypeOfTeammates typeOfTeammates, int v
                         //keep the current scroll position for user
                         int verticalScrollPos = table->verticalScrollBar()->value();
                         int horizontalScrollPos = table->horizontalScrollBar()->value();
-                        refreshDisplay(TypeOfTeammates::required, verticalScrollPos, horizontalScrollPos, searchBarText);
-                        initializeTableHeaders(TypeOfTeammates::required, searchBarText);
+                        refreshDisplay(TypeOfTeammates::required, verticalScrollPos, horizontalScrollPos, searchIndex.text);
+                        initializeTableHeaders(TypeOfTeammates::required, searchIndex.text);
                     } else {
                         showToast(this, "Cannot prevent a student with themselves.");
                     }
@@ -583,7 +573,7 @@ void TeammatesRulesDialog::refreshDisplay(TypeOfTeammates typeOfTeammates, int v
                 }
             });
         } else if(typeOfTeammates == TypeOfTeammates::prevented){
-            connect(confirmButton, &QPushButton::clicked, this, [this, table, lineEdit, filteredStudent, studentNameToIdMap, searchBarText](){
+            connect(confirmButton, &QPushButton::clicked, this, [this, table, lineEdit, filteredStudent, studentNameToIdMap, &searchIndex](){
                 QString newText = lineEdit->text(); //get the current text
                 //check that the student name is valid and that user is not adding the student itself to the list.
                 if (studentNameToIdMap.contains(newText)){
@@ -594,8 +584,8 @@ void TeammatesRulesDialog::refreshDisplay(TypeOfTeammates typeOfTeammates, int v
                         //keep the current scroll position for user
                         int verticalScrollPos = table->verticalScrollBar()->value();
                         int horizontalScrollPos = table->horizontalScrollBar()->value();
-                        refreshDisplay(TypeOfTeammates::prevented, verticalScrollPos, horizontalScrollPos, searchBarText);
-                        initializeTableHeaders(TypeOfTeammates::prevented, searchBarText);
+                        refreshDisplay(TypeOfTeammates::prevented, verticalScrollPos, horizontalScrollPos, searchIndex.text);
+                        initializeTableHeaders(TypeOfTeammates::prevented, searchIndex.text);
                     } else {
                         showToast(this, "Cannot prevent a student with themselves.");
                     }
@@ -606,7 +596,7 @@ void TeammatesRulesDialog::refreshDisplay(TypeOfTeammates typeOfTeammates, int v
                 }
             });
         } else if(typeOfTeammates == TypeOfTeammates::requested){
-            connect(confirmButton, &QPushButton::clicked, this, [this, table, lineEdit, filteredStudent, studentNameToIdMap, searchBarText](){
+            connect(confirmButton, &QPushButton::clicked, this, [this, table, lineEdit, filteredStudent, studentNameToIdMap, &searchIndex](){
                 QString newText = lineEdit->text(); //get the current text
                 //check that the student name is valid and that user is not adding the student filteredStudent to the list.
                 if (studentNameToIdMap.contains(newText) && studentNameToIdMap[newText]->ID != filteredStudent->ID ){
@@ -617,8 +607,8 @@ void TeammatesRulesDialog::refreshDisplay(TypeOfTeammates typeOfTeammates, int v
                         //keep the current scroll position for user
                         int verticalScrollPos = table->verticalScrollBar()->value();
                         int horizontalScrollPos = table->horizontalScrollBar()->value();
-                        refreshDisplay(TypeOfTeammates::requested, verticalScrollPos, horizontalScrollPos, searchBarText);
-                        initializeTableHeaders(TypeOfTeammates::requested, searchBarText);
+                        refreshDisplay(TypeOfTeammates::requested, verticalScrollPos, horizontalScrollPos, searchIndex.text);
+                        initializeTableHeaders(TypeOfTeammates::requested, searchIndex.text);
                     } else {
                         showToast(this, "Cannot prevent a student with themselves.");
                     }
@@ -637,10 +627,72 @@ void TeammatesRulesDialog::refreshDisplay(TypeOfTeammates typeOfTeammates, int v
     }
     table->resizeColumnsToContents();
     table->resizeRowsToContents();
+
+    // all rows are shown, now hide those not matching the search bar text
+    searchIndex.text.clear();
+    filterDisplay(typeOfTeammates, searchBarText);
     table->verticalScrollBar()->setValue(verticalScrollPos);
     table->horizontalScrollBar()->setValue(horizontalScrollPos);
 }
 
+//////////////////
+// Show only the rows whose student's name contains the search bar text, without rebuilding the table.
+// When the text only grows more specific, just the rows matching now can match still, so only those are checked,
+// and only the rows whose matching changed are shown or hidden.
+//////////////////
+void TeammatesRulesDialog::filterDisplay(TypeOfTeammates typeOfTeammates, const QString &searchBarText)
+{
+    QTableWidget *table;
+    if(typeOfTeammates == TypeOfTeammates::required) {
+        table = required_tableWidget;
+    }
+    else if (typeOfTeammates == TypeOfTeammates::prevented) {
+        table = prevented_tableWidget;
+    }
+    else {
+        table = requested_tableWidget;
+    }
+    SearchIndex &searchIndex = searchIndexes[static_cast<int>(typeOfTeammates)];
+    const QString searchText = searchBarText.toLower();
+
+    QList<int> matchingRows;
+    if(searchText.contains(searchIndex.text.toLower())) {
+        for(const int row : qAsConst(searchIndex.matchingRows)) {
+            if(searchIndex.lowercaseNames.at(row).contains(searchText)) {
+                matchingRows << row;
+            }
+        }
+    }
+    else {
+        for(int row = 0, numRows = int(searchIndex.lowercaseNames.size()); row < numRows; row++) {
+            if(searchIndex.lowercaseNames.at(row).contains(searchText)) {
+                matchingRows << row;
+            }
+        }
+    }
+
+    // both lists of rows are in order, so walk through them together
+    auto prevRow = searchIndex.matchingRows.cbegin();
+    auto newRow = matchingRows.cbegin();
+    while((prevRow != searchIndex.matchingRows.cend()) || (newRow != matchingRows.cend())) {
+        if((newRow == matchingRows.cend()) || ((prevRow != searchIndex.matchingRows.cend()) && (*prevRow < *newRow))) {
+            table->setRowHidden(*prevRow, true);
+            prevRow++;
+        }
+        else if((prevRow == searchIndex.matchingRows.cend()) || (*newRow < *prevRow)) {
+            table->setRowHidden(*newRow, false);
+            newRow++;
+        }
+        else {
+            prevRow++;
+            newRow++;
+        }
+    }
+
+    searchIndex.text = searchBarText;
+    searchIndex.matchingRows = matchingRows;
+}
+
 void TeammatesRulesDialog::initializeTableHeaders(TypeOfTeammates typeOfTeammates, QString searchBarText, bool initializeStatus){
     //headerLayout
     //initialize TypeOfTeammates::required header
@@ -689,8 +741,8 @@ void TeammatesRulesDialog::initializeTableHeaders(TypeOfTeammates typeOfTeammate
 
     studentSearchBar->setText(searchBarText);
     studentSearchBar->setStyleSheet("QLineEdit { font-size: 10pt; font-family: 'DM Sans'; color: black; background-color: white; border: 1px solid lightGray; border-radius: 5px}");
-    connect(studentSearchBar, &QLineEdit::textChanged, this, [this, typeOfTeammates, studentSearchBar](){
-        refreshDisplay(typeOfTeammates, 0, 0, studentSearchBar->text());
+    connect(studentSearchBar, &QLineEdit::textChanged, this, [this, typeOfTeammates](const QString &text){
+        filterDisplay(typeOfTeammates, text);
     });
     headerWidget->setFixedHeight(studentSearchBar->sizeHint().height() + 35);
 
@@ -749,7 +801,7 @@ void TeammatesRulesDialog::addTeammateSelector(TypeOfTeammates typeOfTeammates)
     studentcombobox->setStyleSheet(COMBOBOXSTYLE);
     for(const auto &student : qAsConst(students)) {
         studentcombobox->setPlaceholderText(comboBoxes->first()->placeholderText());
-        if(((sectionName == "") || (sectionName == student.section)) && !student.deleted) {
+        if(((sectionName == "") || (sectionName == student.section.toString())) && !student.deleted) {
             studentcombobox->addItem(student.lastname + ", " + student.firstname, student.ID);
         }
     }
@@ -787,28 +839,16 @@ void TeammatesRulesDialog::addOneTeammateSet(TypeOfTeammates typeOfTeammates)
         //Work through all pairings in the set to enable as a required or prevented pairing in both studentRecords
         for(int ID1 = 0; ID1 < IDs.size(); ID1++) {
             // find the student with ID1
-            int index = 0;
-            while((students.at(index).ID != IDs[ID1]) && (index < numStudents)) {
-                index++;
-            }
-            if(index < numStudents) {
-                student1 = &students[index];
-            }
-            else {
+            student1 = students.findByID(IDs[ID1]);
+            if(student1 == nullptr) {
                 continue;
             }
 
             for(int ID2 = ID1+1; ID2 < IDs.size(); ID2++) {
                 if(IDs[ID1] != IDs[ID2]) {
                     // find the student with ID2
-                    index = 0;
-                    while((students.at(index).ID != IDs[ID2]) && (index < numStudents)) {
-                        index++;
-                    }
-                    if(index < numStudents) {
-                        student2 = &students[index];
-                    }
-                    else {
+                    student2 = students.findByID(IDs[ID2]);
+                    if(student2 == nullptr) {
                         continue;
                     }
 
@@ -828,14 +868,8 @@ void TeammatesRulesDialog::addOneTeammateSet(TypeOfTeammates typeOfTeammates)
     else {
         const int baseStudentID = ui->requested_studentSelectComboBox->currentData().toInt();
         // find the student with this ID
-        StudentRecord *baseStudent = nullptr;
-        int index = 0;
-        while((students.at(index).ID != baseStudentID) && (index < numStudents)) {
-            index++;
-        }
-        if(index < numStudents) {
-            baseStudent = &students[index];
-
+        StudentRecord *baseStudent = students.findByID(baseStudentID);
+        if(baseStudent != nullptr) {
             for(const int ID : qAsConst(IDs)) {
                 if(baseStudentID != ID) {
                     //we have at least one requested teammate pair!
@@ -893,7 +927,7 @@ void TeammatesRulesDialog::clearValues(TypeOfTeammates typeOfTeammates, bool ver
     }
 
     for(auto &student : students) {
-        if((sectionName == "") || (sectionName == student.section)) {
+        if((sectionName == "") || (sectionName == student.section.toString())) {
             for(int index2 = 0; index2 < numStudents; index2++) {
                 if(typeOfTeammates == TypeOfTeammates::required) {
                     student.requiredWith.remove(index2);
@@ -915,6 +949,100 @@ void TeammatesRulesDialog::clearValues(TypeOfTeammates typeOfTeammates, bool ver
     refreshDisplay(typeOfTeammates, 0, 0);
 }
 
+//////////////////
+// Convert lists of names into lists of student IDs, with -1 for each name not resolved. Names and email addresses that exactly match a student
+// are looked up directly. The rest are fuzzy-matched all at once, in parallel. A name whose closest student is both close and clearly closer
+// than the next closest is matched automatically, and the remaining ones are shown together in one table for the user to resolve.
+//////////////////
+QList<QList<long long>> TeammatesRulesDialog::findStudentIDs(const QList<QStringList> &nameLists, const QStringList &namesOfStudentsWhoAsked)
+{
+    // look up each distinct name just once, collecting the ones without an exact match
+    QHash<QString, long long> IDOfName;                 // keyed by normalized name
+    QList<TeammateNamesReconciliationDialog::UnresolvedName> inexactNames;
+    QHash<QString, int> indexOfInexactName;             // keyed by normalized name
+    for(int list = 0; list < nameLists.size(); list++) {
+        const QString whoAsked = ((list < namesOfStudentsWhoAsked.size())? namesOfStudentsWhoAsked.at(list) : "");
+        for(const auto &name : nameLists.at(list)) {
+            const QString normalizedName = StudentNameIndex::normalized(name);
+            if(IDOfName.contains(normalizedName)) {
+                continue;
+            }
+            const auto inexactName = indexOfInexactName.constFind(normalizedName);
+            if(inexactName != indexOfInexactName.constEnd()) {
+                if(!whoAsked.isEmpty()) {
+                    inexactNames[*inexactName].namesOfStudentsWhoAsked << whoAsked;
+                }
+                continue;
+            }
+
+            long long knownStudentID = nameIndex->findName(name);
+            if(knownStudentID == -1) {
+                knownStudentID = nameIndex->findEmail(name);
+            }
+            if(knownStudentID != -1) {
+                // Exact match found
+                IDOfName.insert(normalizedName, knownStudentID);
+            }
+            else {
+                indexOfInexactName.insert(normalizedName, int(inexactNames.size()));
+                inexactNames.append({name.simplified(), (whoAsked.isEmpty()? QStringList() : QStringList(whoAsked)), {}});
+            }
+        }
+    }
+
+    // find the closest students to all of the inexact names in parallel, then accept the confident matches
+    QList<int> indexes(inexactNames.size());
+    std::iota(indexes.begin(), indexes.end(), 0);
+    const auto findCandidates = [&inexactNames, this](const int index) {
+        return nameIndex->closestNames(inexactNames.at(index).name, MAX_CANDIDATES);
+    };
+    const QList<QList<StudentNameIndex::Match>> candidates = QtConcurrent::blockingMapped<QList<QList<StudentNameIndex::Match>>>(indexes, findCandidates);
+
+    QList<TeammateNamesReconciliationDialog::UnresolvedName> ambiguousNames;
+    int numNamesMatchedAutomatically = 0;
+    for(int index = 0, numInexactNames = int(inexactNames.size()); index < numInexactNames; index++) {
+        auto &inexactName = inexactNames[index];
+        inexactName.candidates = candidates.at(index);
+        const QString normalizedName = StudentNameIndex::normalized(inexactName.name);
+        const auto &closest = inexactName.candidates;
+        const bool confidentMatch = !closest.isEmpty() && (closest.at(0).distance <= int(float(normalizedName.size()) * AUTOMATCH_MAX_DISTANCE)) &&
+                                    ((closest.size() == 1) || ((closest.at(1).distance - closest.at(0).distance) >= AUTOMATCH_MIN_MARGIN));
+        if(confidentMatch) {
+            IDOfName.insert(normalizedName, closest.at(0).ID);
+            numNamesMatchedAutomatically++;
+        }
+        else {
+            ambiguousNames << inexactName;
+        }
+    }
+
+    // let the user resolve the rest, all in one table
+    if(!ambiguousNames.isEmpty()) {
+        auto *reconciliationWindow = new TeammateNamesReconciliationDialog(students, ambiguousNames, numNamesMatchedAutomatically, this);
+        if(reconciliationWindow->exec() == QDialog::Accepted) {
+            for(int ambiguousName = 0, numAmbiguousNames = int(ambiguousNames.size()); ambiguousName < numAmbiguousNames; ambiguousName++) {
+                const long long ID = reconciliationWindow->resolvedIDs.at(ambiguousName);
+                if(ID != -1) {
+                    IDOfName.insert(StudentNameIndex::normalized(ambiguousNames.at(ambiguousName).name), ID);
+                }
+            }
+        }
+        delete reconciliationWindow;
+    }
+
+    QList<QList<long long>> IDLists;
+    IDLists.reserve(nameLists.size());
+    for(const auto &nameList : nameLists) {
+        QList<long long> IDs;
+        IDs.reserve(nameList.size());
+        for(const auto &name : nameList) {
+            IDs << IDOfName.value(StudentNameIndex::normalized(name), -1);
+        }
+        IDLists << IDs;
+    }
+    return IDLists;
+}
+
 bool TeammatesRulesDialog::loadCSVFile(TypeOfTeammates typeOfTeammates)
 {
     QString typeText;
@@ -992,40 +1120,11 @@ bool TeammatesRulesDialog::loadCSVFile(TypeOfTeammates typeOfTeammates)
         teammates[basestudent].prepend(basenames.at(basestudent));
     }
 
-    QList<long long> IDs;
-    for(int basename = 0; basename < basenames.size(); basename++) {
-        IDs.clear();
-        for(const auto &searchStudent : teammates.at(basename)) {   // searchStudent is the name we're looking for
-            int knownStudent = 0;     // start at first student in database and look until we find a matching first+last name
-            while((knownStudent < numStudents) &&
-                   (searchStudent.compare(students[knownStudent].firstname + " " + students[knownStudent].lastname, Qt::CaseInsensitive) != 0)) {
-                knownStudent++;
-            }
-
-            if(knownStudent != numStudents) {
-                // Exact match found
-                IDs << students[knownStudent].ID;
-            }
-            else {
-                // No exact match, so list possible matches sorted by Levenshtein distance
-                auto *choiceWindow = new findMatchingNameDialog(students, searchStudent, this);
-                if(choiceWindow->exec() == QDialog::Accepted) {
-                    IDs << choiceWindow->currSurveyID;
-                }
-                delete choiceWindow;
-            }
-        }
-
+    const QList<QList<long long>> IDLists = findStudentIDs(teammates);
+    for(const auto &IDs : IDLists) {
         // find the baseStudent
-        int index = 0;
-        StudentRecord *baseStudent = nullptr, *student2 = nullptr;
-        while((students.at(index).ID != IDs[0]) && (index < numStudents)) {
-            index++;
-        }
-        if(index < numStudents) {
-            baseStudent = &students[index];
-        }
-        else {
+        StudentRecord *baseStudent = students.findByID(IDs[0]), *student2 = nullptr;
+        if(baseStudent == nullptr) {
             continue;
         }
 
@@ -1033,14 +1132,8 @@ bool TeammatesRulesDialog::loadCSVFile(TypeOfTeammates typeOfTeammates)
         for(int ID2 = 1; ID2 < IDs.size(); ID2++) {
             if(IDs[0] != IDs[ID2]) {
                 // find the student with ID2
-                index = 0;
-                while((students.at(index).ID != IDs[ID2]) && (index < numStudents)) {
-                    index++;
-                }
-                if(index < numStudents) {
-                    student2 = &students[index];
-                }
-                else {
+                student2 = students.findByID(IDs[ID2]);
+                if(student2 == nullptr) {
                     continue;
                 }
 
@@ -1066,10 +1159,12 @@ bool TeammatesRulesDialog::loadCSVFile(TypeOfTeammates typeOfTeammates)
 
 bool TeammatesRulesDialog::loadStudentPrefs(TypeOfTeammates typeOfTeammates)
 {
-    // Need to convert names to IDs and then add all to the preferences
-    QList<long long> IDs;
+    // Gather the preferences of each student in the section
+    QList<int> basestudents;
+    QList<QStringList> prefLists;
+    QStringList namesOfStudentsWhoAsked;
     for(int basestudent = 0; basestudent < numStudents; basestudent++) {
-        if((sectionName == "") || (sectionName == students[basestudent].section)) {
+        if(((sectionName == "") || (sectionName == students[basestudent].section.toString())) && !students[basestudent].deleted) {
             QStringList prefs;
             if(typeOfTeammates == TypeOfTeammates::prevented) {
                 prefs = students[basestudent].prefNonTeammates.split('\n');
@@ -1078,71 +1173,40 @@ bool TeammatesRulesDialog::loadStudentPrefs(TypeOfTeammates typeOfTeammates)
                 prefs = students[basestudent].prefTeammates.split('\n');
             }
             prefs.removeAll("");
-            prefs.prepend(students[basestudent].firstname + " " + students[basestudent].lastname);
-
-            IDs.clear();
-            IDs.reserve(prefs.size());
-            for(int searchStudent = 0; searchStudent < prefs.size(); searchStudent++) {   // searchStudent is the name we're looking for
-                int knownStudent = 0;     // start at first student in database and look until we find a matching first+last name
-                while((knownStudent < numStudents) &&
-                       (prefs.at(searchStudent).compare((students[knownStudent].firstname + " " + students[knownStudent].lastname), Qt::CaseInsensitive) != 0)) {
-                    knownStudent++;
-                }
+            if(prefs.isEmpty()) {
+                continue;
+            }
+            basestudents << basestudent;
+            prefLists << prefs;
+            namesOfStudentsWhoAsked << students[basestudent].firstname + " " + students[basestudent].lastname;
+        }
+    }
 
-                if(knownStudent != numStudents) {
-                    // Exact match found
-                    IDs << students[knownStudent].ID;
-                }
-                else {
-                    // No exact match, so list possible matches sorted by Levenshtein distance
-                    auto *choiceWindow = new findMatchingNameDialog(students, prefs.at(searchStudent), this, prefs.at(0));
-                    if(choiceWindow->exec() == QDialog::Accepted) {
-                        IDs << choiceWindow->currSurveyID;
-                    }
-                    delete choiceWindow;
-                }
+    // Need to convert names to IDs and then add all to the preferences
+    const QList<QList<long long>> IDLists = findStudentIDs(prefLists, namesOfStudentsWhoAsked);
+    for(int asker = 0; asker < basestudents.size(); asker++) {
+        StudentRecord *baseStudent = &students[basestudents.at(asker)], *student2 = nullptr;
 
-                // find the baseStudent
-                int index = 0;
-                StudentRecord *baseStudent = nullptr, *student2 = nullptr;
-                while((students.at(index).ID != IDs[0]) && (index < numStudents)) {
-                    index++;
-                }
-                if(index < numStudents) {
-                    baseStudent = &students[index];
-                }
-                else {
+        //Add to the student who asked all of the IDs in their preferences as a required / prevented / requested pairing
+        for(const auto ID2 : IDLists.at(asker)) {
+            if(baseStudent->ID != ID2) {
+                // find the student with ID2
+                student2 = students.findByID(ID2);
+                if(student2 == nullptr) {
                     continue;
                 }
 
-                //Add to the first ID (the basename) in each set all of the subsequent IDs in the set as a required / prevented / requested pairing
-                for(int ID2 = 1; ID2 < IDs.size(); ID2++) {
-                    if(IDs[0] != IDs[ID2]) {
-                        // find the student with ID2
-                        index = 0;
-                        while((students.at(index).ID != IDs[ID2]) && (index < numStudents)) {
-                            index++;
-                        }
-                        if(index < numStudents) {
-                            student2 = &students[index];
-                        }
-                        else {
-                            continue;
-                        }
-
-                        //we have at least one specified teammate pair!
-                        if(typeOfTeammates == TypeOfTeammates::required) {
-                            baseStudent->requiredWith << IDs[ID2];
-                            student2->requiredWith << IDs[0];
-                        }
-                        else if(typeOfTeammates == TypeOfTeammates::prevented) {
-                            baseStudent->preventedWith << IDs[ID2];
-                            student2->preventedWith << IDs[0];
-                        }
-                        else {  //whatType == requested
-                            baseStudent->requestedWith << IDs[ID2];
-                        }
-                    }
+                //we have at least one specified teammate pair!
+                if(typeOfTeammates == TypeOfTeammates::required) {
+                    baseStudent->requiredWith << ID2;
+                    student2->requiredWith << baseStudent->ID;
+                }
+                else if(typeOfTeammates == TypeOfTeammates::prevented) {
+                    baseStudent->preventedWith << ID2;
+                    student2->preventedWith << baseStudent->ID;
+                }
+                else {  //whatType == requested
+                    baseStudent->requestedWith << ID2;
                 }
             }
         }
@@ -1204,57 +1268,22 @@ bool TeammatesRulesDialog::loadSpreadsheetFile(TypeOfTeammates typeOfTeammates)
 
     // Now we have list of teams and corresponding lists of teammates by name
     // Need to convert names to IDs and then work through all teammate pairings
-    QList<long long> IDs;
-    for(const auto &teammateList : qAsConst(teammateLists)) {
-        IDs.clear();
-        IDs.reserve(teammateList.size());
-        for(const auto &searchStudent : teammateList) {     // searchStudent is the name we're looking for
-            int knownStudent = 0;     // start at first student in database and look until we find a matching first+last name
-            while((knownStudent < numStudents) &&
-                   (searchStudent.compare(students[knownStudent].firstname + " " + students[knownStudent].lastname, Qt::CaseInsensitive) != 0)) {
-                knownStudent++;
-            }
-
-            if(knownStudent != numStudents) {
-                // Exact match found
-                IDs << students[knownStudent].ID;
-            }
-            else {
-                // No exact match, so list possible matches sorted by Levenshtein distance
-                auto *choiceWindow = new findMatchingNameDialog(students, searchStudent, this);
-                if(choiceWindow->exec() == QDialog::Accepted) {
-                    IDs << choiceWindow->currSurveyID;
-                }
-                delete choiceWindow;
-            }
-        }
-
+    const QList<QList<long long>> IDLists = findStudentIDs(teammateLists);
+    for(const auto &IDs : IDLists) {
         //Work through all pairings in the set to enable as a required or prevented pairing in both studentRecords
         StudentRecord *student1 = nullptr, *student2 = nullptr;
         for(int ID1 = 0; ID1 < IDs.size(); ID1++) {
             // find the student with ID1
-            int index = 0;
-            while((students.at(index).ID != IDs[ID1]) && (index < numStudents)) {
-                index++;
-            }
-            if(index < numStudents) {
-                student1 = &students[index];
-            }
-            else {
+            student1 = students.findByID(IDs[ID1]);
+            if(student1 == nullptr) {
                 continue;
             }
 
             for(int ID2 = ID1+1; ID2 < IDs.size(); ID2++) {
                 if(IDs[ID1] != IDs[ID2]) {
                     // find the student with ID2
-                    index = 0;
-                    while((students.at(index).ID != IDs[ID2]) && (index < numStudents)) {
-                        index++;
-                    }
-                    if(index < numStudents) {
-                        student2 = &students[index];
-                    }
-                    else {
+                    student2 = students.findByID(IDs[ID2]);
+                    if(student2 == nullptr) {
                         continue;
                     }
 
@@ -6,6 +6,7 @@
 #include "qabstractbutton.h"
 #include "qboxlayout.h"
 #include "qtablewidget.h"
+#include "studentNameIndex.h"
 #include "studentRecord.h"
 #include "teamingOptions.h"
 #include <QComboBox>
@@ -20,8 +21,8 @@ class TeammatesRulesDialog : public QDialog
 
 public:
     enum class TypeOfTeammates{required, prevented, requested};
-    explicit TeammatesRulesDialog(const QList<StudentRecord> &incomingStudents, const DataOptions &dataOptions, const TeamingOptions &teamingOptions,
-                                  const QString &sectionname, const QStringList &currTeamSets, QWidget *parent = nullptr,
+    explicit TeammatesRulesDialog(const QList<StudentRecord> &incomingStudents, std::shared_ptr<const StudentNameIndex> incomingNameIndex,
+                                  const DataOptions &dataOptions, const TeamingOptions &teamingOptions, const QString &sectionname, const QStringList &currTeamSets, QWidget *parent = nullptr,
                                   bool autoLoadRequired = false, bool autoLoadPrevented = false, bool autoLoadRequested = false, int initialTabIndex = 0);
     ~TeammatesRulesDialog() override;
     TeammatesRulesDialog(const TeammatesRulesDialog&) = delete;
@@ -38,7 +39,7 @@ public:
     QAbstractButton *topLeftTableHeaderButton;
     int initialWidthStudentHeader;
 
-    QList<StudentRecord> students;
+    StudentList students;
     bool required_teammatesSpecified = false;
     bool prevented_teammatesSpecified = false;
     bool requested_teammatesSpecified = false;
@@ -57,6 +58,7 @@ private:
     bool positiverequestsInSurvey = false;
     bool negativerequestsInSurvey = false;
     const int numStudents;
+    const std::shared_ptr<const StudentNameIndex> nameIndex;      // of the incoming students, shared with the main window rather than rebuilt here
     QString sectionName;
     QStringList teamSets;
 
@@ -64,10 +66,15 @@ private:
     QList <QComboBox *> possiblePreventedTeammates;
     QList <QComboBox *> possibleRequestedTeammates;
 
+    // for each table, the lowercase name in each row, and the rows matching the search bar text
+    struct SearchIndex {QStringList lowercaseNames; QString text; QList<int> matchingRows;};
+    SearchIndex searchIndexes[3];
+
     void showToast(QWidget *parent, const QString &message, int duration = 3000);
     void initializeTableHeaders(TypeOfTeammates typeOfTeammates, QString searchBarText = "", bool initializeStatus = false);
     void addTeammateSelector(TypeOfTeammates typeOfTeammates);
     void refreshDisplay(TypeOfTeammates typeOfTeammates, int verticalScrollPos, int horizontalScrollPos, QString searchBarText="");
+    void filterDisplay(TypeOfTeammates typeOfTeammates, const QString &searchBarText);
     void addOneTeammateSet(TypeOfTeammates typeOfTeammates);
     void clearValues(TypeOfTeammates typeOfTeammates, bool verify = true);
 
@@ -77,8 +84,12 @@ private:
     bool loadStudentPrefs(TypeOfTeammates typeOfTeammates);
     bool loadSpreadsheetFile(TypeOfTeammates typeOfTeammates);
     bool loadExistingTeamset(TypeOfTeammates typeOfTeammates);
+    QList<QList<long long>> findStudentIDs(const QList<QStringList> &nameLists, const QStringList &namesOfStudentsWhoAsked = {});     // -1 for each name not resolved
 
     const QSize ICONSIZE = QSize(15,15);
+    inline static const int MAX_CANDIDATES = 10;                // number of closest students offered for each name not matched exactly
+    inline static const float AUTOMATCH_MAX_DISTANCE = 0.25F;   // a name is matched automatically if its closest student is within this fraction of its length...
+    inline static const int AUTOMATCH_MIN_MARGIN = 2;           // ...and is closer by at least this much than the next closest
 };
 
 #endif // TEAMMATESRULESDIALOG_H
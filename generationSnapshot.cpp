@@ -0,0 +1,97 @@
+#include "generationSnapshot.h"
+#include <algorithm>
+
+namespace {
+    float medianOf(const float *const scores, const int *const orderedIndex, const int begin, const int end)
+    {
+        const int count = end - begin;
+        if((count % 2) != 0) {
+            return scores[orderedIndex[count/2 + begin]];
+        }
+
+        const float right = scores[orderedIndex[count/2 + begin]];
+        const float left = scores[orderedIndex[count/2 - 1 + begin]];
+        return (right + left) / 2.0F;
+    }
+}
+
+
+GenerationSnapshot GenerationSnapshot::fromScores(const float *const scores, const int *const orderedIndex, const int populationSize)
+{
+    GenerationSnapshot snapshot;
+    if(populationSize <= 0) {
+        return snapshot;
+    }
+
+    // drop outliers at the low end
+    const int count = std::max(1, populationSize - (populationSize * IGNORE_LOWEST_X_PERCENT / 100));
+    snapshot.bestScore = scores[orderedIndex[0]];
+    snapshot.lowestScore = scores[orderedIndex[count - 1]];
+    snapshot.median = medianOf(scores, orderedIndex, 0, count);
+    snapshot.upperQuartile = ((count >= 2)? medianOf(scores, orderedIndex, 0, count/2) : snapshot.median);
+    snapshot.lowerQuartile = ((count >= 2)? medianOf(scores, orderedIndex, count/2, count) : snapshot.median);
+    return snapshot;
+}
+
+
+//////////////////
+// Producer side: write the slot, then publish it by advancing numPushed with release ordering
+//////////////////
+bool GenerationSnapshotChannel::push(const GenerationSnapshot &snapshot)
+{
+    publishLatest(snapshot);
+
+    const unsigned long long pushed = numPushed.load(std::memory_order_relaxed);
+    if((pushed - numPopped.load(std::memory_order_acquire)) >= CAPACITY) {
+        return false;
+    }
+    snapshots[pushed % CAPACITY] = snapshot;
+    numPushed.store(pushed + 1, std::memory_order_release);
+    return true;
+}
+
+
+//////////////////
+// Producer side of the latest snapshot: write the producer's slot, then swap it for the shared slot, flagged as fresh
+//////////////////
+void GenerationSnapshotChannel::publishLatest(const GenerationSnapshot &snapshot)
+{
+    latestSnapshots[producerSlot] = snapshot;
+    producerSlot = sharedSlot.exchange(producerSlot | FRESH, std::memory_order_acq_rel) & SLOTMASK;
+}
+
+
+//////////////////
+// Consumer side: read the slot, then free it by advancing numPopped with release ordering
+//////////////////
+bool GenerationSnapshotChannel::pop(GenerationSnapshot &snapshot)
+{
+    const unsigned long long popped = numPopped.load(std::memory_order_relaxed);
+    if(popped == numPushed.load(std::memory_order_acquire)) {
+        return false;
+    }
+    snapshot = snapshots[popped % CAPACITY];
+    numPopped.store(popped + 1, std::memory_order_release);
+    return true;
+}
+
+
+//////////////////
+// Consumer side of the latest snapshot: if the shared slot is fresh, swap the consumer's slot for it, then read it
+//////////////////
+bool GenerationSnapshotChannel::takeLatest(GenerationSnapshot &snapshot)
+{
+    if((sharedSlot.load(std::memory_order_relaxed) & FRESH) == 0) {
+        return false;
+    }
+    consumerSlot = sharedSlot.exchange(consumerSlot, std::memory_order_acq_rel) & SLOTMASK;
+    snapshot = latestSnapshots[consumerSlot];
+    return true;
+}
+
+
+void GenerationSnapshotChannel::clear()
+{
+    numPopped.store(numPushed.load(std::memory_order_acquire), std::memory_order_release);
+    sharedSlot.store(sharedSlot.load(std::memory_order_acquire) & SLOTMASK, std::memory_order_release);
+}
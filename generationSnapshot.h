@@ -0,0 +1,62 @@
+#ifndef GENERATIONSNAPSHOT_H
+#define GENERATIONSNAPSHOT_H
+
+#include <array>
+#include <atomic>
+
+/**
+ * @brief The GenerationSnapshot struct summarizes the scores of one generation of the genetic algorithm, so that
+ * the progress of an optimization can be shown without the UI reading the population while it is being replaced.
+ */
+struct GenerationSnapshot
+{
+    int generation = 0;
+    float bestScore = 0;
+    float upperQuartile = 0;
+    float median = 0;
+    float lowerQuartile = 0;
+    float lowestScore = 0;              // after ignoring the lowest-scoring outliers
+    float scoreStability = 0;
+    bool unpenalizedGenomePresent = false;
+    float msecsPerGeneration = 0;
+
+    /**
+     * @brief fromScores Summarizes the scores of a population; orderedIndex lists the genomes from highest to lowest score.
+     */
+    static GenerationSnapshot fromScores(const float *const scores, const int *const orderedIndex, const int populationSize);
+
+    inline static const int IGNORE_LOWEST_X_PERCENT = 5;
+};
+
+
+/**
+ * @brief The GenerationSnapshotChannel class passes snapshots from the optimization thread to the UI thread without locking.
+ * It has a single producer and a single consumer: only the optimization thread pushes, and only the UI thread pops.
+ * Neither thread ever waits for the other. Each snapshot goes into a ring buffer of the generations' history, which drops new
+ * snapshots if the UI falls behind and it is full, and also replaces the latest snapshot, which is never dropped. The latest
+ * snapshot is triple buffered: the producer and consumer each own one slot and swap it for the shared slot in between.
+ */
+class GenerationSnapshotChannel
+{
+public:
+    bool push(const GenerationSnapshot &snapshot);      // returns false if the history is full and the snapshot was left out of it
+    bool pop(GenerationSnapshot &snapshot);             // the next snapshot in the history; returns false if there is no new one
+    bool takeLatest(GenerationSnapshot &snapshot);      // the most recent snapshot; returns false if there is none since it was last taken
+    void clear();                                       // only to be called while the optimization thread is not running
+
+private:
+    inline static const int CAPACITY = 1024;
+    std::array<GenerationSnapshot, CAPACITY> snapshots;
+    alignas(64) std::atomic<unsigned long long> numPushed = 0;     // separate cache lines, so the two threads don't contend over them
+    alignas(64) std::atomic<unsigned long long> numPopped = 0;
+
+    inline static const int SLOTMASK = 0b011;
+    inline static const int FRESH = 0b100;              // flags the shared slot as holding a snapshot the consumer has not yet taken
+    std::array<GenerationSnapshot, 3> latestSnapshots;
+    int producerSlot = 0;
+    int consumerSlot = 1;
+    alignas(64) std::atomic<int> sharedSlot = 2;
+    void publishLatest(const GenerationSnapshot &snapshot);
+};
+
+#endif // GENERATIONSNAPSHOT_H
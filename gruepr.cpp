@@ -14,25 +14,29 @@
 #include "dialogs/customTeamsizesDialog.h"
 #include "dialogs/editOrAddStudentDialog.h"
 #include "dialogs/editSectionNamesDialog.h"
-#include "dialogs/findMatchingNameDialog.h"
 #include "dialogs/gatherURMResponsesDialog.h"
+#include "dialogs/rosterReconciliationDialog.h"
 #include "dialogs/teammatesRulesDialog.h"
-#include "widgets/pushButtonWithMouseEnter.h"
+#include "studentNameIndex.h"
 #include "widgets/groupingCriteriaCardWidget.h"
-#include "widgets/sortableTableWidgetItem.h"
+#include "widgets/studentTableWidget.h"
 #include "widgets/teamsTabItem.h"
 #include <QComboBox>
 #include <QDesktopServices>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileDialog>
+#include <QHash>
 #include <QtConcurrentRun>
 #include <QJsonArray>
-#include <QJsonDocument>
 #include <QMessageBox>
+#include <QRegularExpression>
 #include <QScreen>
 #include <QSettings>
 #include <QTextBrowser>
 #include <QSlider>
+#include <QStatusBar>
+#include <numeric>
 #include <random>
 
 
@@ -44,6 +48,8 @@ gruepr::gruepr(DataOptions &dataOptions, QList<StudentRecord> &students, QWidget
 {
     //Setup the main window
     ui->setupUi(this);
+    rebuildDuplicateCheck();
+    ui->studentTable->setStudents(this->students, this->dataOptions);
     setWindowFlags(Qt::Window | Qt::WindowTitleHint | Qt::WindowCloseButtonHint | Qt::WindowMinMaxButtonsHint);
     setWindowIcon(QIcon(":/icons_new/icon.svg"));
     setWindowTitle(tr("gruepr - Form teams"));
@@ -228,6 +234,7 @@ gruepr::gruepr(DataOptions &dataOptions, QList<StudentRecord> &students, QWidget
     letsDoItButton->setStyleSheet(GETSTARTEDBUTTONSTYLE);
     ui->addStudentPushButton->setStyleSheet(SMALLBUTTONSTYLEINVERTED);
     ui->compareRosterPushButton->setStyleSheet(SMALLBUTTONSTYLEINVERTED);
+    ui->updateSurveyPushButton->setStyleSheet(SMALLBUTTONSTYLEINVERTED);
     ui->dataDisplayTabWidget->setStyleSheet(DATADISPTABSTYLE);
     ui->dataDisplayTabWidget->tabBar()->setStyleSheet(DATADISPBARSTYLE);
     ui->dataDisplayTabWidget->tabBar()->setDrawBase(false);
@@ -245,23 +252,22 @@ gruepr::gruepr(DataOptions &dataOptions, QList<StudentRecord> &students, QWidget
     letsDoItButton->setFont(altFont);
     ui->addStudentPushButton->setFont(altFont);
     ui->compareRosterPushButton->setFont(altFont);
+    ui->updateSurveyPushButton->setFont(altFont);
     ui->dataDisplayTabWidget->setFont(altFont);
 
     teamingOptions = nullptr;
     if(this->dataOptions->dataSource == DataOptions::DataSource::fromPrevWork) {
-        QFile savedFile(this->dataOptions->saveStateFileName, this);
-        if(savedFile.open(QIODeviceBase::ReadOnly | QIODeviceBase::Text)) {
-            const QJsonDocument doc = QJsonDocument::fromJson(savedFile.readAll());
+        SaveStateFile savedFile;
+        if(savedFile.open(this->dataOptions->saveStateFileName)) {
+            teamingOptions = new TeamingOptions(savedFile.section(SaveStateFile::Section::teamingOptions).toObject());
+            const QJsonArray teamsetjsons = savedFile.section(SaveStateFile::Section::teamSets).toArray();
             savedFile.close();
-            QJsonObject content = doc.object();
-            teamingOptions = new TeamingOptions(content["teamingoptions"].toObject());
-            const QJsonArray teamsetjsons = content["teamsets"].toArray();
             TeamsTabItem *teamTab = nullptr;
             for(const auto &teamsetjson : teamsetjsons) {
                 teamTab = new TeamsTabItem(teamsetjson.toObject(), *teamingOptions, this->students, this->dataOptions->sectionNames, letsDoItButton, this);
                 ui->dataDisplayTabWidget->addTab(teamTab, teamTab->tabName);
                 numTeams = int(teams.size());
-                connect(teamTab, &TeamsTabItem::saveState, this, &gruepr::saveState);
+                connectTeamTab(teamTab);
             }
         }
         else {
@@ -280,7 +286,7 @@ gruepr::gruepr(DataOptions &dataOptions, QList<StudentRecord> &students, QWidget
     // initialize the priority order of criteria cards
     initializeCriteriaCardPriorities();
 
-    QList<QPushButton *> buttons = {letsDoItButton, ui->addStudentPushButton, ui->compareRosterPushButton};
+    QList<QPushButton *> buttons = {letsDoItButton, ui->addStudentPushButton, ui->compareRosterPushButton, ui->updateSurveyPushButton};
     for(auto &button : buttons) {
         button->setIconSize(QSize(STD_ICON_SIZE, STD_ICON_SIZE));
     }
@@ -305,21 +311,36 @@ gruepr::gruepr(DataOptions &dataOptions, QList<StudentRecord> &students, QWidget
 
     //connecting the buttons that are always shown
     connect(ui->newDataSourceButton, &QPushButton::clicked, this, &gruepr::restartWithNewData);
+    connect(ui->studentTable, &StudentTableWidget::editStudent, this, &gruepr::editAStudent);
+    connect(ui->studentTable, &StudentTableWidget::removeStudent, this, [this](const long long ID){removeAStudent(ID);});
     connect(ui->addStudentPushButton, &QPushButton::clicked, this, &gruepr::addAStudent);
     connect(ui->compareRosterPushButton, &QPushButton::clicked, this, &gruepr::compareStudentsToRoster);
+    connect(ui->updateSurveyPushButton, &QPushButton::clicked, this, &gruepr::addNewSurveyResponses);
     // connect(ui->URMResponsesButton, &QPushButton::clicked, this, &gruepr::selectURMResponses);
     // connect(ui->teammatesButton, &QPushButton::clicked, this, &gruepr::makeTeammatesRules);
     connect(letsDoItButton, &QPushButton::clicked, this, &gruepr::startOptimization);
 
-    //Connect genetic algorithm progress signals to slots
-    connect(this, &gruepr::generationComplete, this, &gruepr::updateOptimizationProgress, Qt::BlockingQueuedConnection);
+    //Show the genetic algorithm progress by polling the snapshots it publishes
+    progressDisplayTimer.setInterval(PROGRESSDISPLAYINTERVAL);
+    connect(&progressDisplayTimer, &QTimer::timeout, this, &gruepr::updateOptimizationProgress);
     connect(&futureWatcher, &QFutureWatcher<void>::finished, this, &gruepr::optimizationComplete);
+    connect(&saveStateWatcher, &QFutureWatcher<SaveStateResult>::finished, this, &gruepr::saveStateWritten);
     refreshCriteriaLayout();
     saveState();
 }
 
 gruepr::~gruepr()
 {
+    // finish writing any saves still underway or waiting, still on the writer thread; there is nothing left for the GUI to do but wait
+    saveStateWatcher.disconnect();
+    saveStateWatcher.waitForFinished();
+    if(saveStateIsPending) {
+        startSaveStateWrite();
+        saveStateWatcher.waitForFinished();
+        if(saveStateWatcher.result().saved) {
+            updatePrevWorksList();
+        }
+    }
     delete dataOptions;
     delete teamingOptions;
     delete ui;
@@ -459,7 +480,7 @@ void gruepr::addCriteriaCard(CriteriaType criteriaType){
                 teamTabNames << ui->dataDisplayTabWidget->tabText(tab);
             }
             connect(setTeammateRulesButton, &QPushButton::clicked, this, [this, teamTabNames](){
-                auto *win = new TeammatesRulesDialog(students, *dataOptions, *teamingOptions,
+                auto *win = new TeammatesRulesDialog(students, studentNameIndex(), *dataOptions, *teamingOptions,
                                                      ((teamingOptions->sectionType == TeamingOptions::SectionType::allTogether) ||
                                                       (teamingOptions->sectionType == TeamingOptions::SectionType::allSeparately) ||
                                                       (teamingOptions->sectionType == TeamingOptions::SectionType::noSections))? "" : teamingOptions->sectionName,
@@ -470,6 +491,7 @@ void gruepr::addCriteriaCard(CriteriaType criteriaType){
                     for(int index = 0; index < students.size(); index++) {
                         this->students[index] = win->students[index];
                     }
+                    markAllStudentsChanged();
                     teamingOptions->haveAnyRequiredTeammates = win->required_teammatesSpecified;
                     teamingOptions->haveAnyPreventedTeammates = win->prevented_teammatesSpecified;
                     teamingOptions->haveAnyRequestedTeammates = win->requested_teammatesSpecified;
@@ -514,7 +536,7 @@ void gruepr::addCriteriaCard(CriteriaType criteriaType){
                 teamTabNames << ui->dataDisplayTabWidget->tabText(tab);
             }
             connect(setTeammateRulesButton, &QPushButton::clicked, this, [this, teamTabNames](){
-                auto *win = new TeammatesRulesDialog(students, *dataOptions, *teamingOptions,
+                auto *win = new TeammatesRulesDialog(students, studentNameIndex(), *dataOptions, *teamingOptions,
                                                      ((teamingOptions->sectionType == TeamingOptions::SectionType::allTogether) ||
                                                       (teamingOptions->sectionType == TeamingOptions::SectionType::allSeparately) ||
                                                       (teamingOptions->sectionType == TeamingOptions::SectionType::noSections))? "" : teamingOptions->sectionName,
@@ -525,6 +547,7 @@ void gruepr::addCriteriaCard(CriteriaType criteriaType){
                     for(int index = 0; index < students.size(); index++) {
                         this->students[index] = win->students[index];
                     }
+                    markAllStudentsChanged();
                     teamingOptions->haveAnyRequiredTeammates = win->required_teammatesSpecified;
                     teamingOptions->haveAnyPreventedTeammates = win->prevented_teammatesSpecified;
                     teamingOptions->haveAnyRequestedTeammates = win->requested_teammatesSpecified;
@@ -569,7 +592,7 @@ void gruepr::addCriteriaCard(CriteriaType criteriaType){
                 teamTabNames << ui->dataDisplayTabWidget->tabText(tab);
             }
             connect(setTeammateRulesButton, &QPushButton::clicked, this, [this, teamTabNames](){
-                auto *win = new TeammatesRulesDialog(students, *dataOptions, *teamingOptions,
+                auto *win = new TeammatesRulesDialog(students, studentNameIndex(), *dataOptions, *teamingOptions,
                                                      ((teamingOptions->sectionType == TeamingOptions::SectionType::allTogether) ||
                                                       (teamingOptions->sectionType == TeamingOptions::SectionType::allSeparately) ||
                                                       (teamingOptions->sectionType == TeamingOptions::SectionType::noSections))? "" : teamingOptions->sectionName,
@@ -580,6 +603,7 @@ void gruepr::addCriteriaCard(CriteriaType criteriaType){
                     for(int index = 0; index < students.size(); index++) {
                         this->students[index] = win->students[index];
                     }
+                    markAllStudentsChanged();
                     teamingOptions->haveAnyRequiredTeammates = win->required_teammatesSpecified;
                     teamingOptions->haveAnyPreventedTeammates = win->prevented_teammatesSpecified;
                     teamingOptions->haveAnyRequestedTeammates = win->requested_teammatesSpecified;
@@ -847,97 +871,119 @@ void gruepr::addCriteriaCard(CriteriaType criteriaType, int attribute){ //how to
 }
 
 ////////////////////
-// A static public wrapper for the getGenomeScore function used internally
-// The calculated scores are updated into the .scores members of the _teams array sent to the function
+// Static public wrappers for the getGenomeScore function used internally
+// The calculated scores are updated into the .score and .criterionScores members of the teams in the _teams array, and into its net score
+// Either every team is scored, or just those listed in _teamsToScore (e.g., the two teams changed by a swap), since each team's score depends only on its own students
+// When scoring just some teams, _IDsBeingTeamed must be all of the students in the set (for checking teammate rules); the caller keeps it rather than it being rebuilt here
 // This is a static function, and parameters are named with leading underscore to differentiate from gruepr member variables
 ////////////////////
-void gruepr::calcTeamScores(const QList<StudentRecord> &_students, const long long _numStudents,
-                            TeamSet &_teams, const TeamingOptions *const _teamingOptions)
+void gruepr::calcTeamScores(const StudentList &_students, TeamSet &_teams, const TeamingOptions *const _teamingOptions)
 {
-    const int _numTeams = _teams.size();
-    const auto &_dataOptions = _teams.dataOptions;
-    auto *teamScores = new float[_numTeams];
-    auto **criterionScore = new float*[_teamingOptions->realNumScoringFactors];
-    //std::set<int> _criterionBeingScored;
-    for(int criterion = 0; criterion < _teamingOptions->realNumScoringFactors; criterion++) {
-        criterionScore[criterion] = new float[_numTeams];
-        // if((_teamingOptions->realAttributeWeights[attrib] > 0) ||
-        //     (_teamingOptions->haveAnyIncompatibleAttributes[attrib]) ||
-        //     (_teamingOptions->haveAnyRequiredAttributes[attrib])) {
-        //         _attributesBeingScored.insert(attrib);
-        // }
-    }
-    //auto *schedScore = new float[_numTeams];
-    auto **availabilityChart = new bool*[_dataOptions.dayNames.size()];
-    for(int day = 0; day < _dataOptions.dayNames.size(); day++) {
-        availabilityChart[day] = new bool[_dataOptions.timeNames.size()];
+    QList<int> allTeams(_teams.size());
+    std::iota(allTeams.begin(), allTeams.end(), 0);
+    _teams.retallyScores();
+    calcTeamScores(_students, _teams, _teamingOptions, allTeams, nullptr);
+}
+
+
+void gruepr::calcTeamScores(const StudentList &_students, TeamSet &_teams, const TeamingOptions *const _teamingOptions, const QList<int> &_teamsToScore,
+                            const std::set<long long> *_IDsBeingTeamed)
+{
+    QList<QList<long long>> teamsStudentIDs;
+    teamsStudentIDs.reserve(_teamsToScore.size());
+    for(const auto team : _teamsToScore) {
+        teamsStudentIDs << _teams.at(team).studentIDs;
     }
-    // const bool _schedBeingScored = _teamingOptions->realScheduleWeight > 0;
-    // const bool _genderBeingScored = _dataOptions.genderIncluded && (_teamingOptions->isolatedWomenPrevented || _teamingOptions->isolatedMenPrevented ||
-    //                                                                  _teamingOptions->isolatedNonbinaryPrevented || _teamingOptions->singleGenderPrevented);
-    // const bool _URMBeingScored = _dataOptions.URMIncluded && _teamingOptions->isolatedURMPrevented;
-    // const bool _teammatesBeingScored = _teamingOptions->haveAnyRequiredTeammates || _teamingOptions->haveAnyPreventedTeammates || _teamingOptions->haveAnyRequestedTeammates;
-    auto *penaltyPoints = new int[_numTeams];
-    auto *teamSizes = new int[_numTeams];
-    auto *genome = new int[_numStudents];
-    int ID = 0;
-    for(int teamnum = 0; teamnum < _numTeams; teamnum++) {
-        teamSizes[teamnum] = _teams[teamnum].size;
-        for(const auto studentID : qAsConst(_teams[teamnum].studentIDs)) {
-            int index = 0;
-            while(index < _students.size() && _students.at(index).ID != studentID) {
-                index++;
-            }
-            genome[ID] = index;
-            ID++;
+
+    // teammate rules are only checked against the students in this set, so those need to be known when only some teams are scored
+    const bool scoringSomeTeams = (_teamsToScore.size() < _teams.size());
+    const QList<TeamScores> teamScores = scoreTeams(_students, teamsStudentIDs, _teamingOptions, _teams.dataOptions.get(),
+                                                    (scoringSomeTeams? _IDsBeingTeamed : nullptr));
+
+    for(int i = 0; i < _teamsToScore.size(); i++) {
+        const int team = _teamsToScore.at(i);
+        for(int criterion = 0; criterion < _teamingOptions->realNumScoringFactors; criterion++) {
+            _teams[team].criterionScores[criterion] = teamScores.at(i).criterionScores[criterion];
         }
+        _teams.setTeamScore(team, teamScores.at(i).score);
+        _teams[team].invalidateTooltip();
     }
+}
 
-    getGenomeScore(_students.constData(), genome, _numTeams, teamSizes,
-                   _teamingOptions, &_dataOptions, teamScores,
-                   criterionScore, availabilityChart, penaltyPoints);
-                   //_attributesBeingScored, _schedBeingScored, _genderBeingScored, _URMBeingScored, _teammatesBeingScored);
-    // Print `teamSizes`
 
-    for(int criterion = 0; criterion < _teamingOptions->realNumScoringFactors; criterion++){
-        for (int team = 0; team <_numTeams; team++){
-            _teams[team].criterionScores[criterion] = criterionScore[criterion][team];
-            //penalty
-            int penaltyScore = -penaltyPoints[criterion];
-            //unweighted score
-            float actualScore = criterionScore[criterion][team]/_teamingOptions->weights[criterion];
-            //qDebug() << "weight from weights[]:" << _teamingOptions->weights[criterion];
-            //qDebug() << "weight from criterion->weight:" << _teamingOptions->criterionTypes[criterion]->weight;
+////////////////////
+// Score some teams, given as the IDs of the students on each one, without needing them to be in a team set (so they may be hypothetical)
+// If these are only some of the teams in a set, _IDsBeingTeamed must be all of the students in the set, for checking teammate rules
+// The criterion scores returned are unweighted
+////////////////////
+QList<gruepr::TeamScores> gruepr::scoreTeams(const StudentList &_students, const QList<QList<long long>> &_teamsStudentIDs,
+                                             const TeamingOptions *const _teamingOptions, const DataOptions *const _dataOptions,
+                                             const std::set<long long> *_IDsBeingTeamed)
+{
+    const int _numTeams = int(_teamsStudentIDs.size());
+    QList<TeamScores> results(_numTeams);
+    if(_numTeams == 0) {
+        return results;
+    }
 
-            //does not take into account penalty scores yet
-            _teams[team].criterionScores[criterion] = actualScore;
+    QList<int> teamSizes;
+    teamSizes.reserve(_numTeams);
+    QList<int> genome;
+    for(const auto &teamStudentIDs : _teamsStudentIDs) {
+        teamSizes << int(teamStudentIDs.size());
+        for(const auto studentID : teamStudentIDs) {
+            genome << _students.indexOfID(studentID);
+        }
+    }
 
-            // qDebug() << "team:" << team;
-            // qDebug() << "criterion:" << criterion;
-            // qDebug() << "penalty:" << -penaltyPoints[criterion];
-            // qDebug() << "actual score:" << actualScore;
-            // qDebug() << "score:" << criterionScore[criterion][team];
-            // qDebug() << "score final:" << _teams[team].criterionScores[criterion];
+    TeamScorer scorer(_students.constData(), _teamingOptions, _dataOptions, _IDsBeingTeamed, _numTeams);
+    const float *const teamScores = scorer.score(genome.constData(), _numTeams, teamSizes.constData());
 
+    for(int team = 0; team < _numTeams; team++) {
+        results[team].score = teamScores[team];
+        results[team].penaltyPoints = scorer.penaltyPoints(team);
+        for(int criterion = 0; criterion < _teamingOptions->realNumScoringFactors; criterion++) {
+            results[team].criterionScores[criterion] = scorer.criterionScore(criterion, team) / _teamingOptions->weights[criterion];
         }
     }
 
-    for(int teamnum = 0; teamnum < _numTeams; teamnum++) {
-        _teams[teamnum].score = teamScores[teamnum];
-    }
+    return results;
+}
 
-    delete[] genome;
-    delete[] teamSizes;
-    delete[] penaltyPoints;
-    for(int day = 0; day < _dataOptions.dayNames.size(); day++) {
-        delete[] availabilityChart[day];
+
+gruepr::TeamScorer::TeamScorer(const StudentRecord *const _students, const TeamingOptions *const _teamingOptions, const DataOptions *const _dataOptions,
+                               const std::set<long long> *_IDsBeingTeamed, const int _maxNumTeams) :
+    students(_students),
+    teamingOptions(_teamingOptions),
+    dataOptions(_dataOptions),
+    IDsBeingTeamed(_IDsBeingTeamed),
+    maxNumTeams(_maxNumTeams)
+{
+    const int numCriteria = _teamingOptions->realNumScoringFactors;
+    const int numDays = int(_dataOptions->dayNames.size());
+    const int numTimes = int(_dataOptions->timeNames.size());
+
+    teamScores = std::make_unique<float[]>(_maxNumTeams);
+    criterionScoreValues = std::make_unique<float[]>(std::size_t(numCriteria) * _maxNumTeams);
+    criterionScores = std::make_unique<float*[]>(numCriteria);
+    for(int criterion = 0; criterion < numCriteria; criterion++) {
+        criterionScores[criterion] = &criterionScoreValues[std::size_t(criterion) * _maxNumTeams];
     }
-    delete[] availabilityChart;
-    for(int criterion = 0; criterion < _teamingOptions->realNumScoringFactors; criterion++) {
-        delete[] criterionScore[criterion];
+    availabilityValues = std::make_unique<bool[]>(std::size_t(numDays) * numTimes);
+    availabilityChart = std::make_unique<bool*[]>(numDays);
+    for(int day = 0; day < numDays; day++) {
+        availabilityChart[day] = &availabilityValues[std::size_t(day) * numTimes];
     }
-    delete[] criterionScore;
-    delete[] teamScores;
+    teamPenaltyPoints = std::make_unique<int[]>(_maxNumTeams);
+}
+
+
+const float *gruepr::TeamScorer::score(const int _teammates[], const int _numTeams, const int _teamSizes[])
+{
+    Q_ASSERT(_numTeams <= maxNumTeams);
+    getGenomeScore(students, _teammates, _numTeams, _teamSizes, teamingOptions, dataOptions, teamScores.get(),
+                   criterionScores.get(), availabilityChart.get(), teamPenaltyPoints.get(), IDsBeingTeamed);
+    return teamScores.get();
 }
 
 
@@ -956,7 +1002,6 @@ void gruepr::changeSection(int index)
         teamingOptions->sectionName = desiredSection;
         teamingOptions->sectionType = TeamingOptions::SectionType::oneSection;
         refreshStudentDisplay();
-        ui->studentTable->clearSortIndicator();
         teamingOptions->sectionName = prevSection;
 
         numActiveStudents = 0;
@@ -981,7 +1026,6 @@ void gruepr::changeSection(int index)
     }
 
     refreshStudentDisplay();
-    ui->studentTable->clearSortIndicator();
 
     // update the response counts in the attribute tabs
     if (!attributeWidgets.isEmpty()){ //check if user has added any attributes
@@ -995,12 +1039,13 @@ void gruepr::changeSection(int index)
             for(const auto &responseCount : qAsConst(dataOptions->attributeQuestionResponseCounts[attribute])) {
                 currentResponseCounts[responseCount.first] = 0;
             }
+            const InternedString sectionName(teamingOptions->sectionName);
             for(const auto &student : qAsConst(students)) {
                 if(!student.deleted &&
                    ((teamingOptions->sectionType == TeamingOptions::SectionType::allTogether) ||
                     (teamingOptions->sectionType == TeamingOptions::SectionType::noSections) ||
                     ((teamingOptions->sectionType == TeamingOptions::SectionType::allSeparately) && !multipleSectionsInProgress) ||
-                    (student.section == teamingOptions->sectionName))) {
+                    (student.section == sectionName))) {
                     const QString &currentStudentResponse = student.attributeResponse[attribute];
 
                     if(!student.attributeResponse[attribute].isEmpty()) {
@@ -1042,11 +1087,15 @@ void gruepr::editSectionNames()
             mapOfOldToNewSectionNames[dataOptions->sectionNames.at(i)] = window->sectionNames.at(i);
         }
         //replace section names for each student
-        for(auto &student : students) {
-            student.section = mapOfOldToNewSectionNames[student.section];
+        for(int index = 0; index < students.size(); index++) {
+            const QString &newSectionName = mapOfOldToNewSectionNames[students.at(index).section];
+            if(students.at(index).section.toString() != newSectionName) {
+                students[index].section = newSectionName;
+                markStudentChanged(index);
+            }
         }
         //replace section names in section selection box and dataOptions
-        rebuildDuplicatesTeamsizeURMAndSectionDataAndRefreshStudentTable();
+        rebuildTeamsizeURMAndSectionDataAndRefreshStudentTable();
 
         saveState();
     }
@@ -1055,43 +1104,16 @@ void gruepr::editSectionNames()
 }
 
 
-inline StudentRecord* gruepr::findStudentFromID(const long long ID)
-{
-    for(auto &student : students) {
-        if(student.ID == ID) {
-            return &student;
-        }
-    }
-    return nullptr;
-}
-
-
-void gruepr::editAStudent()
+void gruepr::editAStudent(const long long ID)
 {
-    // first, find the student, using the ID property of this edit button
-    StudentRecord *studentBeingEdited = findStudentFromID(sender()->property("StudentID").toInt());
+    StudentRecord *studentBeingEdited = students.findByID(ID);
     if(studentBeingEdited == nullptr) {
         // student not found, somehow
         return;
     }
 
     // remove this student's current attribute responses from the counts in dataOptions
-    for(int attribute = 0; attribute < dataOptions->numAttributes; attribute++) {
-        const QString &currentStudentResponse = studentBeingEdited->attributeResponse[attribute];
-        if(!currentStudentResponse.isEmpty()) {
-            if((dataOptions->attributeType[attribute] == DataOptions::AttributeType::multicategorical) ||
-                (dataOptions->attributeType[attribute] == DataOptions::AttributeType::multiordered)) {
-                //need to process each one
-                const QStringList setOfResponsesFromStudent = currentStudentResponse.split(',', Qt::SkipEmptyParts);
-                for(const auto &responseFromStudent : qAsConst(setOfResponsesFromStudent)) {
-                    dataOptions->attributeQuestionResponseCounts[attribute][responseFromStudent.trimmed()]--;
-                }
-            }
-            else {
-                dataOptions->attributeQuestionResponseCounts[attribute][currentStudentResponse]--;
-            }
-        }
-    }
+    tallyAttributeResponses(*studentBeingEdited, -1);
 
     //Open window with the student record in it
     auto *win = new editOrAddStudentDialog(*studentBeingEdited, dataOptions, this, false);
@@ -1099,28 +1121,17 @@ void gruepr::editAStudent()
     //If user clicks OK, replace student in the database with edited copy
     const int reply = win->exec();
     if(reply == QDialog::Accepted) {
-        studentBeingEdited->createTooltip(*dataOptions);
+        studentBeingEdited->invalidateTooltip();
         studentBeingEdited->URM = teamingOptions->URMResponsesConsideredUR.contains(studentBeingEdited->URMResponse);
+        markStudentChanged(students.indexOfID(ID));
 
-        rebuildDuplicatesTeamsizeURMAndSectionDataAndRefreshStudentTable();
+        rebuildTeamsizeURMAndSectionDataAndRefreshStudentTable();
     }
 
     // add back in this student's attribute responses from the counts in dataOptions and update the attribute tabs to show the counts
+    tallyAttributeResponses(*studentBeingEdited, 1);
+    markDataOptionsChanged();
     for(int attribute = 0; attribute < dataOptions->numAttributes; attribute++) {
-        const QString &currentStudentResponse = studentBeingEdited->attributeResponse[attribute];
-        if(!currentStudentResponse.isEmpty()) {
-            if((dataOptions->attributeType[attribute] == DataOptions::AttributeType::multicategorical) ||
-                (dataOptions->attributeType[attribute] == DataOptions::AttributeType::multiordered)) {
-                //need to process each one
-                const QStringList setOfResponsesFromStudent = currentStudentResponse.split(',', Qt::SkipEmptyParts);
-                for(const auto &responseFromStudent : qAsConst(setOfResponsesFromStudent)) {
-                    dataOptions->attributeQuestionResponseCounts[attribute][responseFromStudent.trimmed()]++;
-                }
-            }
-            else {
-                dataOptions->attributeQuestionResponseCounts[attribute][currentStudentResponse]++;
-            }            
-        }
         attributeWidgets[attribute]->setValues(attribute, dataOptions, teamingOptions);
     }
 
@@ -1129,28 +1140,9 @@ void gruepr::editAStudent()
 }
 
 
-void gruepr::removeAStudent(const QString &name)
-{
-    if(!name.isEmpty()) {
-        // use the name to find the ID
-        long long ID = -1;
-        // don't have index, need to search and locate based on name
-        for(const auto &student : qAsConst(students)) {
-            if(name.compare((student.firstname + " " + student.lastname), Qt::CaseInsensitive) == 0) {
-                ID = student.ID;
-                break;
-            }
-        }
-        if(ID != -1) {
-            removeAStudent(ID, true);
-        }
-    }
-}
-
-
 void gruepr::removeAStudent(const long long ID, const bool delayVisualUpdate)
 {
-    StudentRecord *studentBeingRemoved = findStudentFromID(ID);
+    StudentRecord *studentBeingRemoved = students.findByID(ID);
     if(studentBeingRemoved == nullptr) {
         // student not found, somehow
         return;
@@ -1158,40 +1150,32 @@ void gruepr::removeAStudent(const long long ID, const bool delayVisualUpdate)
 
     if(teamingOptions->haveAnyRequiredTeammates || teamingOptions->haveAnyRequestedTeammates) {
         // remove this student from all other students who might have them as required/prevented/requested
-        for(auto &student : students) {
-            student.requiredWith.remove(ID);
-            student.preventedWith.remove(ID);
-            student.requestedWith.remove(ID);
+        for(int index = 0; index < students.size(); index++) {
+            const StudentRecord &student = students.at(index);
+            if(student.requiredWith.contains(ID) || student.preventedWith.contains(ID) || student.requestedWith.contains(ID)) {
+                students[index].requiredWith.remove(ID);
+                students[index].preventedWith.remove(ID);
+                students[index].requestedWith.remove(ID);
+                markStudentChanged(index);
+            }
         }
     }
 
     // update in dataOptions and then the attribute tab the count of each attribute response
+    tallyAttributeResponses(*studentBeingRemoved, -1);
     for(int attribute = 0; attribute < dataOptions->numAttributes; attribute++) {
-        const QString &currentStudentResponse = studentBeingRemoved->attributeResponse[attribute];
-        if(!currentStudentResponse.isEmpty()) {
-            if((dataOptions->attributeType[attribute] == DataOptions::AttributeType::multicategorical) ||
-                (dataOptions->attributeType[attribute] == DataOptions::AttributeType::multiordered)) {
-                //need to process each one
-                const QStringList setOfResponsesFromStudent = currentStudentResponse.split(',', Qt::SkipEmptyParts);
-                for(const auto &responseFromStudent : qAsConst(setOfResponsesFromStudent)) {
-                    dataOptions->attributeQuestionResponseCounts[attribute][responseFromStudent.trimmed()]--;
-                }
-            }
-            else {
-                dataOptions->attributeQuestionResponseCounts[attribute][currentStudentResponse]--;
-            }
-        }
         attributeWidgets[attribute]->setValues(attribute, dataOptions, teamingOptions);
     }
 
     //Remove the student
     studentBeingRemoved->deleted = true;
+    markStudentChanged(students.indexOfID(ID));
 
     if(delayVisualUpdate) {
         return;
     }
 
-    rebuildDuplicatesTeamsizeURMAndSectionDataAndRefreshStudentTable();
+    rebuildTeamsizeURMAndSectionDataAndRefreshStudentTable();
     saveState();
 }
 
@@ -1207,31 +1191,18 @@ void gruepr::addAStudent()
         const int reply = win->exec();
         if(reply == QDialog::Accepted) {
             newStudent.ID = students.size();
-            newStudent.createTooltip(*dataOptions);
+            newStudent.invalidateTooltip();
             newStudent.URM = teamingOptions->URMResponsesConsideredUR.contains(newStudent.URMResponse);
-            newStudent.ambiguousSchedule = (newStudent.availabilityChart.count("√") == 0 ||
-                                           (newStudent.availabilityChart.count("√") == (dataOptions->dayNames.size() * dataOptions->timeNames.size())));
+            newStudent.refreshAmbiguousSchedule(int(dataOptions->dayNames.size()), int(dataOptions->timeNames.size()));
             students << newStudent;
+            markStudentChanged(int(students.size()) - 1);
 
             // update in dataOptions and then the attribute tab the count of each attribute response
+            tallyAttributeResponses(newStudent, 1);
             for(int attribute = 0; attribute < dataOptions->numAttributes; attribute++) {
-                const QString &currentStudentResponse = newStudent.attributeResponse[attribute];
-                if(!currentStudentResponse.isEmpty()) {
-                    if((dataOptions->attributeType[attribute] == DataOptions::AttributeType::multicategorical) ||
-                        (dataOptions->attributeType[attribute] == DataOptions::AttributeType::multiordered)) {
-                        //need to process each one
-                        const QStringList setOfResponsesFromStudent = currentStudentResponse.split(',', Qt::SkipEmptyParts);
-                        for(const auto &responseFromStudent : qAsConst(setOfResponsesFromStudent)) {
-                            dataOptions->attributeQuestionResponseCounts[attribute][responseFromStudent.trimmed()]++;
-                        }
-                    }
-                    else {
-                        dataOptions->attributeQuestionResponseCounts[attribute][currentStudentResponse]++;
-                    }
-                }
                 attributeWidgets[attribute]->setValues(attribute, dataOptions, teamingOptions);
             }
-            rebuildDuplicatesTeamsizeURMAndSectionDataAndRefreshStudentTable();
+            rebuildTeamsizeURMAndSectionDataAndRefreshStudentTable();
         }
         delete win;
     }
@@ -1257,47 +1228,46 @@ void gruepr::compareStudentsToRoster()
     if(loadRosterData(rosterFile, names, emails)) {
         bool dataHasChanged = false;
 
-        // load all current names from the survey so we can later remove them as they're found in the roster and be left with problem cases
-        QStringList namesNotFound;
-        namesNotFound.reserve(students.size());
-        for(const auto &student : qAsConst(students)) {
-            namesNotFound << student.firstname + " " + student.lastname;
-        }
+        // the index of survey names and email addresses, so each roster entry is found with a single lookup (first student wins if duplicated)
+        const std::shared_ptr<const StudentNameIndex> surveyIndex = studentNameIndex();
+        QSet<QString> namesFound;           // survey names (as they are after reconciliation) found in or added from the roster; students with any other name are the problem cases
 
-        // create a place to save info for names with mismatched emails
-        QList<StudentRecord*> studentsWithDiffEmail;
+        // create a place to save info for names with mismatched emails: <ID, roster email>
+        QList<QPair<long long, QString>> studentsWithDiffEmail;
         studentsWithDiffEmail.reserve(students.size());
 
-        for(auto &name : names) {
-            // first try to find student in the existing students data
-            // start at first student in database and look until we find a matching firstname + " " +last name
-            StudentRecord *stu = nullptr;
-            for(auto &student : students) {
-                if(name.compare(student.firstname + " " + student.lastname, Qt::CaseInsensitive) == 0) {
-                    stu = &student;
-                    break;
-                }
-            }
-
-            // get the email corresponding to this name on the roster
-            const auto index = names.indexOf(name);
-            const QString &rosterEmail = ((index >= 0 && index < emails.size())? emails.at(index) : "");
+        // resolve all of the exact matches, and collect the names not in the survey to resolve together
+        QList<RosterReconciliationDialog::RosterEntry> unmatchedRosterEntries;
+        for(int index = 0; index < names.size(); index++) {
+            const QString &name = names.at(index);
+            const QString &rosterEmail = ((index < emails.size())? emails.at(index) : "");
 
-            if(stu != nullptr) {
+            const long long match = surveyIndex->findName(name);
+            if(match != -1) {
                 // Exact match for name was found in existing students
-                namesNotFound.removeAll(stu->firstname + " " + stu->lastname);
+                namesFound << StudentNameIndex::normalized(name);
                 if(!emails.isEmpty()) {
+                    const StudentRecord *const stu = students.findByID(match);
                     if(stu->email.compare(rosterEmail, Qt::CaseInsensitive) != 0) {
                         // Email in survey doesn't match roster
-                        studentsWithDiffEmail << stu;
+                        studentsWithDiffEmail.append({stu->ID, rosterEmail});
                     }
                 }
             }
             else {
-                // No exact match, so list possible matches sorted by Levenshtein distance and allow user to pick a match, add as a new student, or ignore
-                auto *choiceWindow = new findMatchingNameDialog(students, name, this, "", true, emails.isEmpty()? "" : rosterEmail);
-                if(choiceWindow->exec() == QDialog::Accepted) {  // not ignoring this student
-                    if(choiceWindow->addStudent) {   // add as a new student
+                unmatchedRosterEntries.append({name, emails.isEmpty()? "" : rosterEmail});
+            }
+        }
+
+        // No exact match for these, so list possible matches for all of them and allow user to pick a match, add as a new student, or ignore each
+        if(!unmatchedRosterEntries.isEmpty()) {
+            auto *reconciliationWindow = new RosterReconciliationDialog(students, *surveyIndex, unmatchedRosterEntries, this);
+            if(reconciliationWindow->exec() == QDialog::Accepted) {
+                for(int entry = 0; entry < unmatchedRosterEntries.size(); entry++) {
+                    const QString &name = unmatchedRosterEntries.at(entry).name;
+                    const QString &rosterEmail = unmatchedRosterEntries.at(entry).email;
+                    const RosterReconciliationDialog::Resolution &resolution = reconciliationWindow->resolutions.at(entry);
+                    if(resolution.action == RosterReconciliationDialog::Action::addStudent) {   // add as a new student
                         dataHasChanged = true;
 
                         StudentRecord newStudent;
@@ -1305,45 +1275,51 @@ void gruepr::compareStudentsToRoster()
                         newStudent.ID = students.size();
                         newStudent.firstname = name.split(" ").first();
                         newStudent.lastname = name.split(" ").mid(1).join(" ");
-                        if(!emails.isEmpty()) {
-                            newStudent.email = rosterEmail;
-                        }
+                        newStudent.email = rosterEmail;
                         newStudent.URM = teamingOptions->URMResponsesConsideredUR.contains(newStudent.URMResponse);
                         for(int attribute = 0; attribute < dataOptions->numAttributes; attribute++) {
                             newStudent.attributeVals[attribute] << -1;
                         }
                         newStudent.ambiguousSchedule = true;
-                        newStudent.createTooltip(*dataOptions);
+                        newStudent.invalidateTooltip();
 
                         students << newStudent;
+                        markStudentChanged(int(students.size()) - 1);
+                        namesFound << StudentNameIndex::normalized(newStudent.firstname + " " + newStudent.lastname);
 
                         numActiveStudents = students.size();
                     }
-                    else {  // selected an inexact match
-                        const QString surveyName = choiceWindow->currSurveyName;
-                        namesNotFound.removeAll(surveyName);
-                        for(auto &student : students) {
-                            if(surveyName != (student.firstname + " " + student.lastname)) {
-                                stu = &student;
-                                break;
-                            }
-                        }
+                    else if(resolution.action == RosterReconciliationDialog::Action::mergeWithStudent) {  // selected an inexact match
+                        StudentRecord *stu = students.findByID(resolution.studentID);
                         if(stu != nullptr) {
-                            if(choiceWindow->useRosterEmail) {
+                            if(resolution.useRosterEmail) {
                                 dataHasChanged = true;
-                                stu->email = emails.isEmpty()? "" : rosterEmail;
-                                stu->createTooltip(*dataOptions);
+                                stu->email = rosterEmail;
+                                stu->invalidateTooltip();
                             }
-                            if(choiceWindow->useRosterName) {
+                            if(resolution.useRosterName) {
                                 dataHasChanged = true;
                                 stu->firstname = name.split(" ").first();
                                 stu->lastname = name.split(" ").mid(1).join(" ");
-                                stu->createTooltip(*dataOptions);
+                                stu->invalidateTooltip();
+                            }
+                            if(resolution.useRosterEmail || resolution.useRosterName) {
+                                markStudentChanged(students.indexOfID(resolution.studentID));
                             }
+                            namesFound << StudentNameIndex::normalized(stu->firstname + " " + stu->lastname);     // the name as it is after the merge
                         }
                     }
                 }
-                delete choiceWindow;
+            }
+            delete reconciliationWindow;
+        }
+
+        // the students in the survey that were not found in the roster: <ID, name>
+        QList<QPair<long long, QString>> studentsNotFound;
+        for(const auto &student : qAsConst(students)) {
+            const QString surveyName = student.firstname + " " + student.lastname;
+            if(!student.deleted && !namesFound.contains(StudentNameIndex::normalized(surveyName))) {
+                studentsNotFound.append({student.ID, surveyName});
             }
         }
 
@@ -1352,7 +1328,9 @@ void gruepr::compareStudentsToRoster()
 
         if(!emails.isEmpty()) {
             // Now handle the times where the roster and survey have different email addresses
-            for(auto &student : studentsWithDiffEmail) {
+            for(const auto &studentWithDiffEmail : qAsConst(studentsWithDiffEmail)) {
+                StudentRecord *const student = students.findByID(studentWithDiffEmail.first);
+                const QString &rosterEmail = studentWithDiffEmail.second;
                 const QString surveyName = student->firstname + " " + student->lastname;
                 const QString surveyEmail = student->email;
                 if(keepAsking) {
@@ -1362,7 +1340,7 @@ void gruepr::compareStudentsToRoster()
                                                                  tr("has a different email address in the survey.") + "<br><br>" +
                                                                  tr("Select one of the following email addresses:") + "<br>" +
                                                                  tr("Survey: ") + "<b>" + surveyEmail + "</b><br>" +
-                                                                 tr("Roster: ") + "<b>" +  emails.at(names.indexOf(surveyName))  + "</b><br>",
+                                                                 tr("Roster: ") + "<b>" + rosterEmail + "</b><br>",
                                                              QMessageBox::Ok | QMessageBox::Cancel, this);
                     whichEmailWindow->setIconPixmap(QPixmap(":/icons_new/question.png").scaled(MSGBOX_ICON_SIZE, MSGBOX_ICON_SIZE,
                                                                                                Qt::KeepAspectRatio, Qt::SmoothTransformation));
@@ -1381,8 +1359,9 @@ void gruepr::compareStudentsToRoster()
                     if(whichEmailWindow->exec() == QDialog::Rejected) {
                         dataHasChanged = true;
                         makeTheChange = true;
-                        student->email = emails.at(names.indexOf(surveyName));
-                        student->createTooltip(*dataOptions);
+                        student->email = rosterEmail;
+                        student->invalidateTooltip();
+                        markStudentChanged(students.indexOfID(student->ID));
                     }
                     else {
                         makeTheChange = false;
@@ -1390,8 +1369,9 @@ void gruepr::compareStudentsToRoster()
                     delete whichEmailWindow;
                 }
                 else if(makeTheChange) {
-                    student->email = emails.at(names.indexOf(surveyName));
-                    student->createTooltip(*dataOptions);
+                    student->email = rosterEmail;
+                    student->invalidateTooltip();
+                    markStudentChanged(students.indexOfID(student->ID));
                 }
                 i++;
             }
@@ -1400,7 +1380,8 @@ void gruepr::compareStudentsToRoster()
         // Finally, handle the names on the survey that were not found in the roster
         keepAsking = true, makeTheChange = false;
         i = 0;
-        for(auto &name : namesNotFound) {
+        for(const auto &studentNotFound : qAsConst(studentsNotFound)) {
+            const QString &name = studentNotFound.second;
             if(keepAsking) {
                 auto *keepOrDeleteWindow = new QMessageBox(QMessageBox::Question, tr("Student not in roster file"),
                                                            tr("This student:") +
@@ -1413,7 +1394,7 @@ void gruepr::compareStudentsToRoster()
                 keepOrDeleteWindow->setStyleSheet(LABEL10PTSTYLE);
                 keepOrDeleteWindow->button(QMessageBox::Ok)->setStyleSheet(SMALLBUTTONSTYLE);
                 keepOrDeleteWindow->button(QMessageBox::Cancel)->setStyleSheet(SMALLBUTTONSTYLEINVERTED);
-                auto *applyToAll = new QCheckBox(tr("Apply to all remaining (") + QString::number(namesNotFound.size() - i) + tr(" students)"), keepOrDeleteWindow);
+                auto *applyToAll = new QCheckBox(tr("Apply to all remaining (") + QString::number(studentsNotFound.size() - i) + tr(" students)"), keepOrDeleteWindow);
                 applyToAll->setStyleSheet(CHECKBOXSTYLE);
                 keepOrDeleteWindow->setCheckBox(applyToAll);
                 connect(applyToAll, &QCheckBox::clicked, keepOrDeleteWindow, [&keepAsking] (bool checked) {keepAsking = !checked;});
@@ -1425,7 +1406,7 @@ void gruepr::compareStudentsToRoster()
                 if(keepOrDeleteWindow->exec() == QMessageBox::Rejected) {
                     dataHasChanged = true;
                     makeTheChange = true;
-                    removeAStudent(name);
+                    removeAStudent(studentNotFound.first, true);
                 }
                 else {
                     makeTheChange = false;
@@ -1434,13 +1415,13 @@ void gruepr::compareStudentsToRoster()
                 delete keepOrDeleteWindow;
             }
             else if(makeTheChange) {
-                removeAStudent(name);
+                removeAStudent(studentNotFound.first, true);
             }
             i++;
         }
 
         if(dataHasChanged) {
-            rebuildDuplicatesTeamsizeURMAndSectionDataAndRefreshStudentTable();
+            rebuildTeamsizeURMAndSectionDataAndRefreshStudentTable();
             saveState();
         }
     }
@@ -1448,24 +1429,235 @@ void gruepr::compareStudentsToRoster()
 }
 
 
-void gruepr::rebuildDuplicatesTeamsizeURMAndSectionDataAndRefreshStudentTable()
+void gruepr::addNewSurveyResponses()
 {
-    // go back through all records to see if any are duplicates; assume each isn't and then check
+    // Open the updated download of the survey
+    const QSettings savedSettings;
+    CsvFile surveyFile(CsvFile::Delimiter::comma, this);
+    if(!surveyFile.open(this, CsvFile::Operation::read, tr("Open Updated Survey File"), savedSettings.value("saveFileLocation").toString(), tr("Survey Data"))) {
+        return;
+    }
+
+    // The field meanings chosen when the survey was first loaded are re-used, so the columns must not have changed
+    bool sameQuestions = surveyFile.readHeader();
+    for(int attribute = 0; sameQuestions && (attribute < dataOptions->numAttributes); attribute++) {
+        const int field = dataOptions->attributeField[attribute];
+        sameQuestions = (field >= 0) && (field < surveyFile.numFields) && (attribute < dataOptions->attributeQuestionText.size()) &&
+                        (surveyFile.headerValues.at(field) == dataOptions->attributeQuestionText.at(attribute));
+    }
+    const QList<int> singleFields = {dataOptions->timestampField, dataOptions->LMSIDField, dataOptions->emailField, dataOptions->firstNameField,
+                                     dataOptions->lastNameField, dataOptions->genderField, dataOptions->URMField, dataOptions->sectionField};
+    for(const auto field : singleFields) {
+        sameQuestions = sameQuestions && (field < surveyFile.numFields);
+    }
+    if(!sameQuestions) {
+        grueprGlobal::errorMessage(this, tr("File error."), tr("This file does not have the same questions as the survey that is currently loaded."));
+        surveyFile.close();
+        return;
+    }
+
+    // Fingerprint each submission already loaded (including those that were removed, so they are not brought back)
+    // Students loaded in a session saved before the fingerprint was kept can only be recognized by timestamp and email (or just email if no timestamps)
+    const bool haveTimestamps = (dataOptions->timestampField != DataOptions::FIELDNOTPRESENT);
+    QSet<QString> loadedSubmissions, legacyLoadedSubmissions;
+    loadedSubmissions.reserve(students.size());
+    QHash<QString, int> studentIndexFromEmail;
+    studentIndexFromEmail.reserve(students.size());
     for(int index = 0; index < students.size(); index++) {
-        auto &student1 = students[index];
-        student1.duplicateRecord = false;
-        for(int index2 = 0; index2 < index; index2++) {
-            auto &student2 = students[index2];
-            if(!student1.deleted && !student2.deleted &&
-               (((student1.firstname + student1.lastname == student2.firstname + student2.lastname) && !((student1.firstname + student1.lastname).isEmpty())) ||
-                ((student1.email == student2.email) && !student1.email.isEmpty()))) {
-                student1.duplicateRecord = true;
-                student2.duplicateRecord = true;
-                student2.createTooltip(*dataOptions);
+        const auto &student = students.at(index);
+        if(!student.submission.isEmpty()) {
+            loadedSubmissions << student.submission;
+        }
+        else {
+            legacyLoadedSubmissions << StudentRecord::legacySubmissionFingerprint(haveTimestamps? student.surveyTimestamp : QDateTime(), student.email);
+        }
+        if(!student.email.isEmpty()) {
+            // if the same email is used by a removed and a current student, the current one is the one to update
+            const QString emailKey = student.email.trimmed().toLower();
+            const auto existingStudent = studentIndexFromEmail.constFind(emailKey);
+            if((existingStudent == studentIndexFromEmail.constEnd()) || students.at(existingStudent.value()).deleted) {
+                studentIndexFromEmail.insert(emailKey, index);
+            }
+        }
+    }
+
+    // Parse only the rows not already loaded; a new submission from an already-loaded email address is a resubmission from that student,
+    // unless that student was removed, in which case it is skipped
+    int numNewStudents = 0, numUpdatedStudents = 0;
+    QList<std::pair<int, StudentRecord>> resubmissions;
+    bool reachedMaxStudents = false;
+    while(surveyFile.readDataRow()) {
+        const QStringList &fields = surveyFile.fieldValues;
+        const QString submission = StudentRecord::submissionFingerprint(fields);
+        if(loadedSubmissions.contains(submission)) {
+            continue;
+        }
+        if(!legacyLoadedSubmissions.isEmpty()) {
+            const int numFields = int(fields.size());
+            const int timestampField = dataOptions->timestampField, emailField = dataOptions->emailField;
+            const QDateTime timestamp = (haveTimestamps && (timestampField < numFields))? StudentRecord::parseTimestamp(fields.at(timestampField)) : QDateTime();
+            const QString email = ((emailField >= 0) && (emailField < numFields))? fields.at(emailField) : "";
+            if(legacyLoadedSubmissions.contains(StudentRecord::legacySubmissionFingerprint(timestamp, email))) {
+                continue;
+            }
+        }
+        loadedSubmissions << submission;
+
+        StudentRecord newRecord;
+        newRecord.parseRecordFromStringList(fields, *dataOptions);
+
+        const auto existingStudent = studentIndexFromEmail.constFind(newRecord.email.toLower());
+        if(!newRecord.email.isEmpty() && (existingStudent != studentIndexFromEmail.constEnd())) {
+            if(!students.at(existingStudent.value()).deleted) {
+                resubmissions.append({existingStudent.value(), newRecord});
+            }
+            continue;
+        }
+
+        if(students.size() >= MAX_STUDENTS) {
+            reachedMaxStudents = true;
+            break;
+        }
+        newRecord.URM = teamingOptions->URMResponsesConsideredUR.contains(newRecord.URMResponse);
+        setAttributeValsFromResponses(newRecord);
+        newRecord.ID = students.size();
+        if(!newRecord.email.isEmpty()) {
+            studentIndexFromEmail.insert(newRecord.email.toLower(), int(students.size()));
+        }
+        tallyAttributeResponses(newRecord, 1);
+        students << newRecord;
+        markStudentChanged(int(students.size()) - 1);
+        numNewStudents++;
+    }
+    surveyFile.close();
+
+    if(reachedMaxStudents) {
+        grueprGlobal::errorMessage(this, tr("Reached maximum number of students."),
+                                   tr("The maximum number of students have been read."
+                                      " This version of gruepr does not allow more than ") + QString::number(MAX_STUDENTS) + ".");
+    }
+
+    // A resubmission replaces everything the student entered in the survey, so any edits made to those students would be lost--ask first
+    if(!resubmissions.isEmpty() &&
+        grueprGlobal::warningMessage(this, tr("Updated responses"),
+                                     QString::number(resubmissions.size()) + (resubmissions.size() == 1? tr(" student has") : tr(" students have")) +
+                                     tr(" a newer submission in this file. Replacing their survey responses with the newer ones "
+                                        "will also undo any changes you have made to those students' names, section, or responses."),
+                                     tr("Use the newer responses"), tr("Keep the current responses"))) {
+        for(auto &[index, newRecord] : resubmissions) {
+            // keep the student's ID, any teammate rules, and notes, but otherwise use the new submission
+            StudentRecord &student = students[index];
+            tallyAttributeResponses(student, -1);
+            newRecord.URM = teamingOptions->URMResponsesConsideredUR.contains(newRecord.URMResponse);
+            setAttributeValsFromResponses(newRecord);
+            newRecord.ID = student.ID;
+            if(newRecord.LMSID == -1) {
+                newRecord.LMSID = student.LMSID;
+            }
+            if(newRecord.notes.isEmpty()) {
+                newRecord.notes = student.notes;
+            }
+            newRecord.preventedWith = student.preventedWith;
+            newRecord.requiredWith = student.requiredWith;
+            newRecord.requestedWith = student.requestedWith;
+            student = newRecord;
+            tallyAttributeResponses(student, 1);
+            markStudentChanged(index);
+            numUpdatedStudents++;
+        }
+    }
+
+    if((numNewStudents == 0) && (numUpdatedStudents == 0)) {
+        if(resubmissions.isEmpty()) {
+            grueprGlobal::errorMessage(this, tr("No new responses"), tr("All of the responses in this file have already been loaded."));
+        }
+        return;
+    }
+
+    for(int attribute = 0; attribute < dataOptions->numAttributes; attribute++) {
+        attributeWidgets[attribute]->setValues(attribute, dataOptions, teamingOptions);
+    }
+    rebuildTeamsizeURMAndSectionDataAndRefreshStudentTable();
+    saveState();
+
+    grueprGlobal::errorMessage(this, tr("Survey updated"),
+                               QString::number(numNewStudents) + (numNewStudents == 1? tr(" new response was") : tr(" new responses were")) + tr(" added and ") +
+                               QString::number(numUpdatedStudents) + (numUpdatedStudents == 1? tr(" student was") : tr(" students were")) +
+                               tr(" updated with a newer response."));
+}
+
+
+//////////////////
+// Set the numerical values of a newly parsed student's attribute responses, adding any response not seen before to the list of responses
+// (the caller marks dataOptions as changed once all of the students have been processed)
+//////////////////
+void gruepr::setAttributeValsFromResponses(StudentRecord &student)
+{
+    static const QRegularExpression startsWithInteger(R"(^(\d++)([\.\,]?$|[\.\,]\D|[^\.\,]))");
+    for(int attribute = 0; attribute < dataOptions->numAttributes; attribute++) {
+        const auto attributeType = dataOptions->attributeType[attribute];
+        auto &responses = dataOptions->attributeQuestionResponses[attribute];
+        AttributeValues &studentAttributeVals = student.attributeVals[attribute];
+        studentAttributeVals.clear();
+
+        const QString &studentResponse = student.attributeResponse[attribute];
+        if(studentResponse.isEmpty()) {
+            studentAttributeVals << -1;
+            continue;
+        }
+
+        QStringList responsesFromStudent = {studentResponse};
+        if((attributeType == DataOptions::AttributeType::multicategorical) || (attributeType == DataOptions::AttributeType::multiordered)) {
+            responsesFromStudent = studentResponse.split(',', Qt::SkipEmptyParts);
+        }
+        for(auto &response : responsesFromStudent) {
+            response = response.trimmed();
+            if(!responses.contains(response)) {
+                responses << response;
+                dataOptions->attributeQuestionResponseCounts[attribute].insert({response, 0});
+            }
+            int value;
+            if((attributeType == DataOptions::AttributeType::ordered) || (attributeType == DataOptions::AttributeType::multiordered)) {
+                value = startsWithInteger.match(response).captured(1).toInt();
+            }
+            else {
+                value = int(responses.indexOf(response)) + 1;
             }
+            dataOptions->attributeVals[attribute].insert(value);
+            studentAttributeVals << value;
         }
-        student1.createTooltip(*dataOptions);
     }
+}
+
+
+//////////////////
+// Add (change = 1) or remove (change = -1) a student's attribute responses from the tallies in dataOptions
+// (the caller marks dataOptions as changed once all of the students have been processed)
+//////////////////
+void gruepr::tallyAttributeResponses(const StudentRecord &student, const int change)
+{
+    for(int attribute = 0; attribute < dataOptions->numAttributes; attribute++) {
+        const QString &currentStudentResponse = student.attributeResponse[attribute];
+        if(!currentStudentResponse.isEmpty()) {
+            if((dataOptions->attributeType[attribute] == DataOptions::AttributeType::multicategorical) ||
+                (dataOptions->attributeType[attribute] == DataOptions::AttributeType::multiordered)) {
+                //need to process each one
+                const QStringList setOfResponsesFromStudent = currentStudentResponse.split(',', Qt::SkipEmptyParts);
+                for(const auto &responseFromStudent : qAsConst(setOfResponsesFromStudent)) {
+                    dataOptions->attributeQuestionResponseCounts[attribute][responseFromStudent.trimmed()] += change;
+                }
+            }
+            else {
+                dataOptions->attributeQuestionResponseCounts[attribute][currentStudentResponse] += change;
+            }
+        }
+    }
+}
+
+
+void gruepr::rebuildTeamsizeURMAndSectionDataAndRefreshStudentTable()
+{
+    markDataOptionsChanged();
 
     // Re-build the URM info
     if(dataOptions->URMIncluded) {
@@ -1518,13 +1710,105 @@ void gruepr::rebuildDuplicatesTeamsizeURMAndSectionDataAndRefreshStudentTable()
 
     // Refresh student table data
     refreshStudentDisplay();
-    ui->studentTable->clearSortIndicator();
 
     // Load new team sizes in selection box
     idealTeamSizeBox->setMaximum(std::max(2ll,numActiveStudents/2));
     changeIdealTeamSize();
 }
 
+//////////////////
+// List every non-deleted student under their name and email address, and flag the ones that share either with another student
+//////////////////
+void gruepr::rebuildDuplicateCheck()
+{
+    duplicateCheckKeys.clear();
+    studentsWithName.clear();
+    studentsWithEmail.clear();
+    nameIndex.reset();
+    for(int index = 0; index < students.size(); index++) {
+        updateDuplicateCheck(index);
+    }
+}
+
+
+//////////////////
+// Re-list a student whose name, email address, or deleted status may have changed, and update the duplicate flags of everyone affected
+//////////////////
+void gruepr::updateDuplicateCheck(const int index)
+{
+    if((index < 0) || (index >= students.size())) {
+        return;
+    }
+    if(duplicateCheckKeys.size() < students.size()) {
+        duplicateCheckKeys.resize(students.size());
+    }
+
+    const StudentRecord &student = students.at(index);
+    DuplicateCheckKeys newKeys;
+    if(!student.deleted) {
+        newKeys = {StudentNameIndex::normalized(student.firstname + " " + student.lastname), StudentNameIndex::normalized(student.email)};
+    }
+    const DuplicateCheckKeys oldKeys = duplicateCheckKeys.at(index);
+    duplicateCheckKeys[index] = newKeys;
+
+    // the students listed under the old and new keys are only affected if this student's key changed
+    QList<int> affectedStudents = {index};
+    const auto relist = [index, &affectedStudents](QMultiHash<QString, int> &studentsWithKey, const QString &oldKey, const QString &newKey) {
+        if(oldKey == newKey) {
+            return;
+        }
+        if(!oldKey.isEmpty()) {
+            studentsWithKey.remove(oldKey, index);
+            affectedStudents << studentsWithKey.values(oldKey);
+        }
+        if(!newKey.isEmpty()) {
+            affectedStudents << studentsWithKey.values(newKey);
+            studentsWithKey.insert(newKey, index);
+        }
+    };
+    relist(studentsWithName, oldKeys.name, newKeys.name);
+    relist(studentsWithEmail, oldKeys.email, newKeys.email);
+    if((oldKeys.name != newKeys.name) || (oldKeys.email != newKeys.email)) {
+        nameIndex.reset();
+    }
+
+    for(const auto affectedStudent : qAsConst(affectedStudents)) {
+        const DuplicateCheckKeys &keys = duplicateCheckKeys.at(affectedStudent);
+        const bool duplicate = (!keys.name.isEmpty() && (studentsWithName.count(keys.name) > 1)) ||
+                               (!keys.email.isEmpty() && (studentsWithEmail.count(keys.email) > 1));
+        StudentRecord &affected = students[affectedStudent];
+        if(affected.duplicateRecord != duplicate) {
+            affected.duplicateRecord = duplicate;
+            affected.invalidateTooltip();
+            changedStudents << affectedStudent;
+        }
+    }
+}
+
+
+//////////////////
+// The index of the current students' names and email addresses, built only if a student has been listed differently since it was last built
+//////////////////
+std::shared_ptr<const StudentNameIndex> gruepr::studentNameIndex()
+{
+    if(nameIndex == nullptr) {
+        nameIndex = std::make_shared<const StudentNameIndex>(students);
+    }
+    return nameIndex;
+}
+
+
+//////////////////
+// Share the current data options with a new team set, copying them only if they have changed since they were last shared
+//////////////////
+std::shared_ptr<const DataOptions> gruepr::publishDataOptions()
+{
+    if(publishedDataOptions == nullptr) {
+        publishedDataOptions = std::make_shared<const DataOptions>(*dataOptions);
+    }
+    return publishedDataOptions;
+}
+
 
 void gruepr::simpleUIItemUpdate(QObject* sender)
 {
@@ -1596,8 +1880,12 @@ void gruepr::selectURMResponses()
         teamingOptions->URMResponsesConsideredUR = win->URMResponsesConsideredUR;
         teamingOptions->URMResponsesConsideredUR.removeDuplicates();
         //(re)apply these values to the student database
-        for(auto &student : students) {
-            student.URM = teamingOptions->URMResponsesConsideredUR.contains(student.URMResponse);
+        for(int index = 0; index < students.size(); index++) {
+            const bool URM = teamingOptions->URMResponsesConsideredUR.contains(students.at(index).URMResponse);
+            if(students.at(index).URM != URM) {
+                students[index].URM = URM;
+                markStudentChanged(index);
+            }
         }
     }
 
@@ -1637,7 +1925,7 @@ void gruepr::makeTeammatesRules()
         teamTabNames << ui->dataDisplayTabWidget->tabText(tab);
     }
 
-    auto *win = new TeammatesRulesDialog(students, *dataOptions, *teamingOptions,
+    auto *win = new TeammatesRulesDialog(students, studentNameIndex(), *dataOptions, *teamingOptions,
                                          ((teamingOptions->sectionType == TeamingOptions::SectionType::allTogether) ||
                                           (teamingOptions->sectionType == TeamingOptions::SectionType::allSeparately) ||
                                           (teamingOptions->sectionType == TeamingOptions::SectionType::noSections))? "" : teamingOptions->sectionName,
@@ -1648,6 +1936,7 @@ void gruepr::makeTeammatesRules()
         for(int index = 0; index < students.size(); index++) {
             this->students[index] = win->students[index];
         }
+        markAllStudentsChanged();
         teamingOptions->haveAnyRequiredTeammates = win->required_teammatesSpecified;
         teamingOptions->haveAnyPreventedTeammates = win->prevented_teammatesSpecified;
         teamingOptions->haveAnyRequestedTeammates = win->requested_teammatesSpecified;
@@ -1684,7 +1973,7 @@ void gruepr::changeIdealTeamSize()
 
         if(calculatingSeparateSections) {
             // if teaming all sections separately, figure out how many students in this section
-            const QString sectionName = sectionSelectionBox->itemText(section + 3);
+            const InternedString sectionName(sectionSelectionBox->itemText(section + 3));
             numStudentsBeingTeamed = 0;
             for(const auto &student : qAsConst(students)) {
                 if(student.section == sectionName && !student.deleted) {
@@ -1693,7 +1982,7 @@ void gruepr::changeIdealTeamSize()
             }
         }
         else if(multipleSectionsInProgress) {
-            const QString sectionName = sectionSelectionBox->currentText();
+            const InternedString sectionName(sectionSelectionBox->currentText());
             numStudentsBeingTeamed = 0;
             for(const auto &student : qAsConst(students)) {
                 if(student.section == sectionName && !student.deleted) {
@@ -1944,7 +2233,7 @@ void gruepr::startOptimization()
 
     bestTeamSet.clear();
     finalTeams.clear();
-    finalTeams.dataOptions = *dataOptions;
+    finalTeams.dataOptions = publishDataOptions();
 
     const bool teamingMultipleSections = (teamingOptions->sectionType == TeamingOptions::SectionType::allSeparately);
     multipleSectionsInProgress = teamingMultipleSections;
@@ -1958,12 +2247,13 @@ void gruepr::startOptimization()
 
         // Get the indexes of non-deleted students from desired section(s) and change numStudents accordingly
         int numStudentsInSection = 0;
+        const InternedString sectionName(teamingOptions->sectionName);
         studentIndexes.reserve(students.size());
         for(int index = 0; index < students.size(); index++) {
             if(!students[index].deleted &&
                 ((teamingOptions->sectionType == TeamingOptions::SectionType::allTogether) ||
                 (teamingOptions->sectionType == TeamingOptions::SectionType::noSections) ||
-                (teamingOptions->sectionName == students[index].section))) {
+                (sectionName == students[index].section))) {
                 studentIndexes << index;
                 numStudentsInSection++;
             }
@@ -1986,21 +2276,19 @@ void gruepr::startOptimization()
         // Create a new set of TeamRecords to hold the eventual results
         numTeams = teamingOptions->numTeamsDesired;
         teams.clear();
-        teams.dataOptions = *dataOptions;
+        teams.dataOptions = finalTeams.dataOptions;
         teams.reserve(numTeams);
         for(const auto teamSize : qAsConst(teamingOptions->teamSizesDesired)) {
-            teams.emplaceBack(&teams.dataOptions, teamSize);
+            teams.emplaceBack(teams.dataOptions.get(), teamSize);
         }
 
         // Create progress display plot
-        progressChart = new BoxWhiskerPlot("", "Generation", "Scores");
-        auto *chartView = new QChartView(progressChart);
-        chartView->setRenderHint(QPainter::Antialiasing);
+        progressChart = new BoxWhiskerPlot(tr("Generation"), tr("Scores"));
 
         // Create window to display progress, and connect the stop optimization button in the window to the actual stopping of the optimization thread
         const QString sectionName = (teamingMultipleSections? (tr("section ") + QString::number(section + 1) + " / " + QString::number(numSectionsToTeam) + ": " +
                                                           teamingOptions->sectionName) : "");
-        progressWindow = new progressDialog(sectionName, chartView, this);
+        progressWindow = new progressDialog(sectionName, progressChart, this);
         progressWindow->show();
         connect(progressWindow, &progressDialog::letsStop, this, [this] {QApplication::setOverrideCursor(QCursor(Qt::BusyCursor));
                                                                          connect(this, &gruepr::turnOffBusyCursor, this, &QApplication::restoreOverrideCursor);
@@ -2011,6 +2299,8 @@ void gruepr::startOptimization()
 
         // Set up the flag to allow a stoppage and set up futureWatcher to know when results are available
         optimizationStopped = false;
+        generationSnapshots.clear();
+        progressDisplayTimer.start();
         future = QtConcurrent::run(&gruepr::optimizeTeams, this, studentIndexes);       // spin optimization off into a separate thread
         futureWatcher.setFuture(future);                                // connect the watcher to get notified when optimization completes
         multipleSectionsInProgress = (section < (numSectionsToTeam - 1));
@@ -2037,24 +2327,31 @@ void gruepr::startOptimization()
 }
 
 
-void gruepr::updateOptimizationProgress(const float *const allScores, const int *const orderedIndex,
-                                        const int generation, const float scoreStability, const bool unpenalizedGenomePresent)
+void gruepr::updateOptimizationProgress()
 {
-    if((generation % (BoxWhiskerPlot::PLOTFREQUENCY)) == 0) {
-        progressChart->loadNextVals(allScores, orderedIndex, ga.populationsize, unpenalizedGenomePresent);
+    // plot every PLOTFREQUENCY-th of the generations completed since last time, then report on the most recent one
+    GenerationSnapshot snapshot;
+    while(generationSnapshots.pop(snapshot)) {
+        if((snapshot.generation % (BoxWhiskerPlot::PLOTFREQUENCY)) == 0) {
+            progressChart->loadNextVals(snapshot);
+        }
+    }
+    if(!generationSnapshots.takeLatest(snapshot)) {
+        return;
     }
 
-    if(generation > GA::MAX_GENERATIONS) {
+    const float generationsPerSecond = ((snapshot.msecsPerGeneration > 0)? (1000.0F / snapshot.msecsPerGeneration) : 0);
+    if(snapshot.generation > GA::MAX_GENERATIONS) {
         progressWindow->setText(tr("We have reached ") + QString::number(GA::MAX_GENERATIONS) + tr(" generations."),
-                                generation, *std::max_element(allScores, allScores+ga.populationsize), true);
+                                snapshot.generation, snapshot.bestScore, true, generationsPerSecond);
         progressWindow->highlightStopButton();
     }
-    else if((generation >= GA::MIN_GENERATIONS) && (scoreStability > GA::MIN_SCORE_STABILITY)) {
-        progressWindow->setText(tr("Score appears to be stable!"), generation, *std::max_element(allScores, allScores+ga.populationsize), true);
+    else if((snapshot.generation >= GA::MIN_GENERATIONS) && (snapshot.scoreStability > GA::MIN_SCORE_STABILITY)) {
+        progressWindow->setText(tr("Score appears to be stable!"), snapshot.generation, snapshot.bestScore, true, generationsPerSecond);
         progressWindow->highlightStopButton();
     }
     else {
-        progressWindow->setText(tr("Please wait while your grueps are created!"), generation, *std::max_element(allScores, allScores+ga.populationsize), false);
+        progressWindow->setText(tr("Please wait while your grueps are created!"), snapshot.generation, snapshot.bestScore, false, generationsPerSecond);
     }
 }
 
@@ -2062,6 +2359,8 @@ void gruepr::updateOptimizationProgress(const float *const allScores, const int
 void gruepr::optimizationComplete()
 {
     // update UI
+    progressDisplayTimer.stop();
+    generationSnapshots.clear();
     delete progressChart;
     delete progressWindow;
 
@@ -2092,28 +2391,29 @@ void gruepr::optimizationComplete()
         }
         //sort teammates within a team alphabetically by lastname,firstname
         std::sort(IDList.begin(), IDList.end(), [this] (const int a, const int b)
-                  { const StudentRecord *const studentA = findStudentFromID(a);
-                      const StudentRecord *const studentB = findStudentFromID(b);
+                  { const StudentRecord *const studentA = students.findByID(a);
+                      const StudentRecord *const studentB = students.findByID(b);
                       return ((studentA->lastname + studentA->firstname) <
                               (studentB->lastname + studentB->firstname));
                   });
     }
 
     // Load scores and info into the teams
-    calcTeamScores(students, numActiveStudents, teams, teamingOptions);
+    calcTeamScores(students, teams, teamingOptions);
+    const auto studentsSnapshot = std::make_shared<const StudentList>(students);
     for(auto &team : teams) {
-        team.refreshTeamInfo(students, teamingOptions->realMeetingBlockSize);
+        team.refreshTeamInfo(studentsSnapshot, teamingOptions->realMeetingBlockSize);
     }
 
     for(int team = 0; team < teams.size(); team++) {
         teams[team].name = QString::number(team+1);
-        teams[team].createTooltip();
+        teams[team].invalidateTooltip();
     }
 
     // Sort teams by 1st student's name, then set default teamnames and create tooltips
     // std::sort(teams.begin(), teams.end(), [this](const TeamRecord &a, const TeamRecord &b)
-    //           { const StudentRecord *const firstStudentOnTeamA = findStudentFromID(a.studentIDs.at(0));
-    //             const StudentRecord *const firstStudentOnTeamB = findStudentFromID(b.studentIDs.at(0));
+    //           { const StudentRecord *const firstStudentOnTeamA = students.findByID(a.studentIDs.at(0));
+    //             const StudentRecord *const firstStudentOnTeamB = students.findByID(b.studentIDs.at(0));
     //             return ((firstStudentOnTeamA->lastname + firstStudentOnTeamA->firstname) <
     //                     (firstStudentOnTeamB->lastname + firstStudentOnTeamB->firstname));
     //           });
@@ -2125,7 +2425,8 @@ void gruepr::optimizationComplete()
     ui->dataDisplayTabWidget->addTab(teamTab, teamSetName);
     numTeams = int(teams.size());
     teamingOptions->teamsetNumber++;
-    connect(teamTab, &TeamsTabItem::saveState, this, &gruepr::saveState);
+    connectTeamTab(teamTab);
+    markTeamSetChanged(teamTab);
 
     ui->dataDisplayTabWidget->setCurrentWidget(teamTab);
     saveState();
@@ -2142,6 +2443,7 @@ void gruepr::dataDisplayTabClose(int closingTabIndex)
     auto *tab = ui->dataDisplayTabWidget->widget(closingTabIndex);
     ui->dataDisplayTabWidget->removeTab(closingTabIndex);
     tab->deleteLater();
+    allTeamSetsChanged = true;      // the team sets after this one have all moved
     saveState();
 }
 
@@ -2174,6 +2476,7 @@ void gruepr::editDataDisplayTabName(int tabIndex)
         ui->dataDisplayTabWidget->setTabText(tabIndex, newNameEditor->text());
         auto *tab = qobject_cast<TeamsTabItem *>(ui->dataDisplayTabWidget->widget(tabIndex));
         tab->tabName = newNameEditor->text();
+        markTeamSetChanged(tab);
     }
     win->deleteLater();
     saveState();
@@ -2368,7 +2671,7 @@ void gruepr::loadUI()
     //         for(int tab = 1; tab < numTabs; tab++) {
     //             teamTabNames << ui->dataDisplayTabWidget->tabText(tab);
     //         }
-    //         auto *win = new TeammatesRulesDialog(students, *dataOptions, *teamingOptions, "", teamTabNames, this, true);
+    //         auto *win = new TeammatesRulesDialog(students, studentNameIndex(), *dataOptions, *teamingOptions, "", teamTabNames, this, true);
     //         for(int index = 0; index < students.size(); index++) {
     //             this->students[index] = win->students[index];
     //         }
@@ -2389,7 +2692,7 @@ void gruepr::loadUI()
     //         for(int tab = 1; tab < numTabs; tab++) {
     //             teamTabNames << ui->dataDisplayTabWidget->tabText(tab);
     //         }
-    //         auto *win = new TeammatesRulesDialog(students, *dataOptions, *teamingOptions, "", teamTabNames, this, false, true);
+    //         auto *win = new TeammatesRulesDialog(students, studentNameIndex(), *dataOptions, *teamingOptions, "", teamTabNames, this, false, true);
     //         for(int index = 0; index < students.size(); index++) {
     //             this->students[index] = win->students[index];
     //         }
@@ -2400,56 +2703,187 @@ void gruepr::loadUI()
 }
 
 //////////////////
-// Save everything for future re-opening
+// Save everything for future re-opening. The current state is captured here, and then written to disk on a separate thread; requests made
+// while a write is underway are coalesced, so that only the most recent state is written next
 //////////////////
 void gruepr::saveState()
 {
-    QSettings savedSettings;
+    pendingSaveState.teamingOptions = teamingOptions->toJson();
+    pendingSaveState.dataOptions = dataOptions->toJson();
+    pendingSaveState.students = students;   // implicitly shared copy; the changed students are converted to JSON on the writer thread
+    pendingSaveState.allStudentsChanged = pendingSaveState.allStudentsChanged || allStudentsChanged;
+    pendingSaveState.changedStudents.unite(changedStudents);
+    allStudentsChanged = false;
+    changedStudents.clear();
+
+    const int numTeamSets = ui->dataDisplayTabWidget->count() - 1;
+    if(allTeamSetsChanged) {
+        pendingSaveState.changedTeamSets.clear();
+    }
+    for(int tabIndex = 1; tabIndex <= numTeamSets; tabIndex++) {
+        auto *tab = qobject_cast<TeamsTabItem *>(ui->dataDisplayTabWidget->widget(tabIndex));
+        if(allTeamSetsChanged || changedTeamSets.contains(tab)) {
+            pendingSaveState.changedTeamSets[tabIndex - 1] = tab->savedContents();     // converted to JSON on the writer thread
+        }
+    }
+    pendingSaveState.numTeamSets = numTeamSets;
+    pendingSaveState.allTeamSetsChanged = pendingSaveState.allTeamSetsChanged || allTeamSetsChanged;
+    allTeamSetsChanged = false;
+    changedTeamSets.clear();
+    saveStateIsPending = true;
 
-    QFile saveFile(dataOptions->saveStateFileName, this);
-    if(saveFile.open(QIODeviceBase::WriteOnly | QIODeviceBase::Text)) {
-        QJsonObject content;
-        content["teamingoptions"] = teamingOptions->toJson();
-        content["dataoptions"] = dataOptions->toJson();
+    if(!saveStateWatcher.isRunning()) {
+        startSaveStateWrite();
+    }
+}
+
+
+void gruepr::markStudentChanged(const int index)
+{
+    if(index >= 0) {
+        changedStudents << index;
+        updateDuplicateCheck(index);
+    }
+}
+
+
+//////////////////
+// Call once dataOptions has been changed, after any loop over the students that changes it
+//////////////////
+void gruepr::markDataOptionsChanged()
+{
+    publishedDataOptions.reset();
+    dataOptions->markChanged();
+}
+
+
+void gruepr::markAllStudentsChanged()
+{
+    allStudentsChanged = true;
+}
+
+
+void gruepr::markTeamSetChanged(TeamsTabItem *teamTab)
+{
+    changedTeamSets << teamTab;
+}
+
+
+void gruepr::connectTeamTab(TeamsTabItem *teamTab)
+{
+    connect(teamTab, &TeamsTabItem::saveState, this, [this, teamTab]{markTeamSetChanged(teamTab); saveState();});
+    connect(teamTab, &TeamsTabItem::studentsChanged, this, &gruepr::markAllStudentsChanged);
+}
+
+
+void gruepr::startSaveStateWrite()
+{
+    const SaveStateSnapshot snapshot = pendingSaveState;
+    pendingSaveState = SaveStateSnapshot();
+    saveStateIsPending = false;
+    saveStateWatcher.setFuture(QtConcurrent::run(&gruepr::writeSaveState, &saveStateFile, dataOptions->saveStateFileName, snapshot));
+}
+
+
+//////////////////
+// Write one snapshot of the state to disk (runs on the writer thread)
+//////////////////
+gruepr::SaveStateResult gruepr::writeSaveState(SaveStateFile *const saveStateFile, const QString &fileName, const SaveStateSnapshot &snapshot)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    saveStateFile->setSection(SaveStateFile::Section::teamingOptions, snapshot.teamingOptions);
+    saveStateFile->setSection(SaveStateFile::Section::dataOptions, snapshot.dataOptions);
+
+    const int numStudents = int(snapshot.students.size());
+    if(snapshot.allStudentsChanged) {
         QJsonArray studentjsons;
-        for(const auto &student : qAsConst(students)) {
+        for(const auto &student : snapshot.students) {
             studentjsons.append(student.toJson());
         }
-        content["students"] = studentjsons;
+        saveStateFile->setSection(SaveStateFile::Section::students, studentjsons);
+    }
+    else {
+        for(const auto index : snapshot.changedStudents) {
+            if(index < numStudents) {
+                saveStateFile->setElement(SaveStateFile::Section::students, index, numStudents, snapshot.students.at(index).toJson());
+            }
+        }
+    }
+
+    if(snapshot.allTeamSetsChanged) {
         QJsonArray teamsetjsons;
-        for(int tabIndex = 1; tabIndex < ui->dataDisplayTabWidget->count(); tabIndex++) {
-            const auto *tab = qobject_cast<TeamsTabItem *>(ui->dataDisplayTabWidget->widget(tabIndex));
-            teamsetjsons.append(tab->toJson());
-        }
-        content["teamsets"] = teamsetjsons;
-        const QJsonDocument doc(content);
-        saveFile.write(doc.toJson(QJsonDocument::Compact));
-        saveFile.close();
-
-        //find which savestate this is in the settings
-        const int numIndexes = savedSettings.beginReadArray("prevWorks");
-        int index = -1;
-        for(int i = 0; i < numIndexes; i++) {
-            savedSettings.setArrayIndex(i);
-            if(savedSettings.value("prevWorkFile", "").toString().compare(saveFile.fileName(), Qt::CaseInsensitive) == 0) {
-                index = i;
-            }
-        }
-        savedSettings.endArray();
-        savedSettings.beginWriteArray("prevWorks");
-        if(index == -1) {
-            savedSettings.setArrayIndex(numIndexes);
-            savedSettings.setValue("prevWorkName", dataOptions->dataSourceName);
-            savedSettings.setValue("prevWorkFile", saveFile.fileName());
-            savedSettings.setValue("prevWorkDate", QDateTime::currentDateTime().toString(QLocale::system().dateTimeFormat(QLocale::LongFormat)));
+        for(const auto &teamset : snapshot.changedTeamSets) {
+            teamsetjsons.append(teamset.toJson());
         }
-        else {
-            savedSettings.setArrayIndex(index);
-            savedSettings.setValue("prevWorkDate", QDateTime::currentDateTime().toString(QLocale::system().dateTimeFormat(QLocale::LongFormat)));
-            savedSettings.setArrayIndex(numIndexes-1); // go to the end of the array so that we still have access to all values next time
+        saveStateFile->setSection(SaveStateFile::Section::teamSets, teamsetjsons);
+    }
+    else {
+        for(auto teamset = snapshot.changedTeamSets.constBegin(); teamset != snapshot.changedTeamSets.constEnd(); teamset++) {
+            saveStateFile->setElement(SaveStateFile::Section::teamSets, teamset.key(), snapshot.numTeamSets, teamset.value().toJson());
         }
-        savedSettings.endArray();
     }
+
+    const bool saved = saveStateFile->saveChanges(fileName);
+    return {saved, timer.elapsed()};
+}
+
+
+void gruepr::saveStateWritten()
+{
+    const SaveStateResult result = saveStateWatcher.result();
+    if(result.saved) {
+        numSaveStateFailures = 0;
+        updatePrevWorksList();
+        statusBar()->showMessage(tr("Work saved") + " (" + QString::number(result.msecsTaken) + " ms)", SAVEDMESSAGEDURATION);
+    }
+    else {
+        // a single failure may be transient, and the changes are kept to be written with the next save, so only speak up if it keeps happening
+        numSaveStateFailures++;
+        if(numSaveStateFailures == MAXSAVESTATEFAILURES) {
+            grueprGlobal::errorMessage(this, tr("Error saving work"),
+                                       tr("Your work could not be saved to:\n") + dataOptions->saveStateFileName +
+                                       tr("\n\ngruepr will keep trying, but any changes made since the last successful save may be lost when gruepr is closed."));
+        }
+    }
+
+    if(saveStateIsPending) {
+        startSaveStateWrite();
+    }
+}
+
+
+//////////////////
+// Record this save file, with the current date, in the list of previous work shown on the start screen
+//////////////////
+void gruepr::updatePrevWorksList()
+{
+    QSettings savedSettings;
+
+    //find which savestate this is in the settings
+    const int numIndexes = savedSettings.beginReadArray("prevWorks");
+    int index = -1;
+    for(int i = 0; i < numIndexes; i++) {
+        savedSettings.setArrayIndex(i);
+        if(savedSettings.value("prevWorkFile", "").toString().compare(dataOptions->saveStateFileName, Qt::CaseInsensitive) == 0) {
+            index = i;
+        }
+    }
+    savedSettings.endArray();
+    savedSettings.beginWriteArray("prevWorks");
+    if(index == -1) {
+        savedSettings.setArrayIndex(numIndexes);
+        savedSettings.setValue("prevWorkName", dataOptions->dataSourceName);
+        savedSettings.setValue("prevWorkFile", dataOptions->saveStateFileName);
+        savedSettings.setValue("prevWorkDate", QDateTime::currentDateTime().toString(QLocale::system().dateTimeFormat(QLocale::LongFormat)));
+    }
+    else {
+        savedSettings.setArrayIndex(index);
+        savedSettings.setValue("prevWorkDate", QDateTime::currentDateTime().toString(QLocale::system().dateTimeFormat(QLocale::LongFormat)));
+        savedSettings.setArrayIndex(numIndexes-1); // go to the end of the array so that we still have access to all values next time
+    }
+    savedSettings.endArray();
 }
 
 
@@ -2562,117 +2996,11 @@ bool gruepr::loadRosterData(CsvFile &rosterFile, QStringList &names, QStringList
 //////////////////
 void gruepr::refreshStudentDisplay()
 {
-    ui->studentTable->setUpdatesEnabled(false);
+    // only the rows of students who were added or whose shown data changed are updated; the rest are re-filtered only if the section changed
     ui->dataDisplayTabWidget->setCurrentIndex(0);
-    ui->studentTable->clear();
-    ui->studentTable->setSortingEnabled(false);
-
-    ui->studentTable->setColumnCount(2 + (dataOptions->timestampField != DataOptions::FIELDNOTPRESENT? 1 : 0) + (dataOptions->firstNameField != DataOptions::FIELDNOTPRESENT? 1 : 0) +
-                                     (dataOptions->lastNameField != DataOptions::FIELDNOTPRESENT? 1 : 0) + (dataOptions->sectionIncluded? 1 : 0));
-    const QIcon unsortedIcon(":/icons_new/upDownButton_white.png");
-    int column = 0;
-    if(dataOptions->timestampField != DataOptions::FIELDNOTPRESENT) {
-        ui->studentTable->setHorizontalHeaderItem(column++, new QTableWidgetItem(unsortedIcon, tr("  Survey  \n  Timestamp  ")));
-    }
-    if(dataOptions->firstNameField != DataOptions::FIELDNOTPRESENT) {
-        ui->studentTable->setHorizontalHeaderItem(column++, new QTableWidgetItem(unsortedIcon, tr("  First  \n  Name  ")));
-    }
-    if(dataOptions->lastNameField != DataOptions::FIELDNOTPRESENT) {
-        ui->studentTable->setHorizontalHeaderItem(column++, new QTableWidgetItem(unsortedIcon, tr("  Last  \n  Name  ")));
-    }
-    if(dataOptions->sectionIncluded) {
-        ui->studentTable->setHorizontalHeaderItem(column++, new QTableWidgetItem(unsortedIcon, tr("  Section  ")));
-    }
-    ui->studentTable->setHorizontalHeaderItem(column++, new QTableWidgetItem(tr("  Edit")));
-    ui->studentTable->setHorizontalHeaderItem(column, new QTableWidgetItem(tr("  Remove")));
-
-    ui->studentTable->setRowCount(students.size());
-    numActiveStudents = 0;
-    for(const auto &student : qAsConst(students)) {
-        column = 0;
-        if((numActiveStudents < students.size()) &&            // make sure student exists, hasn't been deleted, and is in the section(s) being teamed
-           (!student.deleted) &&
-           ((teamingOptions->sectionType == TeamingOptions::SectionType::allTogether) ||
-            (teamingOptions->sectionType == TeamingOptions::SectionType::allSeparately) ||
-            (teamingOptions->sectionType == TeamingOptions::SectionType::noSections) ||
-            (student.section == teamingOptions->sectionName))) {
-
-            auto *timestamp = new SortableTableWidgetItem(SortableTableWidgetItem::SortType::datetime,
-                                                          QLocale::system().toString(student.surveyTimestamp, QLocale::ShortFormat));
-            if(dataOptions->timestampField != DataOptions::FIELDNOTPRESENT) {
-                ui->studentTable->setItem(numActiveStudents, column++, timestamp);
-            }
-            auto *firstName = new QTableWidgetItem(student.firstname);
-            if(dataOptions->firstNameField != DataOptions::FIELDNOTPRESENT) {
-                ui->studentTable->setItem(numActiveStudents, column++, firstName);
-            }
-            auto *lastName = new QTableWidgetItem(student.lastname);
-            if(dataOptions->lastNameField != DataOptions::FIELDNOTPRESENT) {
-                ui->studentTable->setItem(numActiveStudents, column++, lastName);
-            }
-            auto *section = new SortableTableWidgetItem(SortableTableWidgetItem::SortType::alphanumeric, student.section);
-            if(dataOptions->sectionIncluded) {
-                ui->studentTable->setItem(numActiveStudents, column++, section);
-            }
-
-            const bool duplicate = student.duplicateRecord;
-
-            QList<QTableWidgetItem*> items = {timestamp, firstName, lastName, section};
-            for(auto &item : items) {
-                item->setToolTip(student.tooltip);
-            }
-
-            auto *editButton = new PushButtonWithMouseEnter(QIcon(":/icons_new/edit.png"), "", this);
-            editButton->setToolTip("<html>" + tr("Edit") + " " + student.firstname + " " + student.lastname + tr("'s data.") + "</html>");
-            editButton->setProperty("StudentID", student.ID);
-            editButton->setProperty("duplicate", duplicate);
-            if(duplicate) {
-                editButton->setStyleSheet(EDITREMOVEBUTTONDUPLICATESTYLE);
-            }
-            connect(editButton, &PushButtonWithMouseEnter::clicked, this, &gruepr::editAStudent);
-            // pass on mouse enter events onto cell in table
-            connect(editButton, &PushButtonWithMouseEnter::mouseEntered, this, [this, editButton]
-                                                                        {int row=0;
-                                                                         while(editButton != ui->studentTable->cellWidget(row, ui->studentTable->columnCount()-2))
-                                                                              {row++;}
-                                                                         ui->studentTable->cellEntered(row);});
-            connect(editButton, &PushButtonWithMouseEnter::mouseLeft, this, [this, editButton]
-                                                                     {int row=0;
-                                                                      while(editButton != ui->studentTable->cellWidget(row, ui->studentTable->columnCount()-2))
-                                                                           {row++;}
-                                                                      ui->studentTable->cellLeft(row);});
-            ui->studentTable->setCellWidget(numActiveStudents, column++, editButton);
-
-            auto *removerButton = new PushButtonWithMouseEnter(QIcon(":/icons_new/trashButton.png"), "", this);
-            removerButton->setToolTip("<html>" + tr("Remove") + " " + student.firstname + " " + student.lastname + " " +
-                                                 tr("from the list.") + "</html>");
-            removerButton->setProperty("StudentID", student.ID);
-            removerButton->setProperty("duplicate", duplicate);
-            if(duplicate) {
-                removerButton->setStyleSheet(EDITREMOVEBUTTONDUPLICATESTYLE);
-            }
-            connect(removerButton, &PushButtonWithMouseEnter::clicked, this, [this, ID = student.ID, removerButton]{removerButton->disconnect(); removeAStudent(ID);});
-            // pass on mouse enter events onto cell in table
-            connect(removerButton, &PushButtonWithMouseEnter::mouseEntered, this, [this, removerButton]
-                                                                           {int row=0;
-                                                                            while(removerButton != ui->studentTable->cellWidget(row, ui->studentTable->columnCount()-1))
-                                                                                 {row++;}
-                                                                            ui->studentTable->cellEntered(row);});
-            connect(removerButton, &PushButtonWithMouseEnter::mouseLeft, this, [this, removerButton]
-                                                                        {int row=0;
-                                                                         while(removerButton != ui->studentTable->cellWidget(row, ui->studentTable->columnCount()-1))
-                                                                              {row++;}
-                                                                         ui->studentTable->cellLeft(row);});
-            ui->studentTable->setCellWidget(numActiveStudents, column, removerButton);
-
-            numActiveStudents++;
-        }
-    }
-    ui->studentTable->setRowCount(std::min(students.size(), numActiveStudents));   // not sure how numActiveStudents could be larger, but safer to take min
-
-    ui->studentTable->setUpdatesEnabled(true);
-    ui->studentTable->resizeColumnsToContents();
-    ui->studentTable->setSortingEnabled(true);
+    ui->studentTable->showSection(teamingOptions->sectionType, teamingOptions->sectionName);
+    ui->studentTable->refreshStudents();
+    numActiveStudents = ui->studentTable->numStudentsShown();
 }
 
 
@@ -2752,7 +3080,7 @@ QList<int> gruepr::optimizeTeams(QList<int> studentIndexes)
     auto sharedStudents = students;
     auto sharedNumTeams = numTeams;
     auto *sharedTeamingOptions = teamingOptions;
-    auto *sharedDataOptions = dataOptions;
+    const auto *sharedDataOptions = teams.dataOptions.get();    // the published copy, which cannot change while optimizing
     //std::set<int> attributesBeingScored;
     // for(int attrib = 0; attrib < dataOptions->numAttributes; attrib++) {
     //     if((teamingOptions->realAttributeWeights[attrib] > 0) ||
@@ -2811,7 +3139,11 @@ QList<int> gruepr::optimizeTeams(QList<int> studentIndexes)
 
     // get genome indexes in order of score, largest to smallest
     std::sort(orderedIndex, orderedIndex+ga.populationsize, [&scores](const int i, const int j){return (scores[i] > scores[j]);});
-    emit generationComplete(scores, orderedIndex, 0, 0, unpenalizedGenomePresent);
+    GenerationSnapshot snapshot = GenerationSnapshot::fromScores(scores, orderedIndex, ga.populationsize);
+    snapshot.unpenalizedGenomePresent = unpenalizedGenomePresent;
+    generationSnapshots.push(snapshot);
+    QElapsedTimer generationTimer;
+    generationTimer.start();
 
 
     const int *mom=nullptr, *dad=nullptr;               // pointer to genome of mom and dad
@@ -2857,7 +3189,7 @@ QList<int> gruepr::optimizeTeams(QList<int> studentIndexes)
             sharedStudents = students;
             sharedNumTeams = numTeams;
             sharedTeamingOptions = teamingOptions;
-            sharedDataOptions = dataOptions;
+            sharedDataOptions = teams.dataOptions.get();
 #pragma omp parallel \
             default(none) \
                 shared(scores, sharedStudents, genePool, sharedNumTeams, teamSizes, sharedTeamingOptions, sharedDataOptions, unpenalizedGenomePresent) \
@@ -2914,7 +3246,15 @@ QList<int> gruepr::optimizeTeams(QList<int> studentIndexes)
             else {
                 scoreStability = maxScoreInThisGeneration / (maxScoreInThisGeneration - maxScoreFromGenerationsAgo);
             }
-            emit generationComplete(scores, orderedIndex, generation, scoreStability, unpenalizedGenomePresent);
+
+            // publish a summary of this generation for the UI, which will show it when it next polls
+            snapshot = GenerationSnapshot::fromScores(scores, orderedIndex, ga.populationsize);
+            snapshot.generation = generation;
+            snapshot.scoreStability = scoreStability;
+            snapshot.unpenalizedGenomePresent = unpenalizedGenomePresent;
+            snapshot.msecsPerGeneration = float(generationTimer.nsecsElapsed()) / 1000000.0F;
+            generationTimer.restart();
+            generationSnapshots.push(snapshot);
 
             optimizationStoppedmutex.lock();
             localOptimizationStopped = optimizationStopped;
@@ -2970,7 +3310,8 @@ QList<int> gruepr::optimizeTeams(QList<int> studentIndexes)
 //////////////////
 float gruepr::getGenomeScore(const StudentRecord *const _students, const int _teammates[], const int _numTeams, const int _teamSizes[],
                              const TeamingOptions *const _teamingOptions, const DataOptions *const _dataOptions,
-                             float _teamScores[], float **_criterionScore, bool **_availabilityChart, int *_penaltyPoints)
+                             float _teamScores[], float **_criterionScore, bool **_availabilityChart, int *_penaltyPoints,
+                             const std::set<long long> *_IDsBeingTeamed)
 {
     // Initialize each component score
     for(int team = 0; team < _numTeams; team++) {
@@ -3006,15 +3347,15 @@ float gruepr::getGenomeScore(const StudentRecord *const _students, const int _te
             //getScheduleScores(_students, _teammates, _numTeams, _teamSizes, _teamingOptions, _dataOptions, _schedScore, _availabilityChart, _penaltyPoints);
         } else if (dynamic_cast<PreventedTeammatesCriterion*>(_criterionBeingScored)){
             auto criterionCasted = dynamic_cast<PreventedTeammatesCriterion*>(_criterionBeingScored);
-            getPreventedTeammatesScore(_students, _teammates, _numTeams, _teamSizes, _teamingOptions, criterionCasted, _criterionScore[i], _penaltyPoints);
+            getPreventedTeammatesScore(_students, _teammates, _numTeams, _teamSizes, _teamingOptions, criterionCasted, _criterionScore[i], _penaltyPoints, _IDsBeingTeamed);
             //getTeammatePenalties(_students, _teammates, _numTeams, _teamSizes, _teamingOptions, _penaltyPoints);
         } else if (dynamic_cast<RequestedTeammatesCriterion*>(_criterionBeingScored)){;
             auto criterionCasted = dynamic_cast<RequestedTeammatesCriterion*>(_criterionBeingScored);
-            getRequestedTeammatesScore(_students, _teammates, _numTeams, _teamSizes, _teamingOptions, criterionCasted, _criterionScore[i], _penaltyPoints);
+            getRequestedTeammatesScore(_students, _teammates, _numTeams, _teamSizes, _teamingOptions, criterionCasted, _criterionScore[i], _penaltyPoints, _IDsBeingTeamed);
             //getTeammatePenalties(_students, _teammates, _numTeams, _teamSizes, _teamingOptions, _penaltyPoints);
         } else if (dynamic_cast<RequiredTeammatesCriterion*>(_criterionBeingScored)){
             auto criterionCasted = dynamic_cast<RequiredTeammatesCriterion*>(_criterionBeingScored);
-            getRequiredTeammatesScore(_students, _teammates, _numTeams, _teamSizes, _teamingOptions, criterionCasted, _criterionScore[i], _penaltyPoints);
+            getRequiredTeammatesScore(_students, _teammates, _numTeams, _teamSizes, _teamingOptions, criterionCasted, _criterionScore[i], _penaltyPoints, _IDsBeingTeamed);
             //getTeammatePenalties(_students, _teammates, _numTeams, _teamSizes, _teamingOptions, _penaltyPoints);
         }
     }
@@ -3462,6 +3803,8 @@ void gruepr::getSingleGenderScore(const StudentRecord *const _students, const in
 void gruepr::getSingleURMScore(const StudentRecord *const _students, const int _teammates[], const int _numTeams, const int _teamSizes[],
                                   const TeamingOptions *const _teamingOptions, SingleURMIdentityCriterion *criterion, float *_criterionScore, int *_penaltyPoints)
 {
+    const int urmID = criterion->urmID;
+    const QList<int> unallowed_values = _teamingOptions->identityRules.value(criterion->urmName).value("!=");
     int studentNum = 0;
     for(int team = 0; team < _numTeams; team++) {
         if(_teamSizes[team] == 1) {
@@ -3469,21 +3812,18 @@ void gruepr::getSingleURMScore(const StudentRecord *const _students, const int _
             continue;
         }
 
-        // Count how many of each gender on the team
-        QMap <QString, int> urmToCount;
+        // Count how many on the team have this identity
+        int numWithURM = 0;
         for(int teammate = 0; teammate < _teamSizes[team]; teammate++) {
-            if (urmToCount.contains(_students[_teammates[studentNum]].URMResponse)){
-                urmToCount[_students[_teammates[studentNum]].URMResponse] += 1;
-            } else {
-                urmToCount[_students[_teammates[studentNum]].URMResponse] = 1;
+            if(_students[_teammates[studentNum]].URMResponse.id() == urmID) {
+                numWithURM++;
             }
             studentNum++;
         }
 
         _criterionScore[team]=1;
-        QList<int> unallowed_values = _teamingOptions->identityRules[criterion->urmName]["!="];
         for (int unallowed_value : unallowed_values){
-            if (urmToCount[criterion->urmName] == unallowed_value){
+            if (numWithURM == unallowed_value){
                 _criterionScore[team]=0;
                 if (criterion->penaltyStatus){
                     _penaltyPoints[team]++;
@@ -3523,19 +3863,25 @@ void gruepr::getURMPenalties(const StudentRecord *const _students, const int _te
 
 
 void gruepr::getPreventedTeammatesScore(const StudentRecord *const _students, const int _teammates[], const int _numTeams, const int _teamSizes[],
-                                  const TeamingOptions *const _teamingOptions, PreventedTeammatesCriterion *criterion, float *_criterionScore, int *_penaltyPoints)
+                                  const TeamingOptions *const _teamingOptions, PreventedTeammatesCriterion *criterion, float *_criterionScore, int *_penaltyPoints,
+                                        const std::set<long long> *_IDsBeingTeamed)
 {
-    std::set<long long> IDsBeingTeamed, IDsOnTeam;
+    std::set<long long> IDsOnTeam;
     std::multiset<long long> preventedIDsOnTeam;   //multiset so that penalties are in proportion to number of missed requirements
 
     // Get all IDs being teamed (so that we can make sure we only check the requireds/prevented/requesteds that are actually within this teamset)
+    // These are given when only some of the teams in the set are being scored
+    std::set<long long> IDsInGenome;
     int studentNum = 0;
-    for(int team = 0; team < _numTeams; team++) {
-        for(int teammate = 0; teammate < _teamSizes[team]; teammate++) {
-            IDsBeingTeamed.insert(_students[_teammates[studentNum]].ID);
-            studentNum++;
+    if(_IDsBeingTeamed == nullptr) {
+        for(int team = 0; team < _numTeams; team++) {
+            for(int teammate = 0; teammate < _teamSizes[team]; teammate++) {
+                IDsInGenome.insert(_students[_teammates[studentNum]].ID);
+                studentNum++;
+            }
         }
     }
+    const std::set<long long> &IDsBeingTeamed = ((_IDsBeingTeamed != nullptr)? *_IDsBeingTeamed : IDsInGenome);
 
     // Loop through each team
     studentNum = 0;
@@ -3547,8 +3893,9 @@ void gruepr::getPreventedTeammatesScore(const StudentRecord *const _students, co
         for(int teammate = 0; teammate < _teamSizes[team]; teammate++) {
             currStudent = &_students[_teammates[studentNum]];
             IDsOnTeam.insert(currStudent->ID);
-            for(const auto ID : IDsBeingTeamed) {
-                if(currStudent->preventedWith.contains(ID)) {
+            // go through this student's own (short) list rather than through everyone being teamed
+            for(const auto ID : currStudent->preventedWith) {
+                if(IDsBeingTeamed.count(ID) != 0) {
                     preventedIDsOnTeam.insert(ID);
                 }
             }
@@ -3573,20 +3920,26 @@ void gruepr::getPreventedTeammatesScore(const StudentRecord *const _students, co
 }
 
 void gruepr::getRequiredTeammatesScore(const StudentRecord *const _students, const int _teammates[], const int _numTeams, const int _teamSizes[],
-                                        const TeamingOptions *const _teamingOptions, RequiredTeammatesCriterion *criterion, float *_criterionScore, int *_penaltyPoints)
+                                        const TeamingOptions *const _teamingOptions, RequiredTeammatesCriterion *criterion, float *_criterionScore, int *_penaltyPoints,
+                                       const std::set<long long> *_IDsBeingTeamed)
 {
-    std::set<long long> IDsBeingTeamed, IDsOnTeam, requestedIDsByStudent;
+    std::set<long long> IDsOnTeam, requestedIDsByStudent;
     std::multiset<long long> requiredIDsOnTeam, preventedIDsOnTeam;   //multiset so that penalties are in proportion to number of missed requirements
     std::vector< std::set<long long> > requestedIDs;  // each set is the requests of one student; vector is all the students on the team
 
     // Get all IDs being teamed (so that we can make sure we only check the requireds/prevented/requesteds that are actually within this teamset)
+    // These are given when only some of the teams in the set are being scored
+    std::set<long long> IDsInGenome;
     int studentNum = 0;
-    for(int team = 0; team < _numTeams; team++) {
-        for(int teammate = 0; teammate < _teamSizes[team]; teammate++) {
-            IDsBeingTeamed.insert(_students[_teammates[studentNum]].ID);
-            studentNum++;
+    if(_IDsBeingTeamed == nullptr) {
+        for(int team = 0; team < _numTeams; team++) {
+            for(int teammate = 0; teammate < _teamSizes[team]; teammate++) {
+                IDsInGenome.insert(_students[_teammates[studentNum]].ID);
+                studentNum++;
+            }
         }
     }
+    const std::set<long long> &IDsBeingTeamed = ((_IDsBeingTeamed != nullptr)? *_IDsBeingTeamed : IDsInGenome);
 
     // Loop through each team
     studentNum = 0;
@@ -3601,14 +3954,19 @@ void gruepr::getRequiredTeammatesScore(const StudentRecord *const _students, con
             currStudent = &_students[_teammates[studentNum]];
             IDsOnTeam.insert(currStudent->ID);
             requestedIDsByStudent.clear();
-            for(const auto ID : IDsBeingTeamed) {
-                if(currStudent->requiredWith.contains(ID)) {
+            // go through this student's own (short) lists rather than through everyone being teamed
+            for(const auto ID : currStudent->requiredWith) {
+                if(IDsBeingTeamed.count(ID) != 0) {
                     requiredIDsOnTeam.insert(ID);
                 }
-                if(currStudent->preventedWith.contains(ID)) {
+            }
+            for(const auto ID : currStudent->preventedWith) {
+                if(IDsBeingTeamed.count(ID) != 0) {
                     preventedIDsOnTeam.insert(ID);
                 }
-                if(currStudent->requestedWith.contains(ID)) {
+            }
+            for(const auto ID : currStudent->requestedWith) {
+                if(IDsBeingTeamed.count(ID) != 0) {
                     requestedIDsByStudent.insert(ID);
                 }
             }
@@ -3634,20 +3992,26 @@ void gruepr::getRequiredTeammatesScore(const StudentRecord *const _students, con
 }
 
 void gruepr::getRequestedTeammatesScore(const StudentRecord *const _students, const int _teammates[], const int _numTeams, const int _teamSizes[],
-                                        const TeamingOptions *const _teamingOptions, RequestedTeammatesCriterion *criterion, float *_criterionScore, int *_penaltyPoints)
+                                        const TeamingOptions *const _teamingOptions, RequestedTeammatesCriterion *criterion, float *_criterionScore, int *_penaltyPoints,
+                                        const std::set<long long> *_IDsBeingTeamed)
 {
-    std::set<long long> IDsBeingTeamed, IDsOnTeam, requestedIDsByStudent;
+    std::set<long long> IDsOnTeam, requestedIDsByStudent;
     std::multiset<long long> requiredIDsOnTeam, preventedIDsOnTeam;   //multiset so that penalties are in proportion to number of missed requirements
     std::vector< std::set<long long> > requestedIDs;  // each set is the requests of one student; vector is all the students on the team
 
     // Get all IDs being teamed (so that we can make sure we only check the requireds/prevented/requesteds that are actually within this teamset)
+    // These are given when only some of the teams in the set are being scored
+    std::set<long long> IDsInGenome;
     int studentNum = 0;
-    for(int team = 0; team < _numTeams; team++) {
-        for(int teammate = 0; teammate < _teamSizes[team]; teammate++) {
-            IDsBeingTeamed.insert(_students[_teammates[studentNum]].ID);
-            studentNum++;
+    if(_IDsBeingTeamed == nullptr) {
+        for(int team = 0; team < _numTeams; team++) {
+            for(int teammate = 0; teammate < _teamSizes[team]; teammate++) {
+                IDsInGenome.insert(_students[_teammates[studentNum]].ID);
+                studentNum++;
+            }
         }
     }
+    const std::set<long long> &IDsBeingTeamed = ((_IDsBeingTeamed != nullptr)? *_IDsBeingTeamed : IDsInGenome);
 
     // Loop through each team
     studentNum = 0;
@@ -3662,14 +4026,19 @@ void gruepr::getRequestedTeammatesScore(const StudentRecord *const _students, co
             currStudent = &_students[_teammates[studentNum]];
             IDsOnTeam.insert(currStudent->ID);
             requestedIDsByStudent.clear();
-            for(const auto ID : IDsBeingTeamed) {
-                if(currStudent->requiredWith.contains(ID)) {
+            // go through this student's own (short) lists rather than through everyone being teamed
+            for(const auto ID : currStudent->requiredWith) {
+                if(IDsBeingTeamed.count(ID) != 0) {
                     requiredIDsOnTeam.insert(ID);
                 }
-                if(currStudent->preventedWith.contains(ID)) {
+            }
+            for(const auto ID : currStudent->preventedWith) {
+                if(IDsBeingTeamed.count(ID) != 0) {
                     preventedIDsOnTeam.insert(ID);
                 }
-                if(currStudent->requestedWith.contains(ID)) {
+            }
+            for(const auto ID : currStudent->requestedWith) {
+                if(IDsBeingTeamed.count(ID) != 0) {
                     requestedIDsByStudent.insert(ID);
                 }
             }
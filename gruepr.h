@@ -13,16 +13,22 @@
 #include "csvfile.h"
 #include "dataOptions.h"
 #include "dialogs/progressDialog.h"
+#include "generationSnapshot.h"
 #include "gruepr_globals.h"
+#include "saveStateFile.h"
+#include "studentNameIndex.h"
 #include "studentRecord.h"
 #include "teamRecord.h"
 #include "teamingOptions.h"
 #include "widgets/attributeWidget.h"
 #include "widgets/boxwhiskerplot.h"
 #include "widgets/groupingCriteriaCardWidget.h"
+#include "widgets/teamsTabItem.h"
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QJsonArray>
 #include <QPrinter>
+#include <QTimer>
 
 
 namespace Ui {class gruepr;}
@@ -42,8 +48,37 @@ public:
     gruepr(gruepr&&) = delete;
     gruepr& operator= (gruepr&&) = delete;
 
-    static void calcTeamScores(const QList<StudentRecord> &_students, const long long _numStudents,
-                               TeamSet &_teams, const TeamingOptions *const _teamingOptions);
+    static void calcTeamScores(const StudentList &_students, TeamSet &_teams, const TeamingOptions *const _teamingOptions);
+    static void calcTeamScores(const StudentList &_students, TeamSet &_teams, const TeamingOptions *const _teamingOptions, const QList<int> &_teamsToScore,
+                               const std::set<long long> *_IDsBeingTeamed);
+    struct TeamScores {float score = 0; float criterionScores[MAX_CRITERIA] = {}; int penaltyPoints = 0;};
+    static QList<TeamScores> scoreTeams(const StudentList &_students, const QList<QList<long long>> &_teamsStudentIDs,
+                                        const TeamingOptions *const _teamingOptions, const DataOptions *const _dataOptions,
+                                        const std::set<long long> *_IDsBeingTeamed = nullptr);
+    // Scores teams given as a genome of student indexes, over and over, into buffers allocated just once (e.g., for each of the many
+    // hypothetical teams one thread considers). Each thread needs its own scorer, and the students and options must outlive it.
+    class TeamScorer
+    {
+    public:
+        TeamScorer(const StudentRecord *const _students, const TeamingOptions *const _teamingOptions, const DataOptions *const _dataOptions,
+                   const std::set<long long> *_IDsBeingTeamed, const int _maxNumTeams);
+        const float *score(const int _teammates[], const int _numTeams, const int _teamSizes[]);    // each team's score, valid until the next call
+        float criterionScore(const int criterion, const int team) const {return criterionScores[criterion][team];};    // weighted
+        int penaltyPoints(const int team) const {return teamPenaltyPoints[team];};
+
+    private:
+        const StudentRecord *students;
+        const TeamingOptions *teamingOptions;
+        const DataOptions *dataOptions;
+        const std::set<long long> *IDsBeingTeamed;
+        int maxNumTeams;
+        std::unique_ptr<float[]> teamScores;
+        std::unique_ptr<float[]> criterionScoreValues;
+        std::unique_ptr<float*[]> criterionScores;
+        std::unique_ptr<bool[]> availabilityValues;
+        std::unique_ptr<bool*[]> availabilityChart;
+        std::unique_ptr<int[]> teamPenaltyPoints;
+    };
 
     bool restartRequested = false;
 
@@ -53,8 +88,6 @@ public:
 
 signals:
     void closed();
-    void generationComplete(const float *const allScores, const int *const orderedIndex,
-                            const int generation, const float scoreStability, const bool unpenalizedGenomePresent);
     void sectionOptimizationFullyComplete();
     void turnOffBusyCursor();
 
@@ -65,12 +98,12 @@ private slots:
     void restartWithNewData();
     void changeSection(int index);
     void editSectionNames();
-    void editAStudent();
-    void removeAStudent(const QString &name);
+    void editAStudent(const long long ID);
     void removeAStudent(const long long ID, const bool delayVisualUpdate = false);
     void addAStudent();
     void compareStudentsToRoster();
-    void rebuildDuplicatesTeamsizeURMAndSectionDataAndRefreshStudentTable();
+    void addNewSurveyResponses();
+    void rebuildTeamsizeURMAndSectionDataAndRefreshStudentTable();
     void simpleUIItemUpdate(QObject *sender = nullptr);
     void selectURMResponses();
     void responsesRulesButton_clicked(int attribute, int tabIndex);
@@ -78,8 +111,7 @@ private slots:
     void chooseTeamSizes(int index);
     void makeTeammatesRules();
     void startOptimization();
-    void updateOptimizationProgress(const float *const allScores, const int *const orderedIndex,
-                                    const int generation, const float scoreStability, const bool unpenalizedGenomePresent);
+    void updateOptimizationProgress();
     void optimizationComplete();
     void dataDisplayTabClose(int closingTabIndex);
     void editDataDisplayTabName(int tabIndex);
@@ -92,7 +124,9 @@ private:
     Ui::gruepr *ui;
     void loadDefaultSettings();
     void loadUI();
-    DataOptions *dataOptions = nullptr;
+    DataOptions *dataOptions = nullptr;                 // the working copy, updated as students are added, edited, and removed
+    std::shared_ptr<const DataOptions> publishedDataOptions;    // immutable copy of dataOptions given to team sets; reset whenever dataOptions changes
+    std::shared_ptr<const DataOptions> publishDataOptions();    // returns publishedDataOptions, first making a new copy if dataOptions has changed
     TeamingOptions *teamingOptions = nullptr;
     int numTeams = 1;
     inline void setTeamSizes(const QList<int> &teamSizes);
@@ -101,9 +135,11 @@ private:
 
         // reading survey data
     long long numActiveStudents = MAX_STUDENTS;
-    QList<StudentRecord> students;
-    inline StudentRecord* findStudentFromID(const long long ID);
+    StudentList students;
     bool loadRosterData(CsvFile &rosterFile, QStringList &names, QStringList &emails);   // returns false if file is invalid; checks survey names and emails against roster
+    void setAttributeValsFromResponses(StudentRecord &student);
+    void tallyAttributeResponses(const StudentRecord &student, const int change);
+    void markDataOptionsChanged();                      // drops the published copy of dataOptions and gives the working copy a new version
     void refreshStudentDisplay();
     int prevSortColumn = 0;                             // column sorting the student table, used when trying to sort by edit info or remove student column
     Qt::SortOrder prevSortOrder = Qt::AscendingOrder;   // order of sorting the student table, used when trying to sort by edit info or remove student column
@@ -111,17 +147,55 @@ private:
     QList<AttributeWidget *> attributeWidgets = {};
     QList<GroupingCriteriaCard *> initializedAttributeCriteriaCards = {};
     QList<CriteriaType> teammateRulesExistence;
+        // finding duplicate students--those with the same name or email address as another; kept up to date as each student is marked as changed
+    struct DuplicateCheckKeys {QString name; QString email;};
+    QList<DuplicateCheckKeys> duplicateCheckKeys;                 // by index, the keys each student is listed under; empty for deleted students
+    QMultiHash<QString, int> studentsWithName;                    // keys are normalized as in StudentNameIndex, values are indexes
+    QMultiHash<QString, int> studentsWithEmail;
+    void rebuildDuplicateCheck();
+    void updateDuplicateCheck(const int index);
+    std::shared_ptr<const StudentNameIndex> nameIndex;            // dropped whenever a student's listing changes, and rebuilt when next needed
+    std::shared_ptr<const StudentNameIndex> studentNameIndex();
         // team set optimization
     QList<int> studentIndexes;                                    // the indexes of students to be placed on teams
     QList<int> optimizeTeams(const QList<int> studentIndexes);    // return value is a single permutation-of-indexes
     QFuture< QList<int> > future;                                 // needed so that optimization can happen in a separate thread
     QFutureWatcher< QList<int> > futureWatcher;                   // used for signaling of optimization completion
+        // saving state
+    // each change marks the students and team sets it changed, and only those are converted to JSON and journaled
+    struct SaveStateSnapshot {QJsonObject teamingOptions; QJsonObject dataOptions;
+                              StudentList students; QSet<int> changedStudents; bool allStudentsChanged = false;
+                              int numTeamSets = 0; QMap<int, TeamsTabItem::SavedContents> changedTeamSets; bool allTeamSetsChanged = false;};
+    void markStudentChanged(const int index);
+    void markAllStudentsChanged();
+    void markTeamSetChanged(TeamsTabItem *teamTab);
+    void connectTeamTab(TeamsTabItem *teamTab);
+    QSet<int> changedStudents;                                    // changes marked since the last call to saveState()
+    bool allStudentsChanged = true;
+    QSet<TeamsTabItem *> changedTeamSets;
+    bool allTeamSetsChanged = true;
+    SaveStateSnapshot pendingSaveState;                           // most recent state requested to be saved but not yet handed to the writer thread
+    bool saveStateIsPending = false;
+    SaveStateFile saveStateFile;                                  // only used by the writer thread while a write is running
+    struct SaveStateResult {bool saved = false; qint64 msecsTaken = 0;};     // msecsTaken is the time spent converting to JSON and writing
+    QFutureWatcher<SaveStateResult> saveStateWatcher;             // used for signaling of save completion
+    void startSaveStateWrite();
+    static SaveStateResult writeSaveState(SaveStateFile *const saveStateFile, const QString &fileName, const SaveStateSnapshot &snapshot);
+    void saveStateWritten();
+    int numSaveStateFailures = 0;                                 // consecutive failed writes; the user is told once this reaches MAXSAVESTATEFAILURES
+    inline static const int MAXSAVESTATEFAILURES = 3;
+    inline static const int SAVEDMESSAGEDURATION = 3000;         // ms that the time taken by a save is shown in the status bar
+    void updatePrevWorksList();
     BoxWhiskerPlot *progressChart = nullptr;
     progressDialog *progressWindow = nullptr;
+    GenerationSnapshotChannel generationSnapshots;                // summary of each generation, passed from the optimization thread to the UI
+    QTimer progressDisplayTimer;                                  // polls generationSnapshots while optimizing
+    inline static const int PROGRESSDISPLAYINTERVAL = 16;         // msec, about the display refresh rate
     GA ga;                                                        // class for genetic algorithm optimization
     static float getGenomeScore(const StudentRecord *const _students, const int _teammates[], const int _numTeams, const int _teamSizes[],
                                 const TeamingOptions *const _teamingOptions, const DataOptions *const _dataOptions,
-                                float _teamScores[], float **_criterionScore, bool **_availabilityChart, int *_penaltyPoints);
+                                float _teamScores[], float **_criterionScore, bool **_availabilityChart, int *_penaltyPoints,
+                                const std::set<long long> *_IDsBeingTeamed = nullptr);
     inline static void getAttributeScore(const StudentRecord *const _students, const int _teammates[], const int _numTeams, const int _teamSizes[],
                                          const TeamingOptions *const _teamingOptions, const DataOptions *const _dataOptions, MultipleChoiceStyleCriterion *criterion, float *_criterionScore,
                                          const int attribute, std::multiset<int> &attributeLevelsInTeam, std::multiset<float> &timezoneLevelsInTeam,
@@ -142,11 +216,11 @@ private:
     inline static void getSingleURMScore(const StudentRecord *const _students, const int _teammates[], const int _numTeams, const int _teamSizes[],
                                          const TeamingOptions *const _teamingOptions, SingleURMIdentityCriterion *criterion, float *_criterionScore, int *_penaltyPoints);
     inline static void getPreventedTeammatesScore(const StudentRecord *const _students, const int _teammates[], const int _numTeams, const int _teamSizes[],
-                                         const TeamingOptions *const _teamingOptions, PreventedTeammatesCriterion *criterion, float *_criterionScore, int *_penaltyPoints);
+                                         const TeamingOptions *const _teamingOptions, PreventedTeammatesCriterion *criterion, float *_criterionScore, int *_penaltyPoints, const std::set<long long> *_IDsBeingTeamed);
     inline static void getRequiredTeammatesScore(const StudentRecord *const _students, const int _teammates[], const int _numTeams, const int _teamSizes[],
-                                                 const TeamingOptions *const _teamingOptions, RequiredTeammatesCriterion *criterion, float *_criterionScore, int *_penaltyPoints);
+                                                 const TeamingOptions *const _teamingOptions, RequiredTeammatesCriterion *criterion, float *_criterionScore, int *_penaltyPoints, const std::set<long long> *_IDsBeingTeamed);
     inline static void getRequestedTeammatesScore(const StudentRecord *const _students, const int _teammates[], const int _numTeams, const int _teamSizes[],
-                                                 const TeamingOptions *const _teamingOptions, RequestedTeammatesCriterion *criterion, float *_criterionScore, int *_penaltyPoints);
+                                                 const TeamingOptions *const _teamingOptions, RequestedTeammatesCriterion *criterion, float *_criterionScore, int *_penaltyPoints, const std::set<long long> *_IDsBeingTeamed);
     inline static void getScheduleScore(const StudentRecord *const _students, const int _teammates[], const int _numTeams, const int _teamSizes[],
                                                   const TeamingOptions *const _teamingOptions, const DataOptions *const _dataOptions, ScheduleCriterion *criterion, float *_criterionScore, bool **_availabilityChart, int *_penaltyPoints);
     float teamSetScore = 0;
@@ -7,7 +7,7 @@
 gruepr_version = 12.8
 copyright_year = 2019-2025
 
-QT       += core gui widgets concurrent network printsupport charts networkauth
+QT       += core gui widgets concurrent network printsupport networkauth
 QT       += designer
 
 TARGET = gruepr
@@ -74,6 +74,7 @@ SOURCES += \
         CriterionTypes/schedulecriterion.cpp \
         CriterionTypes/singlegendercriterion.cpp \
         CriterionTypes/singleurmidentitycriterion.cpp \
+        attributeValues.cpp \
         csvfile.cpp \
         dataOptions.cpp \
         dialogs/categorizingdialog.cpp \
@@ -83,9 +84,13 @@ SOURCES += \
         gruepr_globals.cpp \
         gruepr.cpp \
         GA.cpp \
+        generationSnapshot.cpp \
+        internedString.cpp \
         Levenshtein.cpp \
         main.cpp \
+        studentNameIndex.cpp \
         studentRecord.cpp \
+        saveStateFile.cpp \
         surveyMakerWizard.cpp \
         teamRecord.cpp \
         teamingOptions.cpp \
@@ -97,14 +102,15 @@ SOURCES += \
         dialogs/dayNamesDialog.cpp \
         dialogs/editOrAddStudentDialog.cpp \
         dialogs/editSectionNamesDialog.cpp \
-        dialogs/findMatchingNameDialog.cpp \
         dialogs/gatherURMResponsesDialog.cpp \
         dialogs/getGrueprDataDialog.cpp \
         dialogs/listTableDialog.cpp \
         dialogs/progressDialog.cpp \
         dialogs/registerDialog.cpp \
+        dialogs/rosterReconciliationDialog.cpp \
         dialogs/sampleQuestionsDialog.cpp \
         dialogs/startDialog.cpp \
+        dialogs/teammateNamesReconciliationDialog.cpp \
         dialogs/teammatesRulesDialog.cpp \
         dialogs/whichFilesDialog.cpp \
         LMS/LMS.cpp \
@@ -118,7 +124,6 @@ SOURCES += \
         widgets/labelThatForwardsMouseClicks.cpp \
         widgets/labelWithInstantTooltip.cpp \
         widgets/pushButtonWithMouseEnter.cpp \
-        widgets/sortableTableWidgetItem.cpp \
         widgets/studentTableWidget.cpp \
         widgets/surveyMakerQuestion.cpp \
         widgets/switchButton.cpp \
@@ -135,6 +140,7 @@ HEADERS += \
         CriterionTypes/schedulecriterion.h \
         CriterionTypes/singlegendercriterion.h \
         CriterionTypes/singleurmidentitycriterion.h \
+        attributeValues.h \
         csvfile.h \
         dataOptions.h \
         dialogs/categorizingdialog.h \
@@ -143,9 +149,13 @@ HEADERS += \
         dialogs/loaddatadialog.h \
         gruepr.h \
         GA.h \
+        generationSnapshot.h \
         gruepr_globals.h \
+        internedString.h \
         Levenshtein.h \
+        studentNameIndex.h \
         studentRecord.h \
+        saveStateFile.h \
         survey.h \
         surveyMakerWizard.h \
         teamRecord.h \
@@ -158,14 +168,15 @@ HEADERS += \
         dialogs/dayNamesDialog.h \
         dialogs/editOrAddStudentDialog.h \
         dialogs/editSectionNamesDialog.h \
-        dialogs/findMatchingNameDialog.h \
         dialogs/gatherURMResponsesDialog.h \
         dialogs/getGrueprDataDialog.h \
         dialogs/listTableDialog.h \
         dialogs/progressDialog.h \
         dialogs/registerDialog.h \
+        dialogs/rosterReconciliationDialog.h \
         dialogs/sampleQuestionsDialog.h \
         dialogs/startDialog.h \
+        dialogs/teammateNamesReconciliationDialog.h \
         dialogs/teammatesRulesDialog.h \
         dialogs/whichFilesDialog.h \
         LMS/LMS.h \
@@ -179,7 +190,6 @@ HEADERS += \
         widgets/labelThatForwardsMouseClicks.h \
         widgets/labelWithInstantTooltip.h \
         widgets/pushButtonWithMouseEnter.h \
-        widgets/sortableTableWidgetItem.h \
         widgets/studentTableWidget.h \
         widgets/surveyMakerQuestion.h \
         widgets/switchButton.h \
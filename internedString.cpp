@@ -0,0 +1,56 @@
+#include "internedString.h"
+#include <QtAlgorithms>
+
+std::atomic<QString *> InternedString::blocks[MAXBLOCKS] = {};
+int InternedString::numStrings = 1;
+QHash<QString, int> InternedString::IDs = {{"", InternedString::EMPTYSTRINGID}};
+QReadWriteLock InternedString::lock;
+
+
+QString InternedString::toString() const
+{
+    if(ID == EMPTYSTRINGID) {
+        return {};
+    }
+    // the block number is the position of the highest set bit in (ID + FIRSTBLOCKSIZE), and the index within the block is the remaining bits
+    const quint32 position = quint32(ID) + FIRSTBLOCKSIZE;
+    const int highestBit = 31 - int(qCountLeadingZeroBits(position));
+    return blocks[highestBit - FIRSTBLOCKBITS].load(std::memory_order_acquire)[position - (1U << highestBit)];
+}
+
+
+int InternedString::intern(const QString &string)
+{
+    {
+        const QReadLocker locker(&lock);
+        const auto existing = IDs.constFind(string);
+        if(existing != IDs.constEnd()) {
+            return existing.value();
+        }
+    }
+
+    const QWriteLocker locker(&lock);
+    // check again, in case another thread added it while unlocked
+    const auto existing = IDs.constFind(string);
+    if(existing != IDs.constEnd()) {
+        return existing.value();
+    }
+    const int newID = numStrings;
+    const quint32 position = quint32(newID) + FIRSTBLOCKSIZE;
+    const int highestBit = 31 - int(qCountLeadingZeroBits(position));
+    std::atomic<QString *> &block = blocks[highestBit - FIRSTBLOCKBITS];
+    if(block.load(std::memory_order_relaxed) == nullptr) {
+        block.store(new QString[1U << highestBit], std::memory_order_release);
+    }
+    block.load(std::memory_order_relaxed)[position - (1U << highestBit)] = string;
+    IDs.insert(string, newID);
+    numStrings++;
+    return newID;
+}
+
+
+int InternedString::find(const QString &string)
+{
+    const QReadLocker locker(&lock);
+    return IDs.value(string, NOTINTERNED);
+}
@@ -0,0 +1,65 @@
+#ifndef INTERNEDSTRING_H
+#define INTERNEDSTRING_H
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <atomic>
+
+/**
+ * @brief The InternedString class stores a string as a small integer ID into a session-wide pool of distinct strings.
+ * It is used for the survey responses that repeat across many students (section, race/ethnicity/culture response, and
+ * multiple choice responses), so that each distinct response is stored just once, and so that comparing and filtering by
+ * these responses are integer operations. It converts implicitly to QString wherever the text is needed.
+ * The pool only grows, and it may be used from multiple threads; getting the text of an interned string takes no lock.
+ */
+class InternedString
+{
+public:
+    InternedString() = default;
+    explicit InternedString(const QString &string) : ID(intern(string)) {};
+    InternedString &operator=(const QString &string) {ID = intern(string); return *this;};
+
+    /**
+     * @brief id The ID of this string in the pool; the empty string is always ID 0.
+     */
+    int id() const {return ID;};
+    QString toString() const;
+    operator QString() const {return toString();};
+    bool isEmpty() const {return ID == EMPTYSTRINGID;};
+    void clear() {ID = EMPTYSTRINGID;};
+
+    friend bool operator==(const InternedString &a, const InternedString &b) {return a.ID == b.ID;};
+    friend bool operator!=(const InternedString &a, const InternedString &b) {return a.ID != b.ID;};
+    friend size_t qHash(const InternedString &string, size_t seed = 0) {return qHash(string.ID, seed);};
+
+    /**
+     * @brief intern Adds a string to the pool, if it is not there already.
+     * @return The ID of the string.
+     */
+    static int intern(const QString &string);
+
+    /**
+     * @brief find Looks up a string in the pool without adding it.
+     * @return The ID of the string, or NOTINTERNED if it is not in the pool.
+     */
+    static int find(const QString &string);
+
+    inline static const int NOTINTERNED = -1;
+
+private:
+    int ID = EMPTYSTRINGID;
+
+    // the strings, indexed by ID, are stored in blocks that are never moved or freed once allocated, so they can be read without locking;
+    // block n holds (FIRSTBLOCKSIZE << n) strings, so MAXBLOCKS blocks hold every possible int ID
+    inline static const int FIRSTBLOCKBITS = 6;
+    inline static const quint32 FIRSTBLOCKSIZE = 1U << FIRSTBLOCKBITS;
+    inline static const int MAXBLOCKS = 32 - FIRSTBLOCKBITS;
+    static std::atomic<QString *> blocks[MAXBLOCKS];
+    static int numStrings;                  // guarded by lock, as are IDs
+    static QHash<QString, int> IDs;
+    static QReadWriteLock lock;
+    inline static const int EMPTYSTRINGID = 0;
+};
+
+#endif // INTERNEDSTRING_H
@@ -0,0 +1,446 @@
+#include "saveStateFile.h"
+#include <QCborValue>
+#include <QDataStream>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QtConcurrentRun>
+#include <algorithm>
+
+
+SaveStateFile::~SaveStateFile()
+{
+    waitForCompaction();
+    close();
+}
+
+
+void SaveStateFile::setSection(Section section, const QJsonValue &contents)
+{
+    auto currentContents = sections.find(section);
+    if(currentContents == sections.end()) {
+        sections.insert(section, contents);
+    }
+    else if(*currentContents != contents) {
+        *currentContents = contents;
+    }
+    else {
+        return;
+    }
+    if(!changedSections.contains(section)) {
+        changedSections << section;
+    }
+    changedElements.remove(section);
+}
+
+
+void SaveStateFile::setElement(Section section, int index, int count, const QJsonValue &contents)
+{
+    // take the array out of the map so that it is not shared while being modified
+    QJsonArray array = sections.take(section).toArray();
+    while(array.size() < count) {
+        array.append(QJsonValue());
+    }
+    while(array.size() > count) {
+        array.removeLast();
+    }
+    if((index >= 0) && (index < count)) {
+        array[index] = contents;
+    }
+    sections.insert(section, array);
+
+    if((index >= 0) && (index < count) && !changedSections.contains(section)) {
+        QSet<int> &changedIndexes = changedElements[section];
+        changedIndexes << index;
+        if(changedIndexes.size() > (count / 2)) {
+            // record the whole section instead of most of its elements
+            changedSections << section;
+            changedElements.remove(section);
+        }
+    }
+}
+
+
+QString SaveStateFile::sectionKey(Section section)
+{
+    switch(section) {
+    case Section::teamingOptions:
+        return "teamingoptions";
+    case Section::dataOptions:
+        return "dataoptions";
+    case Section::students:
+        return "students";
+    case Section::teamSets:
+        return "teamsets";
+    }
+    return "";
+}
+
+
+//////////////////
+// Write a snapshot file: a header (magic number, version, last included journal record, and table of contents), followed by each section as CBOR
+//////////////////
+bool SaveStateFile::writeSnapshot(const QString &fileName, const QMap<Section, QJsonValue> &sections, qint64 sequenceNumber)
+{
+    QSaveFile saveFile(fileName);
+    if(!saveFile.open(QIODeviceBase::WriteOnly)) {
+        return false;
+    }
+
+    QList<QByteArray> encodedSections;
+    encodedSections.reserve(sections.size());
+    for(const auto &contents : sections) {
+        encodedSections << QCborValue::fromJsonValue(contents).toCbor();
+    }
+
+    const int numSections = int(sections.size());
+    const qint64 headerSize = 3 * sizeof(quint32) + sizeof(qint64) + numSections * (sizeof(quint32) + 2 * sizeof(qint64));
+    QByteArray header;
+    QDataStream headerStream(&header, QIODeviceBase::WriteOnly);
+    headerStream.setVersion(QDataStream::Qt_6_0);
+    headerStream << MAGICNUMBER << FORMATVERSION << sequenceNumber << quint32(numSections);
+    qint64 offset = headerSize;
+    int sectionNum = 0;
+    for(auto section = sections.constBegin(); section != sections.constEnd(); section++, sectionNum++) {
+        const qint64 length = encodedSections.at(sectionNum).size();
+        headerStream << quint32(section.key()) << offset << length;
+        offset += length;
+    }
+
+    saveFile.write(header);
+    for(const auto &encodedSection : qAsConst(encodedSections)) {
+        saveFile.write(encodedSection);
+    }
+    return saveFile.commit();
+}
+
+
+//////////////////
+// Save the sections, either as a full snapshot (the first time) or as journal records of whatever has changed since the last save
+//////////////////
+bool SaveStateFile::saveChanges(const QString &fileName)
+{
+    if(savedFileName.isEmpty() || (fileName != savedFileName)) {
+        // nothing from this session is on disk yet, so write a full snapshot that includes anything replayed from an old journal
+        waitForCompaction();
+        const qint64 sequenceNumber = nextSequenceNumber();
+        if(!writeSnapshot(fileName, sections, sequenceNumber)) {
+            return false;
+        }
+        QFile::remove(journalFileName(fileName));
+        QFile::remove(compactingJournalFileName(fileName));
+        savedFileName = fileName;
+        changedSections.clear();
+        changedElements.clear();
+        numJournalRecords = 0;
+        return true;
+    }
+
+    int numRecords = 0;
+    const QByteArray records = journalRecordsForChanges(numRecords);
+    if(records.isEmpty()) {
+        return true;
+    }
+
+    QFile journal(journalFileName(fileName));
+    if(!journal.open(QIODeviceBase::WriteOnly | QIODeviceBase::Append)) {
+        return false;
+    }
+    const bool writeOK = (journal.write(records) == records.size());
+    journal.close();
+    if(!writeOK) {
+        return false;
+    }
+    changedSections.clear();
+    changedElements.clear();
+    numJournalRecords += numRecords;
+
+    if((numJournalRecords >= COMPACTIONTHRESHOLD) && !compaction.isRunning()) {
+        // set the journal aside so that new records go to a fresh one while the snapshot is written in the background
+        QFile compactingJournal(compactingJournalFileName(fileName));
+        if(compactingJournal.exists()) {
+            // an earlier compaction did not finish, so keep its records along with these
+            if(journal.open(QIODeviceBase::ReadOnly) && compactingJournal.open(QIODeviceBase::WriteOnly | QIODeviceBase::Append)) {
+                compactingJournal.write(journal.readAll());
+                compactingJournal.close();
+                journal.close();
+                journal.remove();
+            }
+        }
+        else {
+            journal.rename(compactingJournal.fileName());
+        }
+        compaction = QtConcurrent::run(&SaveStateFile::compact, fileName, sections, lastSequenceNumber);
+        numJournalRecords = 0;
+    }
+
+    return true;
+}
+
+
+//////////////////
+// Write a new snapshot and, once it is safely on disk, remove the journal records it includes (runs on a background thread)
+//////////////////
+bool SaveStateFile::compact(const QString &fileName, const QMap<Section, QJsonValue> &sections, qint64 sequenceNumber)
+{
+    if(!writeSnapshot(fileName, sections, sequenceNumber)) {
+        return false;
+    }
+    QFile::remove(compactingJournalFileName(fileName));
+    return true;
+}
+
+
+void SaveStateFile::waitForCompaction()
+{
+    if(compaction.isRunning()) {
+        compaction.waitForFinished();
+    }
+}
+
+
+//////////////////
+// Journal record sequence numbers are the save time in ms, kept strictly increasing, so that they also increase from one session to the next
+//////////////////
+qint64 SaveStateFile::nextSequenceNumber()
+{
+    lastSequenceNumber = std::max(lastSequenceNumber + 1, QDateTime::currentMSecsSinceEpoch());
+    return lastSequenceNumber;
+}
+
+
+//////////////////
+// The journal records for everything set since the last save: the whole of each section changed, or else each element changed
+//////////////////
+QByteArray SaveStateFile::journalRecordsForChanges(int &numRecords)
+{
+    QByteArray records;
+    for(const auto section : qAsConst(changedSections)) {
+        records += journalRecord(section, -1, 0, sections.value(section));
+        numRecords++;
+    }
+    for(auto changed = changedElements.constBegin(); changed != changedElements.constEnd(); changed++) {
+        const QJsonArray array = sections.value(changed.key()).toArray();
+        const int count = int(array.size());
+        for(const auto index : changed.value()) {
+            records += journalRecord(changed.key(), index, count, (index < count)? array.at(index) : QJsonValue());
+            numRecords++;
+        }
+    }
+    return records;
+}
+
+
+//////////////////
+// A journal record is its length followed by a CBOR map; index -1 means the contents replace the entire section
+//////////////////
+QByteArray SaveStateFile::journalRecord(Section section, int index, int count, const QJsonValue &contents)
+{
+    QCborMap record;
+    record[sequenceNumberField] = nextSequenceNumber();
+    record[sectionField] = int(section);
+    record[indexField] = index;
+    record[countField] = count;
+    record[contentsField] = QCborValue::fromJsonValue(contents);
+    const QByteArray encodedRecord = record.toCborValue().toCbor();
+
+    QByteArray lengthPrefixedRecord;
+    QDataStream recordStream(&lengthPrefixedRecord, QIODeviceBase::WriteOnly);
+    recordStream.setVersion(QDataStream::Qt_6_0);
+    recordStream << quint32(encodedRecord.size());
+    lengthPrefixedRecord += encodedRecord;
+    return lengthPrefixedRecord;
+}
+
+
+//////////////////
+// Open a file for reading, mapping it into memory and reading just the table of contents and any journal records not yet in the snapshot
+//////////////////
+bool SaveStateFile::open(const QString &fileName)
+{
+    close();
+
+    file = new QFile(fileName);
+    if(!file->open(QIODeviceBase::ReadOnly)) {
+        close();
+        return false;
+    }
+
+    mappedSize = file->size();
+    mappedData = file->map(0, mappedSize);
+    if(mappedData == nullptr) {
+        unmappedContents = file->readAll();
+        mappedData = reinterpret_cast<const uchar *>(unmappedContents.constData());
+        mappedSize = unmappedContents.size();
+    }
+
+    const QByteArray contents = QByteArray::fromRawData(reinterpret_cast<const char *>(mappedData), mappedSize);
+    QDataStream headerStream(contents);
+    headerStream.setVersion(QDataStream::Qt_6_0);
+    quint32 magicNumber = 0, version = 0, numSections = 0;
+    headerStream >> magicNumber >> version;
+
+    if(magicNumber != MAGICNUMBER) {
+        // this is for backwards compatability--save files were formerly a single JSON document
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(contents, &error);
+        if(error.error != QJsonParseError::NoError) {
+            close();
+            return false;
+        }
+        jsonContents = doc.object();
+        openedFileIsJson = true;
+        return true;
+    }
+
+    if(version > FORMATVERSION) {
+        close();
+        return false;
+    }
+
+    snapshotSequenceNumber = 0;
+    if(version >= 2) {
+        headerStream >> snapshotSequenceNumber;
+    }
+    headerStream >> numSections;
+    for(quint32 sectionNum = 0; sectionNum < numSections; sectionNum++) {
+        quint32 section = 0;
+        SectionLocation location;
+        headerStream >> section >> location.offset >> location.length;
+        if((headerStream.status() != QDataStream::Ok) || (location.offset < 0) || (location.length < 0) || (location.offset + location.length > mappedSize)) {
+            close();
+            return false;
+        }
+        tableOfContents[static_cast<Section>(section)] = location;
+    }
+
+    // a journal set aside for an unfinished compaction holds earlier records than the current journal
+    readJournal(compactingJournalFileName(fileName));
+    readJournal(journalFileName(fileName));
+
+    return true;
+}
+
+
+//////////////////
+// Read the records from a journal file, skipping those already in the snapshot and stopping at any incomplete record left by a crash
+//////////////////
+void SaveStateFile::readJournal(const QString &journalFile)
+{
+    QFile journal(journalFile);
+    if(!journal.open(QIODeviceBase::ReadOnly)) {
+        return;
+    }
+    const QByteArray journalContents = journal.readAll();
+    journal.close();
+
+    QDataStream journalStream(journalContents);
+    journalStream.setVersion(QDataStream::Qt_6_0);
+    qint64 position = 0;
+    while(position + qint64(sizeof(quint32)) <= journalContents.size()) {
+        quint32 length = 0;
+        journalStream >> length;
+        position += sizeof(quint32);
+        if(position + length > journalContents.size()) {
+            break;
+        }
+        QCborParserError error;
+        const QCborValue record = QCborValue::fromCbor(journalContents.mid(position, length), &error);
+        if((error.error != QCborError::NoError) || !record.isMap()) {
+            break;
+        }
+        journalStream.skipRawData(int(length));
+        position += length;
+
+        const QCborMap recordMap = record.toMap();
+        const qint64 sequenceNumber = recordMap.value(sequenceNumberField).toInteger();
+        if(sequenceNumber <= snapshotSequenceNumber) {
+            continue;
+        }
+        journalRecords[static_cast<Section>(recordMap.value(sectionField).toInteger())] << recordMap;
+    }
+}
+
+
+QJsonValue SaveStateFile::section(Section section) const
+{
+    if(openedFileIsJson) {
+        return jsonContents[sectionKey(section)];
+    }
+
+    QJsonValue contents(QJsonValue::Undefined);
+    const auto location = tableOfContents.constFind(section);
+    if((mappedData != nullptr) && (location != tableOfContents.constEnd())) {
+        const QByteArray encodedSection = QByteArray::fromRawData(reinterpret_cast<const char *>(mappedData + location->offset), location->length);
+        contents = QCborValue::fromCbor(encodedSection).toJsonValue();
+    }
+
+    // replay the journal over the snapshot
+    const QList<QCborMap> records = journalRecords.value(section);
+    for(const auto &record : records) {
+        const int index = int(record.value(indexField).toInteger());
+        const QJsonValue recordContents = record.value(contentsField).toJsonValue();
+        if(index < 0) {
+            contents = recordContents;
+            continue;
+        }
+        QJsonArray array = contents.toArray();
+        const int count = int(record.value(countField).toInteger());
+        while(array.size() < count) {
+            array.append(QJsonValue());
+        }
+        while(array.size() > count) {
+            array.removeLast();
+        }
+        if(index < count) {
+            array[index] = recordContents;
+        }
+        contents = array;
+    }
+
+    return contents;
+}
+
+
+//////////////////
+// Export as the earlier JSON format: one object with each section under its key
+//////////////////
+bool SaveStateFile::exportJson(const QString &fileName) const
+{
+    QJsonObject content;
+    for(const auto sectionToExport : {Section::teamingOptions, Section::dataOptions, Section::students, Section::teamSets}) {
+        const QJsonValue contents = section(sectionToExport);
+        if(!contents.isUndefined()) {
+            content[sectionKey(sectionToExport)] = contents;
+        }
+    }
+
+    QSaveFile saveFile(fileName);
+    if(!saveFile.open(QIODeviceBase::WriteOnly)) {
+        return false;
+    }
+    saveFile.write(QJsonDocument(content).toJson(QJsonDocument::Compact));
+    return saveFile.commit();
+}
+
+
+void SaveStateFile::close()
+{
+    if(file != nullptr) {
+        if(unmappedContents.isEmpty() && (mappedData != nullptr)) {
+            file->unmap(const_cast<uchar *>(mappedData));
+        }
+        file->close();
+        delete file;
+        file = nullptr;
+    }
+    mappedData = nullptr;
+    mappedSize = 0;
+    unmappedContents.clear();
+    tableOfContents.clear();
+    journalRecords.clear();
+    snapshotSequenceNumber = 0;
+    openedFileIsJson = false;
+    jsonContents = QJsonObject();
+}
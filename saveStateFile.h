@@ -0,0 +1,119 @@
+#ifndef SAVESTATEFILE_H
+#define SAVESTATEFILE_H
+
+#include <QCborMap>
+#include <QFile>
+#include <QFuture>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QList>
+#include <QMap>
+#include <QSet>
+
+/**
+ * @brief The SaveStateFile class reads and writes the file that holds a session of gruepr work for later re-opening.
+ * The file is a versioned binary container with a table of contents followed by one CBOR-encoded section each for the
+ * teaming options, data options, students, and teamsets. On reading, the file is memory-mapped and only the table of contents
+ * is read; each section is decoded when it is requested. Files in the earlier, single JSON document format are still read,
+ * and an opened file can be exported in that format.
+ *
+ * Changes made after the file is first written are appended to a journal file next to it, one small record per changed
+ * student, teamset, or options section. The caller sets only the elements that changed, so a save costs only as much as what changed.
+ * Once the journal is long enough it is compacted into a new snapshot in the background.
+ * Each journal record is numbered, and the snapshot stores the number of the last record it includes, so that on reading,
+ * the records not yet in the snapshot are replayed over it no matter where a previous session stopped.
+ */
+class SaveStateFile
+{
+public:
+    enum class Section {teamingOptions, dataOptions, students, teamSets};
+
+    SaveStateFile() = default;
+    ~SaveStateFile();
+    SaveStateFile(const SaveStateFile&) = delete;
+    SaveStateFile operator= (const SaveStateFile&) = delete;
+    SaveStateFile(SaveStateFile&&) = delete;
+    SaveStateFile& operator= (SaveStateFile&&) = delete;
+
+    /**
+     * @brief setSection Sets the entire contents of one section, to be written with saveChanges().
+     */
+    void setSection(Section section, const QJsonValue &contents);
+
+    /**
+     * @brief setElement Sets one element of a section that is an array (the students or teamsets), to be written with saveChanges().
+     * @param index The element changed.
+     * @param count The number of elements now in the section, so that the section can grow or shrink.
+     */
+    void setElement(Section section, int index, int count, const QJsonValue &contents);
+
+    /**
+     * @brief saveChanges Saves the sections that have been set. The first call writes a complete snapshot; later calls
+     * append only what has changed since the previous call to the journal, and start a background compaction when needed.
+     * @param fileName The save file.
+     * @return True if the changes were written successfully.
+     */
+    bool saveChanges(const QString &fileName);
+
+    /**
+     * @brief open Opens a save file for reading. Binary files are memory-mapped and only the table of contents and journal are read.
+     * @param fileName The file to read.
+     * @return True if the file was opened and is in a recognized format.
+     */
+    bool open(const QString &fileName);
+
+    /**
+     * @brief section Decodes and returns the contents of one section of the opened file, with any journaled changes applied.
+     * @return The contents, or an undefined QJsonValue if the section is not in the file.
+     */
+    QJsonValue section(Section section) const;
+
+    /**
+     * @brief exportJson Writes the opened file, with any journaled changes applied, as a single JSON document in the earlier format,
+     * which is readable by earlier versions of gruepr and can be opened again with open().
+     * @param fileName The file to write.
+     * @return True if the file was written successfully.
+     */
+    bool exportJson(const QString &fileName) const;
+
+    void close();
+
+private:
+    static QString sectionKey(Section section);     // key used for the section in the JSON format
+    QMap<Section, QJsonValue> sections;             // the current contents, as set; the arrays are kept unshared so that setting an element is O(1)
+    QList<Section> changedSections;                 // changes set since the last successful save
+    QMap<Section, QSet<int>> changedElements;
+    static bool writeSnapshot(const QString &fileName, const QMap<Section, QJsonValue> &sections, qint64 sequenceNumber);
+
+    QFile *file = nullptr;
+    const uchar *mappedData = nullptr;
+    qint64 mappedSize = 0;
+    QByteArray unmappedContents;                    // holds the file contents only if it could not be memory-mapped
+    struct SectionLocation {qint64 offset = 0; qint64 length = 0;};
+    QMap<Section, SectionLocation> tableOfContents;
+    bool openedFileIsJson = false;
+    QJsonObject jsonContents;
+
+    // journal
+    static QString journalFileName(const QString &fileName) {return fileName + ".journal";}
+    static QString compactingJournalFileName(const QString &fileName) {return fileName + ".journal.compacting";}
+    static bool compact(const QString &fileName, const QMap<Section, QJsonValue> &sections, qint64 sequenceNumber);
+    void readJournal(const QString &journalFile);
+    QByteArray journalRecordsForChanges(int &numRecords);
+    QByteArray journalRecord(Section section, int index, int count, const QJsonValue &contents);
+    qint64 nextSequenceNumber();
+    void waitForCompaction();
+    QString savedFileName;                          // empty until a snapshot has been written in this session
+    qint64 snapshotSequenceNumber = 0;
+    qint64 lastSequenceNumber = 0;
+    int numJournalRecords = 0;
+    QMap<Section, QList<QCborMap>> journalRecords;  // records read from the journal of the opened file, in order
+    QFuture<bool> compaction;
+    enum JournalRecordField {sequenceNumberField, sectionField, indexField, countField, contentsField};
+
+    inline static const quint32 MAGICNUMBER = 0x67727565;     // "grue"
+    inline static const quint32 FORMATVERSION = 2;            // version 2 added the journal sequence number to the header
+    inline static const int COMPACTIONTHRESHOLD = 250;        // number of journal records that triggers a compaction into a new snapshot
+};
+
+#endif // SAVESTATEFILE_H
@@ -0,0 +1,137 @@
+#include "studentNameIndex.h"
+#include "Levenshtein.h"
+#include <algorithm>
+#include <climits>
+
+namespace {
+    int exactDistance(const QString &source, const QString &target)
+    {
+        return levenshtein::boundedDistance(source, target, int(std::max(source.size(), target.size())));
+    }
+}
+
+
+StudentNameIndex::StudentNameIndex(const QList<StudentRecord> &students)
+{
+    nodes.reserve(students.size());
+    nodeOfName.reserve(students.size());
+    studentOfEmail.reserve(students.size());
+    for(const auto &student : students) {
+        if(student.deleted) {
+            continue;
+        }
+
+        const QString email = normalized(student.email);
+        if(!email.isEmpty() && !studentOfEmail.contains(email)) {
+            studentOfEmail.insert(email, student.ID);
+        }
+
+        const QString name = normalized(student.firstname + " " + student.lastname);
+        const auto existingNode = nodeOfName.constFind(name);
+        if(existingNode != nodeOfName.constEnd()) {
+            nodes[*existingNode].IDs << student.ID;
+            continue;
+        }
+        const int newNode = int(nodes.size());
+        nodes.append({name, {student.ID}, {}});
+        nodeOfName.insert(name, newNode);
+        if(newNode == 0) {
+            continue;
+        }
+
+        // walk down from the root, following the child at the same distance as the new name, until there is none
+        int node = 0;
+        while(true) {
+            const int distance = exactDistance(name, nodes.at(node).name);
+            const auto &children = nodes.at(node).children;
+            const auto child = std::find_if(children.cbegin(), children.cend(), [distance](const QPair<int, int> &c){return c.first == distance;});
+            if(child == children.cend()) {
+                nodes[node].children.append({distance, newNode});
+                break;
+            }
+            node = child->second;
+        }
+    }
+}
+
+
+QString StudentNameIndex::normalized(const QString &nameOrEmail)
+{
+    return nameOrEmail.simplified().toCaseFolded();
+}
+
+
+long long StudentNameIndex::findName(const QString &name) const
+{
+    const auto node = nodeOfName.constFind(normalized(name));
+    return ((node != nodeOfName.constEnd())? nodes.at(*node).IDs.constFirst() : -1);
+}
+
+
+long long StudentNameIndex::findEmail(const QString &email) const
+{
+    if(email.isEmpty()) {
+        return -1;
+    }
+    return studentOfEmail.value(normalized(email), -1);
+}
+
+
+QList<StudentNameIndex::Match> StudentNameIndex::closestNames(const QString &name, const int maxMatches, const QString &email) const
+{
+    QList<Match> matches;
+    if(maxMatches <= 0) {
+        return matches;
+    }
+    matches.reserve(maxMatches);
+
+    // a student with the same email address is the best match, no matter the name
+    const long long emailMatchID = findEmail(email);
+    if(emailMatchID != -1) {
+        matches.append({emailMatchID, 0});
+    }
+
+    // Keep a max-heap of the closest names so far, <distance, node index>. Once it is full, only a name closer than the farthest of them
+    // matters, and by the triangle inequality, such a name can only be below a child whose distance differs from its parent's by less than that.
+    const QString searchName = normalized(name);
+    QList<QPair<int, int>> closestNodes;
+    closestNodes.reserve(maxMatches + 1);
+    QList<int> nodesToVisit;
+    if(!nodes.isEmpty()) {
+        nodesToVisit << 0;
+    }
+    while(!nodesToVisit.isEmpty()) {
+        const int nodeIndex = nodesToVisit.takeLast();
+        const Node &node = nodes.at(nodeIndex);
+        const int distance = exactDistance(searchName, node.name);
+        const bool full = (closestNodes.size() == maxMatches);
+        if(!full || (distance < closestNodes.constFirst().first)) {
+            if(full) {
+                std::pop_heap(closestNodes.begin(), closestNodes.end());
+                closestNodes.removeLast();
+            }
+            closestNodes.append({distance, nodeIndex});
+            std::push_heap(closestNodes.begin(), closestNodes.end());
+        }
+
+        const int radius = ((closestNodes.size() == maxMatches)? closestNodes.constFirst().first - 1 : INT_MAX);
+        for(const auto &child : node.children) {
+            if(std::abs(child.first - distance) <= radius) {
+                nodesToVisit << child.second;
+            }
+        }
+    }
+    std::sort_heap(closestNodes.begin(), closestNodes.end());
+
+    for(const auto &closestNode : qAsConst(closestNodes)) {
+        for(const auto ID : nodes.at(closestNode.second).IDs) {
+            if(matches.size() == maxMatches) {
+                return matches;
+            }
+            if(ID != emailMatchID) {
+                matches.append({ID, closestNode.first});
+            }
+        }
+    }
+    return matches;
+}
@@ -0,0 +1,54 @@
+#ifndef STUDENTNAMEINDEX_H
+#define STUDENTNAMEINDEX_H
+
+#include "studentRecord.h"
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+
+/**
+ * @brief The StudentNameIndex class finds students by name or email address, exactly or approximately.
+ * It is built once from a list of students (skipping any that are deleted), and is then used for all of the names
+ * being looked up, e.g., every name in a roster or in a file of teammates. Exact lookups are hash lookups of the
+ * normalized name or email address. Approximate lookups search a BK-tree of the distinct normalized names by
+ * Levenshtein distance, pruning every branch that cannot hold a name closer than the closest ones found so far.
+ * The index does not change after it is built, so it may be searched from multiple threads at once.
+ */
+class StudentNameIndex
+{
+public:
+    struct Match {long long ID = -1; int distance = 0;};
+
+    explicit StudentNameIndex(const QList<StudentRecord> &students);
+
+    /**
+     * @brief normalized The form in which names and email addresses are compared: whitespace simplified and case folded.
+     */
+    static QString normalized(const QString &nameOrEmail);
+
+    /**
+     * @brief findName The ID of the first student with this name (as "firstname lastname"), or -1 if there is none.
+     */
+    long long findName(const QString &name) const;
+    /**
+     * @brief findEmail The ID of the first student with this email address, or -1 if there is none.
+     */
+    long long findEmail(const QString &email) const;
+    /**
+     * @brief closestNames The students whose names are closest to this one, closest first. If an email address is given
+     * and a student has it, that student comes first (at distance 0) no matter the name.
+     */
+    QList<Match> closestNames(const QString &name, int maxMatches = DEFAULT_NUM_MATCHES, const QString &email = "") const;
+
+    inline static const int DEFAULT_NUM_MATCHES = 10;
+
+private:
+    // Each node of the BK-tree is one distinct name, and each of its children is at a different distance from it
+    struct Node {QString name; QList<long long> IDs; QList<QPair<int, int>> children;};     // children are <distance, node index>
+    QList<Node> nodes;                          // nodes[0] is the root
+    QHash<QString, int> nodeOfName;
+    QHash<QString, long long> studentOfEmail;
+};
+
+#endif // STUDENTNAMEINDEX_H
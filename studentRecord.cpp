@@ -1,4 +1,5 @@
 #include "studentRecord.h"
+#include <QCryptographicHash>
 #include <QJsonArray>
 #include <QLocale>
 #include <QRegularExpression>
@@ -8,9 +9,7 @@ StudentRecord::StudentRecord()
     surveyTimestamp = QDateTime::currentDateTime();
 
     for(auto &day : unavailable) {
-        for(auto &time : day) {
-            time = true;
-        }
+        day.set();
     }
 }
 
@@ -42,9 +41,8 @@ StudentRecord::StudentRecord(const QJsonObject &jsonStudentRecord)
     prefTeammates = jsonStudentRecord["prefTeammates"].toString();
     prefNonTeammates = jsonStudentRecord["prefNonTeammates"].toString();
     notes = jsonStudentRecord["notes"].toString();
+    submission = jsonStudentRecord["submission"].toString();
     URMResponse = jsonStudentRecord["URMResponse"].toString();
-    availabilityChart = jsonStudentRecord["availabilityChart"].toString();
-    tooltip = jsonStudentRecord["tooltip"].toString();
     const QJsonArray unavailableArray = jsonStudentRecord["unavailable"].toArray();;
     for(int i = 0; i < MAX_DAYS; i++) {
         QJsonArray unavailableArraySubArray = unavailableArray[i].toArray();
@@ -126,9 +124,7 @@ void StudentRecord::clear() {
     gender = {Gender::unknown};
     URM = false;
     for(auto &day : unavailable) {
-        for(auto &time : day) {
-            time = true;
-        }
+        day.set();
     }
     timezone = 0;
     ambiguousSchedule = false;
@@ -147,9 +143,9 @@ void StudentRecord::clear() {
     prefTeammates.clear();
     prefNonTeammates.clear();
     notes.clear();
+    submission.clear();
     URMResponse.clear();
-    availabilityChart.clear();
-    tooltip.clear();
+    invalidateTooltip();
 }
 
 ////////////////////////////////////////////
@@ -157,40 +153,14 @@ void StudentRecord::clear() {
 ////////////////////////////////////////////
 void StudentRecord::parseRecordFromStringList(const QStringList &fields, const DataOptions &dataOptions)
 {
-    qDebug() << fields;
     const int numFields = fields.size();
 
+    submission = submissionFingerprint(fields);
+
     // Timestamp
     int fieldnum = dataOptions.timestampField;
     if((fieldnum >= 0) && (fieldnum < numFields)) {
-        const QString &timestampText = fields.at(fieldnum);
-        surveyTimestamp = QDateTime::fromString(timestampText.left(timestampText.lastIndexOf(' ')), TIMESTAMP_FORMAT1); // format with direct download from Google Form
-        if(surveyTimestamp.isNull()) {
-            surveyTimestamp = QDateTime::fromString(timestampText.left(timestampText.lastIndexOf(' ')), TIMESTAMP_FORMAT2); // alt format with direct download from Google Form
-            if(surveyTimestamp.isNull()) {
-                surveyTimestamp = QDateTime::fromString(timestampText.left(timestampText.lastIndexOf(' ')), Qt::ISODate); // format with direct download from Canvas
-                if(surveyTimestamp.isNull()) {
-                    surveyTimestamp = QDateTime::fromString(timestampText, TIMESTAMP_FORMAT3);
-                    if(surveyTimestamp.isNull()) {
-                        surveyTimestamp = QDateTime::fromString(timestampText, TIMESTAMP_FORMAT4);
-                        if(surveyTimestamp.isNull()) {
-                            surveyTimestamp = QLocale::system().toDateTime(timestampText, QLocale::ShortFormat);
-                            if(surveyTimestamp.isNull()) {
-                                surveyTimestamp = QLocale::system().toDateTime(timestampText, QLocale::LongFormat);
-                                if(surveyTimestamp.isNull()) {
-                                    int i = 0;
-                                    const QList<Qt::DateFormat> stdTimestampFormats = {Qt::TextDate, Qt::ISODate, Qt::ISODateWithMs, Qt::RFC2822Date};
-                                    while(i < stdTimestampFormats.size() && surveyTimestamp.isNull()) {
-                                        surveyTimestamp = QDateTime::fromString(timestampText, stdTimestampFormats.at(i));
-                                        i++;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        surveyTimestamp = parseTimestamp(fields.at(fieldnum));
     }
     if(surveyTimestamp.isNull()) {
         surveyTimestamp = QDateTime::currentDateTime();
@@ -352,7 +322,7 @@ void StudentRecord::parseRecordFromStringList(const QStringList &fields, const D
                     continue;   // something went wrong in figuring out where to put this value in the array!
                 }
 
-                bool &unavailabilitySpot = unavailable[actualday][timeindex];
+                auto unavailabilitySpot = unavailable[actualday][timeindex];
 
                 if(dataOptions.scheduleDataIsFreetime) {
                     unavailabilitySpot = !timenameRegEx.match(field).hasMatch();
@@ -367,34 +337,18 @@ void StudentRecord::parseRecordFromStringList(const QStringList &fields, const D
         }
         day++;
     }
-    if(!dataOptions.dayNames.isEmpty()) {
-        availabilityChart = QObject::tr("Availability:");
-        availabilityChart += "<table style='padding: 0px 3px 0px 3px;'><tr><th></th>";
-        for(int day = 0; day < numDays; day++) {
-            availabilityChart += "<th>" + dataOptions.dayNames.at(day).left(3) + "</th>";   // using first 3 characters in day name as abbreviation
-        }
-        availabilityChart += "</tr>";
-        for(int time = 0; time < numTimes; time++) {
-            availabilityChart += "<tr><th>" + dataOptions.timeNames.at(time) + "</th>";
-            for(int day = 0; day < numDays; day++) {
-                availabilityChart += QString(unavailable[day][time]?
-                            "<td align = center> </td>" : "<td align = center bgcolor='PaleGreen'><b>√</b></td>");
-            }
-            availabilityChart += "</tr>";
-        }
-        availabilityChart += "</table>";
-    }
-    ambiguousSchedule = (availabilityChart.count("√") == 0 || int(availabilityChart.count("√")) == (numDays * numTimes));
+    refreshAmbiguousSchedule(numDays, numTimes);
 
     // section
     if(dataOptions.sectionIncluded) {
         const QString sectionText = QObject::tr("section");
         fieldnum = dataOptions.sectionField;
         if((fieldnum >= 0) && (fieldnum < numFields)) {
-            section = fields.at(fieldnum).trimmed();
-            if(section.startsWith(sectionText, Qt::CaseInsensitive)) {
-                section = section.right(section.size() - sectionText.size()).trimmed();    //removing redundant "section" if at the start of the section name
+            QString sectionResponse = fields.at(fieldnum).trimmed();
+            if(sectionResponse.startsWith(sectionText, Qt::CaseInsensitive)) {
+                sectionResponse = sectionResponse.right(sectionResponse.size() - sectionText.size()).trimmed();    //removing redundant "section" if at the start of the section name
             }
+            section = sectionResponse;
         }
     }
 
@@ -443,13 +397,167 @@ void StudentRecord::parseRecordFromStringList(const QStringList &fields, const D
             }
         }
     }
+
+    invalidateTooltip();
+}
+
+
+////////////////////////////////////////////
+// Interpret the text of a survey timestamp, trying each of the formats used by the various survey sources
+////////////////////////////////////////////
+QDateTime StudentRecord::parseTimestamp(const QString &timestampText)
+{
+    QDateTime timestamp = QDateTime::fromString(timestampText.left(timestampText.lastIndexOf(' ')), TIMESTAMP_FORMAT1); // format with direct download from Google Form
+    if(timestamp.isNull()) {
+        timestamp = QDateTime::fromString(timestampText.left(timestampText.lastIndexOf(' ')), TIMESTAMP_FORMAT2); // alt format with direct download from Google Form
+        if(timestamp.isNull()) {
+            timestamp = QDateTime::fromString(timestampText.left(timestampText.lastIndexOf(' ')), Qt::ISODate); // format with direct download from Canvas
+            if(timestamp.isNull()) {
+                timestamp = QDateTime::fromString(timestampText, TIMESTAMP_FORMAT3);
+                if(timestamp.isNull()) {
+                    timestamp = QDateTime::fromString(timestampText, TIMESTAMP_FORMAT4);
+                    if(timestamp.isNull()) {
+                        timestamp = QLocale::system().toDateTime(timestampText, QLocale::ShortFormat);
+                        if(timestamp.isNull()) {
+                            timestamp = QLocale::system().toDateTime(timestampText, QLocale::LongFormat);
+                            if(timestamp.isNull()) {
+                                int i = 0;
+                                const QList<Qt::DateFormat> stdTimestampFormats = {Qt::TextDate, Qt::ISODate, Qt::ISODateWithMs, Qt::RFC2822Date};
+                                while(i < stdTimestampFormats.size() && timestamp.isNull()) {
+                                    timestamp = QDateTime::fromString(timestampText, stdTimestampFormats.at(i));
+                                    i++;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return timestamp;
+}
+
+
+////////////////////////////////////////////
+// Identify one survey submission by the raw text of its whole row, so that a re-downloaded survey can skip rows already loaded
+// and a changed resubmission is recognized as new even if the survey has no timestamps
+////////////////////////////////////////////
+QString StudentRecord::submissionFingerprint(const QStringList &fields)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(fields.join(QChar(0x1F)).toUtf8(), QCryptographicHash::Sha1).toBase64());
+}
+
+////////////////////////////////////////////
+// Records saved before the submission fingerprint was kept can only be identified by their parsed timestamp and email address
+////////////////////////////////////////////
+QString StudentRecord::legacySubmissionFingerprint(const QDateTime &timestamp, const QString &email)
+{
+    return timestamp.toString(Qt::ISODate) + '|' + email.trimmed().toLower();
+}
+
+
+////////////////////////////////////////////
+// Count the available time blocks within the days and times asked about in the survey
+////////////////////////////////////////////
+int StudentRecord::numAvailableTimeBlocks(const int numDays, const int numTimes) const
+{
+    const std::bitset<MAX_BLOCKS_PER_DAY> timesAsked = std::bitset<MAX_BLOCKS_PER_DAY>().set() >> (MAX_BLOCKS_PER_DAY - numTimes);
+    int numAvailable = 0;
+    for(int day = 0; day < numDays; day++) {
+        numAvailable += numTimes - int((unavailable[day] & timesAsked).count());
+    }
+    return numAvailable;
+}
+
+
+////////////////////////////////////////////
+// Schedule is ambiguous if it is completely full or completely empty
+////////////////////////////////////////////
+void StudentRecord::refreshAmbiguousSchedule(const int numDays, const int numTimes)
+{
+    const int numAvailable = numAvailableTimeBlocks(numDays, numTimes);
+    ambiguousSchedule = ((numAvailable == 0) || (numAvailable == (numDays * numTimes)));
+}
+
+
+////////////////////////////////////////////
+// Cached HTML accessors--built on first request after the record was last changed, and rebuilt if since evicted from the cache
+////////////////////////////////////////////
+quint64 StudentRecord::nextHtmlCacheKey = 1;
+QCache<StudentRecord::HtmlCacheKey, QString> StudentRecord::availabilityChartCache(MAX_CACHED_HTML);
+QCache<StudentRecord::HtmlCacheKey, QString> StudentRecord::tooltipCache(MAX_CACHED_HTML);
+
+QString StudentRecord::getAvailabilityChart(const DataOptions &dataOptions) const
+{
+    if(htmlCacheKey == 0) {
+        htmlCacheKey = nextHtmlCacheKey++;
+    }
+    const HtmlCacheKey key = {htmlCacheKey, dataOptions.version()};
+    const QString *cachedChart = availabilityChartCache.object(key);
+    if(cachedChart != nullptr) {
+        return *cachedChart;
+    }
+    const QString chart = createAvailabilityChart(dataOptions);
+    availabilityChartCache.insert(key, new QString(chart));
+    return chart;
+}
+
+QString StudentRecord::getTooltip(const DataOptions &dataOptions) const
+{
+    if(htmlCacheKey == 0) {
+        htmlCacheKey = nextHtmlCacheKey++;
+    }
+    const HtmlCacheKey key = {htmlCacheKey, dataOptions.version()};
+    const QString *cachedTooltip = tooltipCache.object(key);
+    if(cachedTooltip != nullptr) {
+        return *cachedTooltip;
+    }
+    const QString tooltip = createTooltip(dataOptions);
+    tooltipCache.insert(key, new QString(tooltip));
+    return tooltip;
+}
+
+void StudentRecord::invalidateTooltip()
+{
+    // a new key is assigned on next request; the old cache entries are left for any copies of this record that still use them
+    htmlCacheKey = 0;
+}
+
+
+////////////////////////////////////////////
+// Create an html table of a student's availability
+////////////////////////////////////////////
+QString StudentRecord::createAvailabilityChart(const DataOptions &dataOptions) const
+{
+    if(dataOptions.dayNames.isEmpty()) {
+        return {};
+    }
+
+    const int numDays = int(dataOptions.dayNames.size());
+    const int numTimes = int(dataOptions.timeNames.size());
+    QString availabilityChart = QObject::tr("Availability:");
+    availabilityChart += "<table style='padding: 0px 3px 0px 3px;'><tr><th></th>";
+    for(int day = 0; day < numDays; day++) {
+        availabilityChart += "<th>" + dataOptions.dayNames.at(day).left(3) + "</th>";   // using first 3 characters in day name as abbreviation
+    }
+    availabilityChart += "</tr>";
+    for(int time = 0; time < numTimes; time++) {
+        availabilityChart += "<tr><th>" + dataOptions.timeNames.at(time) + "</th>";
+        for(int day = 0; day < numDays; day++) {
+            availabilityChart += QString(unavailable[day][time]?
+                        "<td align = center> </td>" : "<td align = center bgcolor='PaleGreen'><b>√</b></td>");
+        }
+        availabilityChart += "</tr>";
+    }
+    availabilityChart += "</table>";
+    return availabilityChart;
 }
 
 
 ////////////////////////////////////////////
 // Create a tooltip for a student
 ////////////////////////////////////////////
-void StudentRecord::createTooltip(const DataOptions &dataOptions)
+QString StudentRecord::createTooltip(const DataOptions &dataOptions) const
 {
     QString toolTip = "<html>";
     if(duplicateRecord) {
@@ -550,8 +658,9 @@ void StudentRecord::createTooltip(const DataOptions &dataOptions)
             }
         }
     }
-    if(!(availabilityChart.isEmpty())) {
-        toolTip += "<br>--<br>" + availabilityChart;
+    const QString chart = getAvailabilityChart(dataOptions);
+    if(!(chart.isEmpty())) {
+        toolTip += "<br>--<br>" + chart;
     }
     if(!dataOptions.prefTeammatesField.empty()) {
         QString note = prefTeammates;
@@ -570,7 +679,7 @@ void StudentRecord::createTooltip(const DataOptions &dataOptions)
     }
     toolTip += "</html>";
 
-    tooltip = toolTip;
+    return toolTip;
 }
 
 QJsonObject StudentRecord::toJson() const
@@ -578,8 +687,8 @@ QJsonObject StudentRecord::toJson() const
     QJsonArray gendersArray, unavailableArray, preventedWithArray, requiredWithArray, requestedWithArray, attributeValsArray, attributeResponseArray;
     for(const auto &unavailableDay : unavailable) {
         QJsonArray unavailableArraySubArray;
-        for(const auto unavailableTime : unavailableDay) {
-            unavailableArraySubArray.append(unavailableTime);
+        for(int time = 0; time < MAX_BLOCKS_PER_DAY; time++) {
+            unavailableArraySubArray.append(bool(unavailableDay[time]));
         }
         unavailableArray.append(unavailableArraySubArray);
     }
@@ -596,7 +705,7 @@ QJsonObject StudentRecord::toJson() const
         requestedWithArray.append(id);
     }
     for(int i = 0; i < MAX_ATTRIBUTES; i++) {
-        attributeResponseArray.append(attributeResponse[i]);
+        attributeResponseArray.append(attributeResponse[i].toString());
         QJsonArray attributeValsArraySubArray;
         for (const auto &val : attributeVals[i]) {
             attributeValsArraySubArray.append(val);
@@ -622,15 +731,119 @@ QJsonObject StudentRecord::toJson() const
         {"firstname", firstname},
         {"lastname", lastname},
         {"email", email},
-        {"section", section},
+        {"section", section.toString()},
         {"prefTeammates", prefTeammates},
         {"prefNonTeammates", prefNonTeammates},
         {"notes", notes},
+        {"submission", submission},
         {"attributeResponse", attributeResponseArray},
-        {"URMResponse", URMResponse},
-        {"availabilityChart", availabilityChart},
-        {"tooltip", tooltip}
+        {"URMResponse", URMResponse.toString()}
     };
 
     return content;
 }
+
+
+StudentList::StudentList(const StudentList &other) : QList<StudentRecord>(other)
+{
+    const QReadLocker locker(&other.IDIndexLock);
+    IDIndex = other.IDIndex;
+    indexedSize = other.indexedSize;
+}
+
+
+StudentList &StudentList::operator= (const StudentList &other)
+{
+    if(this != &other) {
+        QList<StudentRecord>::operator=(other);
+        const QReadLocker otherLocker(&other.IDIndexLock);
+        const QWriteLocker locker(&IDIndexLock);
+        IDIndex = other.IDIndex;
+        indexedSize = other.indexedSize;
+    }
+    return *this;
+}
+
+
+StudentList::StudentList(StudentList &&other) noexcept : QList<StudentRecord>(std::move(other)), IDIndex(std::move(other.IDIndex)), indexedSize(other.indexedSize)
+{
+    other.indexedSize = 0;
+}
+
+
+StudentList &StudentList::operator= (StudentList &&other) noexcept
+{
+    QList<StudentRecord>::operator=(std::move(other));
+    IDIndex = std::move(other.IDIndex);
+    indexedSize = other.indexedSize;
+    other.IDIndex.clear();
+    other.indexedSize = 0;
+    return *this;
+}
+
+
+int StudentList::indexOfID(const long long ID) const
+{
+    {
+        const QReadLocker locker(&IDIndexLock);
+        if(indexedSize == size()) {
+            const auto location = IDIndex.constFind(ID);
+            if(location == IDIndex.constEnd()) {
+                return -1;
+            }
+            if(at(location.value()).ID == ID) {
+                return location.value();
+            }
+        }
+    }
+
+    // the list has changed since the index was last brought up to date
+    const QWriteLocker locker(&IDIndexLock);
+    updateIDIndex();
+    auto location = IDIndex.constFind(ID);
+    if((location != IDIndex.constEnd()) && (at(location.value()).ID != ID)) {
+        // the list was reordered
+        indexedSize = 0;
+        updateIDIndex();
+        location = IDIndex.constFind(ID);
+    }
+    return (location == IDIndex.constEnd())? -1 : location.value();
+}
+
+
+StudentRecord *StudentList::findByID(const long long ID)
+{
+    const int index = indexOfID(ID);
+    return (index == -1)? nullptr : &((*this)[index]);
+}
+
+
+const StudentRecord *StudentList::findByID(const long long ID) const
+{
+    const int index = indexOfID(ID);
+    return (index == -1)? nullptr : &(at(index));
+}
+
+
+void StudentList::rebuildIDIndex() const
+{
+    const QWriteLocker locker(&IDIndexLock);
+    indexedSize = 0;
+    updateIDIndex();
+}
+
+
+void StudentList::updateIDIndex() const
+{
+    if(indexedSize > size()) {
+        indexedSize = 0;
+    }
+    if(indexedSize == 0) {
+        IDIndex.clear();
+        IDIndex.reserve(size());
+    }
+    for(qsizetype index = indexedSize; index < size(); index++) {
+        IDIndex.insert(at(index).ID, int(index));
+    }
+    indexedSize = size();
+}
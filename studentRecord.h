@@ -3,10 +3,16 @@
 
 //the survey and other data from one student
 
+#include "attributeValues.h"
 #include "dataOptions.h"
 #include "gruepr_globals.h"
+#include "internedString.h"
+#include <QCache>
 #include <QDateTime>
+#include <QHash>
 #include <QJsonObject>
+#include <QReadWriteLock>
+#include <bitset>
 
 class StudentRecord
 {
@@ -17,7 +23,16 @@ public:
     void clear();
 
     void parseRecordFromStringList(const QStringList &fields, const DataOptions &dataOptions);
-    void createTooltip(const DataOptions &dataOptions);
+    static QDateTime parseTimestamp(const QString &timestampText);
+    static QString submissionFingerprint(const QStringList &fields);
+    static QString legacySubmissionFingerprint(const QDateTime &timestamp, const QString &email);
+    int numAvailableTimeBlocks(const int numDays, const int numTimes) const;
+    void refreshAmbiguousSchedule(const int numDays, const int numTimes);
+
+    // HTML for display is generated on first use and kept in a shared cache; invalidate whenever displayed data is changed
+    QString getAvailabilityChart(const DataOptions &dataOptions) const;
+    QString getTooltip(const DataOptions &dataOptions) const;
+    void invalidateTooltip();
 
     QJsonObject toJson() const;
 
@@ -27,28 +42,69 @@ public:
     bool duplicateRecord = false;                       // another record exists with the same firstname+lastname or email address
     QSet<Gender> gender = {Gender::unknown};
     bool URM = false;                                   // true if this student is from an underrepresented minority group
-    bool unavailable[MAX_DAYS][MAX_BLOCKS_PER_DAY];     // true if this is a busy block during week
+    std::bitset<MAX_BLOCKS_PER_DAY> unavailable[MAX_DAYS];  // bit is set if this is a busy block during week
     float timezone = 0;                                 // offset from GMT
     bool ambiguousSchedule = false;                     // true if added schedule is completely full or completely empty;
     QSet<long long> preventedWith;                      // set of student IDs that this student is prevented from being on a team with
     QSet<long long> requiredWith;                       // set of student IDs that this student is required to be on a team with
     QSet<long long> requestedWith;                      // set of student IDs that this student desires to be on a team with
-    QList<int> attributeVals[MAX_ATTRIBUTES];           // rating for each attribute (when set, each rating is numerical value from 1 -> attributeLevels[attribute])
+    AttributeValues attributeVals[MAX_ATTRIBUTES];      // rating for each attribute (when set, each rating is numerical value from 1 -> attributeLevels[attribute])
     QDateTime surveyTimestamp;                          // date/time that the survey was submitted -- see TIMESTAMP_FORMAT definition for intepretation of timestamp in survey file
     QString firstname;
     QString lastname;
     QString email;
-    QString section;									// section data stored as text
+    InternedString section;                             // section data stored as text
     QString prefTeammates;
     QString prefNonTeammates;
     QString notes;										// any special notes for this student
-    QString attributeResponse[MAX_ATTRIBUTES];          // the text of the response to each attribute question
-    QString URMResponse;                                // the text of the response the the race/ethnicity/culture question
-    QString availabilityChart;
-    QString tooltip;
+    QString submission;                                 // fingerprint of the survey row this record was parsed from; empty if not from a survey file
+    InternedString attributeResponse[MAX_ATTRIBUTES];   // the text of the response to each attribute question
+    InternedString URMResponse;                         // the text of the response the the race/ethnicity/culture question
 
 private:
+    QString createAvailabilityChart(const DataOptions &dataOptions) const;
+    QString createTooltip(const DataOptions &dataOptions) const;
+    mutable quint64 htmlCacheKey = 0;                   // identifies this record's HTML in the caches; 0 until first generated, and reset whenever invalidated
+    // the caches are shared by all records (and copies of a record, which have the same key) and only used from the GUI thread
+    static quint64 nextHtmlCacheKey;
+    // keyed by the record's key and the version of the DataOptions the HTML was built from, since copies of a record may be shown with different ones
+    using HtmlCacheKey = std::pair<quint64, quint64>;
+    static QCache<HtmlCacheKey, QString> availabilityChartCache;
+    static QCache<HtmlCacheKey, QString> tooltipCache;
+    inline static const int MAX_CACHED_HTML = 2000;
+
     inline static const int SIZE_OF_NOTES_IN_TOOLTIP = 300;
 };
 
+
+// all of the students, with an index for finding a student by ID
+// The index is brought up to date on lookup: students appended since the last lookup are added to it, and it is rebuilt only if the list
+// has shrunk or been reordered (noticed when a lookup lands on a student with a different ID), so lookups and misses are O(1).
+// A student replaced in place by one with a different ID, without the list changing size, is not noticed; call rebuildIDIndex() after that.
+// Lookups may be made from multiple threads at the same time, as long as the list itself is not being modified.
+
+class StudentList : public QList<StudentRecord>
+{
+public:
+    StudentList() = default;
+    explicit StudentList(const QList<StudentRecord> &students) : QList<StudentRecord>(students) {};
+    explicit StudentList(QList<StudentRecord> &&students) : QList<StudentRecord>(std::move(students)) {};
+    ~StudentList() = default;
+    StudentList(const StudentList &other);
+    StudentList &operator= (const StudentList &other);
+    StudentList(StudentList &&other) noexcept;
+    StudentList &operator= (StudentList &&other) noexcept;
+
+    int indexOfID(const long long ID) const;                // returns -1 if not found
+    StudentRecord *findByID(const long long ID);           // returns nullptr if not found
+    const StudentRecord *findByID(const long long ID) const;
+    void rebuildIDIndex() const;
+
+private:
+    void updateIDIndex() const;                             // call only while holding IDIndexLock for writing
+    mutable QReadWriteLock IDIndexLock;
+    mutable QHash<long long, int> IDIndex;
+    mutable qsizetype indexedSize = 0;
+};
+
 #endif // STUDENTRECORD_H
@@ -1,5 +1,7 @@
 #include "teamRecord.h"
 #include <QJsonArray>
+#include <cmath>
+#include <limits>
 
 
 TeamRecord::TeamRecord(const DataOptions *const teamSetDataOptions, const QJsonObject &jsonTeamRecord, const QList<StudentRecord> &students) :
@@ -8,37 +10,45 @@ TeamRecord::TeamRecord(const DataOptions *const teamSetDataOptions, const QJsonO
     LMSID = jsonTeamRecord["LMSID"].toInt();
     score = jsonTeamRecord["score"].toDouble();
     size = jsonTeamRecord["size"].toInt();
-    numSections = jsonTeamRecord["numSections"].toInt();
-    numWomen = jsonTeamRecord["numWomen"].toInt();
-    numMen = jsonTeamRecord["numMen"].toInt();
-    numNonbinary = jsonTeamRecord["numNonbinary"].toInt();
-    numUnknown = jsonTeamRecord["numUnknown"].toInt();
-    numURM = jsonTeamRecord["numURM"].toInt();
-    numStudentsWithAmbiguousSchedules = jsonTeamRecord["numStudentsWithAmbiguousSchedules"].toInt();
-    numMeetingTimes = jsonTeamRecord["numMeetingTimes"].toInt();
     name = jsonTeamRecord["name"].toString();
-    tooltip = jsonTeamRecord["tooltip"].toString();
+
+    // use the saved info until the team is next refreshed
+    auto savedInfo = std::make_shared<TeamInfo>();
+    savedInfo->numSections = jsonTeamRecord["numSections"].toInt();
+    savedInfo->numWomen = jsonTeamRecord["numWomen"].toInt();
+    savedInfo->numMen = jsonTeamRecord["numMen"].toInt();
+    savedInfo->numNonbinary = jsonTeamRecord["numNonbinary"].toInt();
+    savedInfo->numUnknown = jsonTeamRecord["numUnknown"].toInt();
+    savedInfo->numURM = jsonTeamRecord["numURM"].toInt();
+    savedInfo->numStudentsWithAmbiguousSchedules = jsonTeamRecord["numStudentsWithAmbiguousSchedules"].toInt();
+    savedInfo->numMeetingTimes = jsonTeamRecord["numMeetingTimes"].toInt();
 
     const QJsonArray attributeValsArray = jsonTeamRecord["attributeVals"].toArray();
     for(int i = 0; i < MAX_ATTRIBUTES; i++) {
         const QJsonArray attributeValsArraySubArray = attributeValsArray[i].toArray();
         for (const auto &val : attributeValsArraySubArray) {
-            attributeVals[i].insert(val.toInt());
+            savedInfo->attributeVals[i].insert(val.toInt());
         }
     }
 
     const QJsonArray timezoneValsArray = jsonTeamRecord["timezoneVals"].toArray();
     for (const auto &val : timezoneValsArray) {
-        timezoneVals.insert(val.toDouble());
+        savedInfo->timezoneVals.insert(val.toDouble());
     }
 
+    // earlier versions saved every possible day and time; only those in the survey are kept
+    const int numDays = int(teamSetDataOptions->dayNames.size());
+    const int numTimes = int(teamSetDataOptions->timeNames.size());
     const QJsonArray numStudentsAvailableArray = jsonTeamRecord["numStudentsAvailable"].toArray();
-    for(int i = 0; i < MAX_DAYS; i++) {
+    savedInfo->numStudentsAvailable.resize(numDays);
+    for(int i = 0; i < numDays; i++) {
         const QJsonArray numStudentsAvailableArraySubArray = numStudentsAvailableArray[i].toArray();
-        for(int j = 0; j < MAX_BLOCKS_PER_DAY; j++) {
-            numStudentsAvailable[i][j] = numStudentsAvailableArraySubArray[j].toInt();
+        savedInfo->numStudentsAvailable[i].resize(numTimes);
+        for(int j = 0; j < numTimes; j++) {
+            savedInfo->numStudentsAvailable[i][j] = numStudentsAvailableArraySubArray[j].toInt();
         }
     }
+    cachedInfo = std::move(savedInfo);
 
     if(jsonTeamRecord["studentIDs"].type() != QJsonValue::Undefined) {
         const QJsonArray studentIDsArray = jsonTeamRecord["studentIDs"].toArray();
@@ -57,8 +67,26 @@ TeamRecord::TeamRecord(const DataOptions *const teamSetDataOptions, const QJsonO
 }
 
 
-void TeamRecord::createTooltip()
+const QString &TeamRecord::getTooltip() const
 {
+    if(!tooltipIsCurrent) {
+        createTooltip();
+        tooltipIsCurrent = true;
+    }
+    return tooltip;
+}
+
+
+void TeamRecord::invalidateTooltip()
+{
+    tooltipIsCurrent = false;
+    tooltip.clear();
+}
+
+
+void TeamRecord::createTooltip() const
+{
+    const TeamInfo &teamInfo = info();
     QString toolTipText = "<html>";
     if(score < 0) {
         toolTipText += "<table><tr><td bgcolor=" STARFISHHEX "><b>" + QObject::tr("This team has a negative compatibility score, "
@@ -85,36 +113,36 @@ void TeamRecord::createTooltip()
             genderSingularOptions = QString(PRONOUNS).split('/');
             genderPluralOptions = QString(PRONOUNS).split('/');
         }
-        if(numWomen > 0) {
-            toolTipText += QString::number(numWomen) + " " + ((numWomen == 1)? (genderSingularOptions.at(static_cast<int>(Gender::woman))) : (genderPluralOptions.at(static_cast<int>(Gender::woman))));
-            if(numMen > 0 || numNonbinary > 0 || numUnknown > 0) {
+        if(teamInfo.numWomen > 0) {
+            toolTipText += QString::number(teamInfo.numWomen) + " " + ((teamInfo.numWomen == 1)? (genderSingularOptions.at(static_cast<int>(Gender::woman))) : (genderPluralOptions.at(static_cast<int>(Gender::woman))));
+            if(teamInfo.numMen > 0 || teamInfo.numNonbinary > 0 || teamInfo.numUnknown > 0) {
                 toolTipText += ", ";
             }
         }
-        if(numMen > 0) {
-            toolTipText += QString::number(numMen) + " " + ((numMen == 1)? (genderSingularOptions.at(static_cast<int>(Gender::man))) : (genderPluralOptions.at(static_cast<int>(Gender::man))));
-            if(numNonbinary > 0 || numUnknown > 0) {
+        if(teamInfo.numMen > 0) {
+            toolTipText += QString::number(teamInfo.numMen) + " " + ((teamInfo.numMen == 1)? (genderSingularOptions.at(static_cast<int>(Gender::man))) : (genderPluralOptions.at(static_cast<int>(Gender::man))));
+            if(teamInfo.numNonbinary > 0 || teamInfo.numUnknown > 0) {
                 toolTipText += ", ";
             }
         }
-        if(numNonbinary > 0) {
-            toolTipText += QString::number(numNonbinary) + " " + ((numNonbinary == 1)? (genderSingularOptions.at(static_cast<int>(Gender::nonbinary))) : (genderPluralOptions.at(static_cast<int>(Gender::nonbinary))));
-            if(numUnknown > 0) {
+        if(teamInfo.numNonbinary > 0) {
+            toolTipText += QString::number(teamInfo.numNonbinary) + " " + ((teamInfo.numNonbinary == 1)? (genderSingularOptions.at(static_cast<int>(Gender::nonbinary))) : (genderPluralOptions.at(static_cast<int>(Gender::nonbinary))));
+            if(teamInfo.numUnknown > 0) {
                 toolTipText += ", ";
             }
         }
-        if(numUnknown > 0) {
-            toolTipText += QString::number(numUnknown) + " " + ((numUnknown == 1)? (genderSingularOptions.at(static_cast<int>(Gender::unknown))) : (genderPluralOptions.at(static_cast<int>(Gender::unknown))));
+        if(teamInfo.numUnknown > 0) {
+            toolTipText += QString::number(teamInfo.numUnknown) + " " + ((teamInfo.numUnknown == 1)? (genderSingularOptions.at(static_cast<int>(Gender::unknown))) : (genderPluralOptions.at(static_cast<int>(Gender::unknown))));
         }
     }
     if(teamSetDataOptions->URMIncluded) {
-        toolTipText += "<br>" + QObject::tr("URM") + ":  " + QString::number(numURM);
+        toolTipText += "<br>" + QObject::tr("URM") + ":  " + QString::number(teamInfo.numURM);
     }
     const int numAttributesWOTimezone = teamSetDataOptions->numAttributes - (teamSetDataOptions->timezoneIncluded? 1 : 0);
     for(int attribute = 0; attribute < numAttributesWOTimezone; attribute++) {
         toolTipText += "<br>" + QObject::tr("Multiple choice Q") + QString::number(attribute + 1) + ":  ";
-        auto teamVals = attributeVals[attribute].cbegin();
-        auto lastVal = attributeVals[attribute].cend();
+        auto teamVals = teamInfo.attributeVals[attribute].cbegin();
+        auto lastVal = teamInfo.attributeVals[attribute].cend();
         if((teamSetDataOptions->attributeType[attribute] == DataOptions::AttributeType::ordered) ||
            (teamSetDataOptions->attributeType[attribute] == DataOptions::AttributeType::multiordered)) {
             // attribute is ordered/numbered, so important info is the range of values (but ignore any "unset/unknown" values of -1)
@@ -122,11 +150,11 @@ void TeamRecord::createTooltip()
                 teamVals++;
             }
             if(teamVals != lastVal) {
-                if(*teamVals == *attributeVals[attribute].crbegin()) {
+                if(*teamVals == *teamInfo.attributeVals[attribute].crbegin()) {
                     toolTipText += QString::number(*teamVals);
                 }
                 else {
-                    toolTipText += QString::number(*teamVals) + " - " + QString::number(*attributeVals[attribute].crbegin());
+                    toolTipText += QString::number(*teamVals) + " - " + QString::number(*teamInfo.attributeVals[attribute].crbegin());
                 }
             }
             else {
@@ -144,8 +172,8 @@ void TeamRecord::createTooltip()
         }
     }
     if(teamSetDataOptions->timezoneIncluded) {
-        const float timezoneA = *timezoneVals.cbegin();
-        const float timezoneB = *timezoneVals.crbegin();
+        const float timezoneA = *teamInfo.timezoneVals.cbegin();
+        const float timezoneB = *teamInfo.timezoneVals.crbegin();
         QString timezoneText;
         if(timezoneA == timezoneB) {
             const int hour = int(timezoneA);
@@ -175,8 +203,8 @@ void TeamRecord::createTooltip()
             toolTipText += "<tr><th>" + teamSetDataOptions->timeNames.at(time) + "</th>";
             for(int day = 0; day < teamSetDataOptions->dayNames.size(); day++) {
                 QString percentage;
-                if(size > numStudentsWithAmbiguousSchedules) {
-                    percentage = QString::number((100*numStudentsAvailable[day][time]) / (size-numStudentsWithAmbiguousSchedules)) + "% ";
+                if(size > teamInfo.numStudentsWithAmbiguousSchedules) {
+                    percentage = QString::number((100*teamInfo.numStudentsAvailable[day][time]) / (size-teamInfo.numStudentsWithAmbiguousSchedules)) + "% ";
                 }
                 else {
                     percentage = "?";
@@ -198,90 +226,93 @@ void TeamRecord::createTooltip()
 }
 
 
-void TeamRecord::refreshTeamInfo(const QList<StudentRecord> &students, const int meetingBlockSize)
+void TeamRecord::refreshTeamInfo(const std::shared_ptr<const StudentList> &students, const int meetingBlockSize)
 {
-    //re-zero values
-    numSections = 0;
-    QStringList sections;
-    numWomen = 0;
-    numMen = 0;
-    numNonbinary = 0;
-    numUnknown = 0;
-    numURM = 0;
-    numStudentsWithAmbiguousSchedules = 0;
-    numMeetingTimes = 0;
-    for(int attribute = 0; attribute < teamSetDataOptions->numAttributes; attribute++) {
-        attributeVals[attribute].clear();
+    teamInfoStudents = students;
+    this->meetingBlockSize = meetingBlockSize;
+    cachedInfo.reset();
+    invalidateTooltip();
+}
+
+
+const TeamInfo &TeamRecord::info() const
+{
+    if(cachedInfo == nullptr) {
+        cachedInfo = calculateInfo();
     }
-    const int numDays = teamSetDataOptions->dayNames.size();
-    const int numTimes = teamSetDataOptions->timeNames.size();
-    for(int day = 0; day < numDays; day++) {
-        for(int time = 0; time < numTimes; time++) {
-            numStudentsAvailable[day][time] = 0;
-        }
+    return *cachedInfo;
+}
+
+
+std::shared_ptr<const TeamInfo> TeamRecord::calculateInfo() const
+{
+    auto teamInfo = std::make_shared<TeamInfo>();
+    const int numDays = int(teamSetDataOptions->dayNames.size());
+    const int numTimes = int(teamSetDataOptions->timeNames.size());
+    teamInfo->numStudentsAvailable = QList<QList<int>>(numDays, QList<int>(numTimes, 0));
+    if(teamInfoStudents == nullptr) {
+        return teamInfo;
     }
 
     //set values
+    QStringList sections;
     for(int teammate = 0; teammate < size; teammate++) {
-        const StudentRecord* stu = nullptr;
-        for(auto &student : qAsConst(students)) {
-            if(student.ID == studentIDs.at(teammate)) {
-                stu = &student;
-            }
-        }
+        const StudentRecord* stu = teamInfoStudents->findByID(studentIDs.at(teammate));
         if(stu == nullptr) {
             continue;
         }
 
         if(!sections.contains(stu->section)) {
             sections << stu->section;
-            numSections++;
+            teamInfo->numSections++;
         }
         if(teamSetDataOptions->genderIncluded) {
             if(stu->gender.contains(Gender::woman)) {
-                numWomen++;
+                teamInfo->numWomen++;
             }
             if(stu->gender.contains(Gender::man)) {
-                numMen++;
+                teamInfo->numMen++;
             }
             if(stu->gender.contains(Gender::nonbinary)) {
-                numNonbinary++;
+                teamInfo->numNonbinary++;
             }
             if (stu->gender.contains(Gender::unknown)) {
-                numUnknown++;
+                teamInfo->numUnknown++;
             }
         }
         if(teamSetDataOptions->URMIncluded) {
             if(stu->URM) {
-                numURM++;
+                teamInfo->numURM++;
             }
         }
         for(int attribute = 0; attribute < teamSetDataOptions->numAttributes; attribute++) {
-            attributeVals[attribute].insert(stu->attributeVals[attribute].constBegin(), stu->attributeVals[attribute].constEnd());
+            teamInfo->attributeVals[attribute].insert(stu->attributeVals[attribute].constBegin(), stu->attributeVals[attribute].constEnd());
         }
         if(!stu->ambiguousSchedule) {
             for(int day = 0; day < numDays; day++) {
+                auto &numStudentsAvailableToday = teamInfo->numStudentsAvailable[day];
                 for(int time = 0; time < numTimes; time++) {
                     if(!stu->unavailable[day][time]) {
-                        numStudentsAvailable[day][time]++;
+                        numStudentsAvailableToday[time]++;
                     }
                 }
             }
         }
         else {
-            numStudentsWithAmbiguousSchedules++;
+            teamInfo->numStudentsWithAmbiguousSchedules++;
         }
         if(teamSetDataOptions->timezoneIncluded) {
-            timezoneVals.insert(stu->timezone);
+            teamInfo->timezoneVals.insert(stu->timezone);
         }
     }
 
     //count when there's the correct number of consecutive time blocks, but don't count wrap-around past end of 1 day!
-    const int numStudentsWithoutAmbiguousSchedules = size - numStudentsWithAmbiguousSchedules;
+    const int numStudentsWithoutAmbiguousSchedules = size - teamInfo->numStudentsWithAmbiguousSchedules;
     for(int day = 0; day < numDays; day++) {
+        const auto &numStudentsAvailableToday = teamInfo->numStudentsAvailable.at(day);
         for(int time = 0; time < numTimes; time++) {
             int blocks = 0;
-            while((numStudentsAvailable[day][time] == numStudentsWithoutAmbiguousSchedules) && (blocks < meetingBlockSize)) {
+            while((time < numTimes) && (numStudentsAvailableToday.at(time) == numStudentsWithoutAmbiguousSchedules) && (blocks < meetingBlockSize)) {
                 blocks++;
                 if(blocks < meetingBlockSize) {
                     time++;
@@ -289,26 +320,29 @@ void TeamRecord::refreshTeamInfo(const QList<StudentRecord> &students, const int
             }
 
             if((blocks == meetingBlockSize) && (blocks > 0)){
-                numMeetingTimes++;
+                teamInfo->numMeetingTimes++;
             }
         }
     }
+
+    return teamInfo;
 }
 
 QJsonObject TeamRecord::toJson() const
 {
+    const TeamInfo &teamInfo = info();
     QJsonArray attributeValsArray, timezoneValsArray, numStudentsAvailableArray, studentIDsArray;
-    for(const auto &attributeVal : attributeVals) {
+    for(const auto &attributeVal : teamInfo.attributeVals) {
         QJsonArray attributeValsArraySubArray;
         for (const auto &val : attributeVal) {
             attributeValsArraySubArray.append(val);
         }
         attributeValsArray.append(attributeValsArraySubArray);
     }
-    for(const auto &timezoneVal : timezoneVals) {
+    for(const auto &timezoneVal : teamInfo.timezoneVals) {
         timezoneValsArray.append(timezoneVal);
     }
-    for(const auto &numStudentsAvailableInADay : numStudentsAvailable) {
+    for(const auto &numStudentsAvailableInADay : teamInfo.numStudentsAvailable) {
         QJsonArray numStudentsAvailableArraySubArray;
         for(const int numStudentsAvailableNow : numStudentsAvailableInADay) {
             numStudentsAvailableArraySubArray.append(numStudentsAvailableNow);
@@ -323,22 +357,111 @@ QJsonObject TeamRecord::toJson() const
         {"LMSID", LMSID},
         {"score", score},
         {"size", size},
-        {"numSections", numSections},
-        {"numWomen", numWomen},
-        {"numMen", numMen},
-        {"numNonbinary", numNonbinary},
-        {"numUnknown", numUnknown},
-        {"numURM", numURM},
+        {"numSections", teamInfo.numSections},
+        {"numWomen", teamInfo.numWomen},
+        {"numMen", teamInfo.numMen},
+        {"numNonbinary", teamInfo.numNonbinary},
+        {"numUnknown", teamInfo.numUnknown},
+        {"numURM", teamInfo.numURM},
         {"attributeVals", attributeValsArray},
         {"timezoneVals", timezoneValsArray},
         {"numStudentsAvailable", numStudentsAvailableArray},
-        {"numStudentsWithAmbiguousSchedules", numStudentsWithAmbiguousSchedules},
-        {"numMeetingTimes", numMeetingTimes},
+        {"numStudentsWithAmbiguousSchedules", teamInfo.numStudentsWithAmbiguousSchedules},
+        {"numMeetingTimes", teamInfo.numMeetingTimes},
         {"studentIDs", studentIDsArray},
         {"name", name},
-        {"tooltip", tooltip},
         {"dataOptions", teamSetDataOptions->toJson()}
     };
 
     return content;
 }
+
+
+//////////////////
+// Running totals of the team scores in a set, for the net score of the set
+//////////////////
+float TeamSet::netScore() const
+{
+    ensureTallied();
+    return scoreTotals.netScore();
+}
+
+
+void TeamSet::setTeamScore(const int team, const float score)
+{
+    ensureTallied();
+    scoreTotals.add(talliedScores.at(team), -1);
+    (*this)[team].score = score;
+    talliedScores[team] = countedScore(score, at(team).size);
+    scoreTotals.add(talliedScores.at(team), +1);
+}
+
+
+void TeamSet::retallyScores() const
+{
+    talliedScores.resize(size());
+    scoreTotals = ScoreTotals();
+    for(int team = 0; team < size(); team++) {
+        talliedScores[team] = countedScore(at(team).score, at(team).size);
+        scoreTotals.add(talliedScores.at(team), +1);
+    }
+}
+
+
+float TeamSet::netScoreWith(const QList<ScoreChange> &changes) const
+{
+    ensureTallied();
+    ScoreTotals totals = scoreTotals;
+    for(const auto &change : changes) {
+        totals.add(talliedScores.at(change.team), -1);
+        totals.add(countedScore(change.score, change.size), +1);
+    }
+    return totals.netScore();
+}
+
+
+float TeamSet::countedScore(const float teamScore, const int teamSize)
+{
+    //ignore unpenalized teams of one since their score of 0 is not meaningful
+    if((teamSize == 1) && (teamScore == 0)) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    return teamScore;
+}
+
+
+void TeamSet::ensureTallied() const
+{
+    if(talliedScores.size() != size()) {
+        retallyScores();
+    }
+}
+
+
+void TeamSet::ScoreTotals::add(const float teamScore, const int sign)
+{
+    if(std::isnan(teamScore)) {
+        return;
+    }
+    numTeamsScored += sign;
+    regularSum += sign * double(teamScore);
+    if(teamScore <= 0) {
+        numTeamsNonpositive += sign;
+    }
+    else {
+        harmonicSum += sign / double(teamScore);
+    }
+}
+
+
+float TeamSet::ScoreTotals::netScore() const
+{
+    if(numTeamsScored == 0) {
+        return 0;
+    }
+    if(numTeamsNonpositive == 0) {
+        return float(numTeamsScored / harmonicSum);         //harmonic mean
+    }
+    const float mean = float(regularSum / numTeamsScored);    //"punished" arithmetic mean
+    return(mean - (std::abs(mean)/2));
+}
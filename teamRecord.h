@@ -6,8 +6,27 @@
 #include "studentRecord.h"
 #include <QList>
 #include <QString>
+#include <memory>
 #include <set>
 
+// the info about one team that is calculated from its students
+
+struct TeamInfo
+{
+    int numSections = 0;
+    int numWomen = 0;
+    int numMen = 0;
+    int numNonbinary = 0;
+    int numUnknown = 0;
+    int numURM = 0;
+    std::set<int> attributeVals[MAX_ATTRIBUTES];
+    std::set<float> timezoneVals;
+    QList<QList<int>> numStudentsAvailable;     // [day][time], sized to the days and times in the survey
+    int numStudentsWithAmbiguousSchedules = 0;
+    int numMeetingTimes = 0;
+};
+
+
 // all the info about one team
 
 class TeamRecord
@@ -16,8 +35,10 @@ public:
     explicit TeamRecord(const DataOptions *const teamSetDataOptions, int teamSize) : size(teamSize), teamSetDataOptions(teamSetDataOptions) {};
     explicit TeamRecord(const DataOptions *const teamSetDataOptions, const QJsonObject &jsonTeamRecord, const QList<StudentRecord> &students);
 
-    void createTooltip();
-    void refreshTeamInfo(const QList<StudentRecord> &students, const int meetingBlockSize);
+    const QString &getTooltip() const;      // tooltip is generated on first request and cached until invalidated
+    void invalidateTooltip();
+    void refreshTeamInfo(const std::shared_ptr<const StudentList> &students, const int meetingBlockSize);  // marks info out of date; it is recalculated from these students when next requested
+    const TeamInfo &info() const;           // info is calculated on first request after a refresh and shared with copies of this record until the next refresh
 
     QJsonObject toJson() const;
 
@@ -25,30 +46,45 @@ public:
     float score = 0;
     float criterionScores[MAX_CRITERIA]; //score used to determine how well a criteria is met, shown in the results mode to the user.
     int size = 1;
-    int numSections = 0;
-    int numWomen = 0;
-    int numMen = 0;
-    int numNonbinary = 0;
-    int numUnknown = 0;
-    int numURM = 0;
-    std::set<int> attributeVals[MAX_ATTRIBUTES];
-    std::set<float> timezoneVals;
-    int numStudentsAvailable[MAX_DAYS][MAX_BLOCKS_PER_DAY] = {{0}};
-    int numStudentsWithAmbiguousSchedules = 0;
-    int numMeetingTimes = 0;
     QList<long long> studentIDs;
     QString name;
-    QString tooltip;
 
 private:
+    void createTooltip() const;
+    mutable QString tooltip;
+    mutable bool tooltipIsCurrent = false;
     const DataOptions *teamSetDataOptions;
+    std::shared_ptr<const TeamInfo> calculateInfo() const;
+    mutable std::shared_ptr<const TeamInfo> cachedInfo;     // nullptr whenever out of date
+    std::shared_ptr<const StudentList> teamInfoStudents;    // snapshot of the students that info is calculated from, kept alive by this record and its copies; nullptr if never refreshed
+    int meetingBlockSize = 1;
 };
 
 
+// a set of teams, which keeps alive the data options it was made from; the teams refer to these same data options
+// The data options are shared with any other team sets made from the same data, and are never modified once shared.
+// The net score is kept as running totals of the teams' scores and sizes, so a team's .score must only be changed with setTeamScore(),
+// which must also follow any change to the team's size; otherwise call retallyScores() before the net score is next read.
 class TeamSet : public QList<TeamRecord>
 {
 public:
-    DataOptions dataOptions;
+    std::shared_ptr<const DataOptions> dataOptions;
+
+    // The net score of the set, from the team scores as in gruepr::getGenomeScore (generally their harmonic mean). It is kept as running totals
+    // so that rescoring a few teams with setTeamScore() updates it in O(1); adding or removing teams retallies it automatically.
+    float netScore() const;
+    void setTeamScore(int team, float score);
+    void retallyScores() const;
+    struct ScoreChange {int team; float score; int size;};
+    float netScoreWith(const QList<ScoreChange> &changes) const;       // what the net score would be with these teams changed, in O(changes)
+
+private:
+    struct ScoreTotals {int numTeamsScored = 0; int numTeamsNonpositive = 0; double harmonicSum = 0; double regularSum = 0;
+                        void add(float teamScore, int sign); float netScore() const;};
+    static float countedScore(float teamScore, int teamSize);     // NaN if the team is not counted (unpenalized team of one)
+    void ensureTallied() const;
+    mutable QList<float> talliedScores;     // each team's score as counted in the totals
+    mutable ScoreTotals scoreTotals;
 };
 
 #endif // TEAMRECORD_H
@@ -1,98 +1,195 @@
 #include "boxwhiskerplot.h"
 #include "gruepr_globals.h"
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
 
 
-BoxWhiskerPlot::BoxWhiskerPlot(const QString &title, const QString &xAxisTitle, const QString &yAxisTitle, QWidget *parent)
+BoxWhiskerPlot::BoxWhiskerPlot(const QString &xAxisTitle, const QString &yAxisTitle, QWidget *parent)
+    : QWidget(parent)
+    , xAxisTitle(xAxisTitle)
+    , yAxisTitle(yAxisTitle)
 {
-    (void) parent;
-    const QFont titleFont("Oxygen Mono");
-    QFont labelsFont(titleFont);
-    labelsFont.setPointSize(titleFont.pointSize()-2);
-    legend()->hide();
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+
+void BoxWhiskerPlot::loadNextVals(const GenerationSnapshot &snapshot)
+{
+    //adds a new distribution to the graph window, making room first if needed
+    if(numBoxes == CAPACITY) {
+        mergeOlderBoxes();
+    }
 
-    dataSeries = new QBoxPlotSeries(this);
-    this->addSeries(dataSeries);
+    Box &box = boxes[numBoxes];
+    box.firstGeneration = snapshot.generation;
+    box.numGenerations = PLOTFREQUENCY;
+    box.lowest = snapshot.lowestScore;
+    box.lowerQuartile = snapshot.lowerQuartile;
+    box.median = snapshot.median;
+    box.upperQuartile = snapshot.upperQuartile;
+    box.best = snapshot.bestScore;
+    box.unpenalizedGenomePresent = snapshot.unpenalizedGenomePresent;
+    numBoxes++;
 
-    setTitle(title);
+    yAxisRange[axismin] = std::min(yAxisRange[axismin], box.lowest);
+    yAxisRange[axismax] = std::max(yAxisRange[axismax], box.best);
 
-    axisX = new QCategoryAxis(this);
-    this->addAxis(axisX, Qt::AlignBottom);
-    dataSeries->attachAxis(axisX);
-    xAxisRange[axismin] = 0;
-    xAxisRange[axismax] = DATAWIDTH/PLOTFREQUENCY;
-    axisX->setRange(xAxisRange[axismin], xAxisRange[axismax]);
-    for(int label = 0; label <= xAxisRange[axismax]; label++) {
-        axisX->append(QString::number(label*PLOTFREQUENCY), label);
+    update();
+}
+
+
+//////////////////
+// Combine two adjacent boxes into one spanning both; the extremes are exact, the quartiles and median are weighted averages
+//////////////////
+BoxWhiskerPlot::Box BoxWhiskerPlot::merged(const Box &older, const Box &newer)
+{
+    Box box;
+    box.firstGeneration = older.firstGeneration;
+    box.numGenerations = older.numGenerations + newer.numGenerations;
+    const float olderWeight = float(older.numGenerations) / float(box.numGenerations);
+    const float newerWeight = 1.0F - olderWeight;
+    box.lowest = std::min(older.lowest, newer.lowest);
+    box.lowerQuartile = (olderWeight * older.lowerQuartile) + (newerWeight * newer.lowerQuartile);
+    box.median = (olderWeight * older.median) + (newerWeight * newer.median);
+    box.upperQuartile = (olderWeight * older.upperQuartile) + (newerWeight * newer.upperQuartile);
+    box.best = std::max(older.best, newer.best);
+    box.unpenalizedGenomePresent = older.unpenalizedGenomePresent || newer.unpenalizedGenomePresent;
+    return box;
+}
+
+
+//////////////////
+// Merge the older half of the boxes pairwise, then shift the newer half down into the space freed
+//////////////////
+void BoxWhiskerPlot::mergeOlderBoxes()
+{
+    const int numToMerge = numBoxes / 2;
+    for(int box = 0; box < numToMerge / 2; box++) {
+        boxes[box] = merged(boxes[2 * box], boxes[(2 * box) + 1]);
     }
-    axisX->setLabelsPosition(QCategoryAxis::AxisLabelsPositionOnValue);
-    axisX->setLabelsFont(labelsFont);
-    axisX->setTitleFont(titleFont);
-    axisX->setTitleText(xAxisTitle);
-
-    axisY = new QValueAxis(this);
-    this->addAxis(axisY, Qt::AlignLeft);
-    dataSeries->attachAxis(axisY);
-    axisY->setRange(yAxisRange[axismin], yAxisRange[axismax]);
-    axisY->setLabelsFont(labelsFont);
-    axisY->setTitleFont(titleFont);
-    axisY->setTitleText(yAxisTitle);
+    std::move(boxes.begin() + numToMerge, boxes.begin() + numBoxes, boxes.begin() + (numToMerge / 2));
+    numBoxes -= numToMerge / 2;
 }
 
 
-void BoxWhiskerPlot::loadNextVals(const float *const vals, const int *const orderedIndex, int count, const bool unpenalizedGenomePresent)
+//////////////////
+// The 1, 2, or 5 x 10^n step that divides the range into no more than maxNumSteps
+//////////////////
+float BoxWhiskerPlot::niceStep(const float range, const int maxNumSteps)
 {
-    //adds a new distribution to the graph window; QList vals is not sorted, but the indexes in sorted order is given in orderedIndex
-    const int NUM_VALS_NEEDED_FOR_BOX_AND_WHISKER = 5;
-    const int IGNORE_LOWEST_X_PERCENT_DATA = 5;  //drop outliers at low end
-
-    count = count - int(count*IGNORE_LOWEST_X_PERCENT_DATA/100);
-    if(count >= NUM_VALS_NEEDED_FOR_BOX_AND_WHISKER) {
-        nextVals[QBoxSet::LowerExtreme] = vals[orderedIndex[count]];
-        nextVals[QBoxSet::LowerQuartile] = median(vals, orderedIndex, count/2, count);
-        nextVals[QBoxSet::Median] = median(vals, orderedIndex, 0, count);
-        nextVals[QBoxSet::UpperQuartile] = median(vals, orderedIndex, 0, count/2);
-        nextVals[QBoxSet::UpperExtreme] = vals[orderedIndex[0]];
+    if(range <= 0) {
+        return 1;
     }
+    const float rawStep = range / float(maxNumSteps);
+    const float magnitude = std::pow(10.0F, std::floor(std::log10(rawStep)));
+    const float normalizedStep = rawStep / magnitude;
+    if(normalizedStep <= 1) {
+        return magnitude;
+    }
+    if(normalizedStep <= 2) {
+        return 2 * magnitude;
+    }
+    if(normalizedStep <= 5) {
+        return 5 * magnitude;
+    }
+    return 10 * magnitude;
+}
+
+
+void BoxWhiskerPlot::paintEvent(QPaintEvent *event)
+{
+    (void) event;
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::white);
+
+    const QFont titleFont("Oxygen Mono");
+    QFont labelsFont(titleFont);
+    labelsFont.setPointSize(titleFont.pointSize()-2);
+    const QFontMetrics titleMetrics(titleFont);
+    const QFontMetrics labelsMetrics(labelsFont);
+
+    // axis ranges, rounded out to whole steps between labels
+    const int lastGeneration = ((numBoxes > 0)? (boxes[numBoxes - 1].firstGeneration + boxes[numBoxes - 1].numGenerations) : 0);
+    const int xMax = std::max(DATAWIDTH, lastGeneration);
+    const int xStep = std::max(PLOTFREQUENCY, int(niceStep(float(xMax), MAXNUMXAXISLABELS)));
+    const float yStep = niceStep(yAxisRange[axismax] - yAxisRange[axismin], MAXNUMYAXISLABELS);
+    const float yMin = std::floor(yAxisRange[axismin] / yStep) * yStep;
+    const int numYSteps = std::max(1, int(std::ceil((yAxisRange[axismax] - yMin) / yStep)));
+    const float yMax = yMin + (float(numYSteps) * yStep);
 
-    auto *set = new QBoxSet(nextVals[QBoxSet::LowerExtreme], nextVals[QBoxSet::LowerQuartile],
-                                      nextVals[QBoxSet::Median], nextVals[QBoxSet::UpperQuartile],
-                                      nextVals[QBoxSet::UpperExtreme], "", this);
-    if(set != nullptr) {
-        set->setBrush(QBrush(QColor::fromString(unpenalizedGenomePresent? AQUAHEX : STARFISHHEX)));
-        dataSeries->append(set);
+    QStringList yLabels;
+    int yLabelsWidth = 0;
+    for(int step = 0; step <= numYSteps; step++) {
+        yLabels << QString::number(double(yMin + (float(step) * yStep)));
+        yLabelsWidth = std::max(yLabelsWidth, labelsMetrics.horizontalAdvance(yLabels.constLast()));
     }
 
-    //shift x-axis by updateChunkSize if we are at the right edge of graph
-    if(dataSeries->count() > xAxisRange[axismax]) {
-        xAxisRange[axismin] = std::max(xAxisRange[axismin], dataSeries->count() - 1 + (UPDATECHUNKSIZE - DATAWIDTH)/PLOTFREQUENCY);
-        xAxisRange[axismax] = std::max(xAxisRange[axismax], dataSeries->count() - 1 + (UPDATECHUNKSIZE/PLOTFREQUENCY));
-        //remove labels getting shifted off the axis (working backwards)
-        for(int label = ((UPDATECHUNKSIZE/PLOTFREQUENCY) - 1); label >= 0; label--) {
-            axisX->remove(axisX->categoriesLabels().at(label));
-        }
-        //add labels getting shifted on to the axis
-        for(int label = dataSeries->count() - 1; label <= xAxisRange[axismax]; label++) {
-            axisX->append(QString::number(label*PLOTFREQUENCY), label);
-        }
-        axisX->setRange(xAxisRange[axismin], xAxisRange[axismax]);
-        axisX->setStartValue(xAxisRange[axismin]);
+    const QRectF plotArea(QPointF(MARGIN + titleMetrics.height() + MARGIN + yLabelsWidth + MARGIN/2, MARGIN + labelsMetrics.height()/2),
+                          QPointF(width() - MARGIN - labelsMetrics.horizontalAdvance(QString::number(xMax))/2,
+                                  height() - MARGIN - titleMetrics.height() - MARGIN/2 - labelsMetrics.height() - MARGIN/2));
+    if(plotArea.width() <= 0 || plotArea.height() <= 0) {
+        return;
     }
+    const auto xPos = [&plotArea, xMax](const float generation) {return plotArea.left() + (plotArea.width() * generation / float(xMax));};
+    const auto yPos = [&plotArea, yMin, yMax](const float score) {return plotArea.bottom() - (plotArea.height() * (score - yMin) / (yMax - yMin));};
 
-    yAxisRange[axismin] = std::min(yAxisRange[axismin], nextVals[QBoxSet::LowerExtreme]);
-    yAxisRange[axismax] = std::max(yAxisRange[axismax], nextVals[QBoxSet::UpperExtreme]);
-    axisY->setRange(yAxisRange[axismin], yAxisRange[axismax]);
-    axisY->applyNiceNumbers();
-}
+    // gridlines and labels
+    QList<QLineF> gridLines;
+    painter.setFont(labelsFont);
+    painter.setPen(QColor::fromString(DEEPWATERHEX));
+    for(int step = 0; step <= numYSteps; step++) {
+        const float y = yPos(yMin + (float(step) * yStep));
+        gridLines << QLineF(plotArea.left(), y, plotArea.right(), y);
+        painter.drawText(QRectF(plotArea.left() - MARGIN/2 - yLabelsWidth, y - labelsMetrics.height(), yLabelsWidth, 2 * labelsMetrics.height()),
+                         Qt::AlignRight | Qt::AlignVCenter, yLabels.at(step));
+    }
+    for(int generation = 0; generation <= xMax; generation += xStep) {
+        const float x = xPos(float(generation));
+        gridLines << QLineF(x, plotArea.top(), x, plotArea.bottom());
+        const QString label = QString::number(generation);
+        const int labelWidth = labelsMetrics.horizontalAdvance(label);
+        painter.drawText(QRectF(x - labelWidth, plotArea.bottom() + MARGIN/2, 2 * labelWidth, labelsMetrics.height()), Qt::AlignCenter, label);
+    }
+    painter.setPen(QColor::fromString(BUBBLYHEX));
+    painter.drawLines(gridLines);
 
+    // axis titles
+    painter.setFont(titleFont);
+    painter.setPen(QColor::fromString(DEEPWATERHEX));
+    painter.drawText(QRectF(plotArea.left(), height() - MARGIN - titleMetrics.height(), plotArea.width(), titleMetrics.height()), Qt::AlignCenter, xAxisTitle);
+    painter.save();
+    painter.translate(MARGIN, plotArea.center().y());
+    painter.rotate(-90);
+    painter.drawText(QRectF(-plotArea.height()/2, 0, plotArea.height(), titleMetrics.height()), Qt::AlignCenter, yAxisTitle);
+    painter.restore();
 
-float BoxWhiskerPlot::median(const float *const vals, const int *const orderedIndex, const int begin, const int end)
-{
-    const int count = end - begin;
-    if ((count % 2) != 0) {
-        return vals[orderedIndex[count/2 + begin]];
+    // the boxes and whiskers, collected by color so that each kind of shape is drawn in a single call
+    QList<QLineF> whiskers, medians;
+    QList<QRectF> unpenalizedBoxes, penalizedBoxes;
+    whiskers.reserve(3 * numBoxes);
+    medians.reserve(numBoxes);
+    for(int b = 0; b < numBoxes; b++) {
+        const Box &box = boxes[b];
+        const float left = xPos(float(box.firstGeneration));
+        const float right = xPos(float(box.firstGeneration + box.numGenerations));
+        const float center = (left + right) / 2;
+        const float halfWidth = std::max(1.0F, (right - left) * BOXWIDTHFRACTION / 2);
+        whiskers << QLineF(center, yPos(box.lowest), center, yPos(box.best))
+                 << QLineF(center - halfWidth/2, yPos(box.lowest), center + halfWidth/2, yPos(box.lowest))
+                 << QLineF(center - halfWidth/2, yPos(box.best), center + halfWidth/2, yPos(box.best));
+        medians << QLineF(center - halfWidth, yPos(box.median), center + halfWidth, yPos(box.median));
+        (box.unpenalizedGenomePresent? unpenalizedBoxes : penalizedBoxes) << QRectF(QPointF(center - halfWidth, yPos(box.upperQuartile)),
+                                                                                    QPointF(center + halfWidth, yPos(box.lowerQuartile)));
     }
+    painter.drawLines(whiskers);
+    painter.setBrush(QColor::fromString(AQUAHEX));
+    painter.drawRects(unpenalizedBoxes);
+    painter.setBrush(QColor::fromString(STARFISHHEX));
+    painter.drawRects(penalizedBoxes);
+    painter.drawLines(medians);
 
-    const float right = vals[orderedIndex[count/2 + begin]];
-    const float left = vals[orderedIndex[count/2 - 1 + begin]];
-    return (right + left) / 2.0F;
+    // axes
+    painter.drawLine(plotArea.bottomLeft(), plotArea.bottomRight());
+    painter.drawLine(plotArea.bottomLeft(), plotArea.topLeft());
 }
@@ -1,33 +1,46 @@
 #ifndef BOXWHISKERPLOT_H
 #define BOXWHISKERPLOT_H
 
-// a box-and-whisker plot based on QChart
+// a lightweight box-and-whisker plot of the score distribution in each generation of an optimization
+// the boxes are kept in a fixed-capacity buffer; when it fills, the older half of the boxes are merged pairwise,
+// so the whole run stays visible, older generations at coarser detail, and painting costs the same no matter how long the run is
 
-#include <QBoxPlotSeries>
-#include <QCategoryAxis>
-#include <QChartView>
-#include <QValueAxis>
+#include "generationSnapshot.h"
+#include <QWidget>
+#include <array>
 
-class BoxWhiskerPlot : public QChart
+class BoxWhiskerPlot : public QWidget
 {
     Q_OBJECT
 
 public:
-    BoxWhiskerPlot(const QString &title = "", const QString &xAxisTitle = "", const QString &yAxisTitle = "", QWidget *parent = nullptr);
-    void loadNextVals(const float *const vals, const int *const orderedIndex, int count, const bool unpenalizedGenomePresent);
+    BoxWhiskerPlot(const QString &xAxisTitle = "", const QString &yAxisTitle = "", QWidget *parent = nullptr);
+    void loadNextVals(const GenerationSnapshot &snapshot);
     inline static const int PLOTFREQUENCY = 5;
 
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
 private:
-    float median(const float *const vals, const int *const orderedIndex, const int begin, const int end);
-    QBoxPlotSeries *dataSeries;
-    QCategoryAxis *axisX;
-    QValueAxis *axisY;
-    float nextVals[5] = {0,0,0,0,0};
-    int xAxisRange[2] = {0, 1};
+    struct Box {int firstGeneration = 0; int numGenerations = 0;
+                float lowest = 0; float lowerQuartile = 0; float median = 0; float upperQuartile = 0; float best = 0;
+                bool unpenalizedGenomePresent = false;};
+    static Box merged(const Box &older, const Box &newer);
+    void mergeOlderBoxes();
+    static float niceStep(const float range, const int maxNumSteps);
+
+    QString xAxisTitle;
+    QString yAxisTitle;
+    inline static const int CAPACITY = 128;
+    std::array<Box, CAPACITY> boxes;
+    int numBoxes = 0;
     float yAxisRange[2] = {0, 1};
     enum {axismin, axismax};
-    inline static const int DATAWIDTH = 60;
-    inline static const int UPDATECHUNKSIZE = 20;
+    inline static const int DATAWIDTH = 60;             // minimum number of generations spanned by the x-axis
+    inline static const int MAXNUMXAXISLABELS = 12;
+    inline static const int MAXNUMYAXISLABELS = 8;
+    inline static const int MARGIN = 8;
+    inline static const float BOXWIDTHFRACTION = 0.7F;
 };
 
 #endif // BOXWHISKERPLOT_H
@@ -1,13 +1,282 @@
 #include "studentTableWidget.h"
 #include "gruepr_globals.h"
 #include <QHeaderView>
+#include <QIcon>
+#include <QLocale>
+#include <QPainter>
 
 
+//////////////////
+// The students, one per row in the order they are stored, including any deleted (which are filtered out by the proxy model)
+//////////////////
+StudentTableModel::StudentTableModel(const StudentList &students, QObject *parent)
+    : QAbstractTableModel(parent), students(students)
+{
+}
+
+
+void StudentTableModel::setDataOptions(const DataOptions *const dataOptions)
+{
+    beginResetModel();
+    this->dataOptions = dataOptions;
+    columns.clear();
+    if(dataOptions->timestampField != DataOptions::FIELDNOTPRESENT) {
+        columns << Column::timestamp;
+    }
+    if(dataOptions->firstNameField != DataOptions::FIELDNOTPRESENT) {
+        columns << Column::firstName;
+    }
+    if(dataOptions->lastNameField != DataOptions::FIELDNOTPRESENT) {
+        columns << Column::lastName;
+    }
+    if(dataOptions->sectionIncluded) {
+        columns << Column::section;
+    }
+    columns << Column::edit << Column::remove;
+
+    displayedStudents.clear();
+    displayedStudents.reserve(students.size());
+    for(const auto &student : students) {
+        displayedStudents.append(DisplayedStudent(student));
+    }
+    endResetModel();
+}
+
+
+void StudentTableModel::refreshStudents()
+{
+    // update only the rows that changed; deleting a student or changing their section changes their row, so the proxy model then re-filters it
+    const int numExistingRows = int(displayedStudents.size());
+    const int numRows = std::min(numExistingRows, int(students.size()));
+    const int lastColumn = int(columns.size()) - 1;
+    for(int row = 0; row < numRows; row++) {
+        const DisplayedStudent nowShowing(students.at(row));
+        if(!(nowShowing == displayedStudents.at(row))) {
+            displayedStudents[row] = nowShowing;
+            emit dataChanged(index(row, 0), index(row, lastColumn));
+        }
+    }
+
+    if(students.size() > numExistingRows) {
+        beginInsertRows(QModelIndex(), numExistingRows, int(students.size()) - 1);
+        for(int row = numExistingRows; row < students.size(); row++) {
+            displayedStudents.append(DisplayedStudent(students.at(row)));
+        }
+        endInsertRows();
+    }
+}
+
+
+int StudentTableModel::rowCount(const QModelIndex &parent) const
+{
+    return (parent.isValid()? 0 : int(displayedStudents.size()));
+}
+
+
+int StudentTableModel::columnCount(const QModelIndex &parent) const
+{
+    return (parent.isValid()? 0 : int(columns.size()));
+}
+
+
+QVariant StudentTableModel::data(const QModelIndex &index, int role) const
+{
+    if(!index.isValid() || (index.row() >= students.size()) || (dataOptions == nullptr)) {
+        return {};
+    }
+
+    const StudentRecord &student = students.at(index.row());
+    const Column column = columns.at(index.column());
+    switch(role) {
+    case Qt::DisplayRole:
+        switch(column) {
+        case Column::timestamp:
+            return QLocale::system().toString(student.surveyTimestamp, QLocale::ShortFormat);
+        case Column::firstName:
+            return student.firstname;
+        case Column::lastName:
+            return student.lastname;
+        case Column::section:
+            return student.section.toString();
+        default:
+            return {};
+        }
+    case SortRole:
+        if(column == Column::timestamp) {
+            return student.surveyTimestamp;
+        }
+        return data(index, Qt::DisplayRole);
+    case Qt::DecorationRole:
+        if(column == Column::edit) {
+            return QIcon(":/icons_new/edit.png");
+        }
+        if(column == Column::remove) {
+            return QIcon(":/icons_new/trashButton.png");
+        }
+        return {};
+    case Qt::ToolTipRole:
+        if(column == Column::edit) {
+            return QString("<html>" + tr("Edit") + " " + student.firstname + " " + student.lastname + tr("'s data.") + "</html>");
+        }
+        if(column == Column::remove) {
+            return QString("<html>" + tr("Remove") + " " + student.firstname + " " + student.lastname + " " + tr("from the list.") + "</html>");
+        }
+        return student.getTooltip(*dataOptions);
+    case StudentIDRole:
+        return student.ID;
+    case DuplicateRole:
+        return student.duplicateRecord;
+    default:
+        return {};
+    }
+}
+
+
+QVariant StudentTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if((orientation != Qt::Horizontal) || (role != Qt::DisplayRole) || (section < 0) || (section >= columns.size())) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch(columns.at(section)) {
+    case Column::timestamp:
+        return tr("  Survey  \n  Timestamp  ");
+    case Column::firstName:
+        return tr("  First  \n  Name  ");
+    case Column::lastName:
+        return tr("  Last  \n  Name  ");
+    case Column::section:
+        return tr("  Section  ");
+    case Column::edit:
+        return tr("  Edit");
+    case Column::remove:
+        return tr("  Remove");
+    }
+    return {};
+}
+
+
+StudentTableModel::DisplayedStudent::DisplayedStudent(const StudentRecord &student)
+    : timestamp(student.surveyTimestamp), firstname(student.firstname), lastname(student.lastname), section(student.section),
+      deleted(student.deleted), duplicate(student.duplicateRecord)
+{
+}
+
+
+bool StudentTableModel::DisplayedStudent::operator==(const DisplayedStudent &other) const
+{
+    return (deleted == other.deleted) && (duplicate == other.duplicate) && (section == other.section) &&
+           (timestamp == other.timestamp) && (firstname == other.firstname) && (lastname == other.lastname);
+}
+
+
+//////////////////
+// Proxy model that shows only the non-deleted students in the section(s) being teamed, sorting them by the selected column
+//////////////////
+StudentTableProxyModel::StudentTableProxyModel(QObject *parent)
+    : QSortFilterProxyModel(parent)
+{
+    setSortRole(StudentTableModel::SortRole);
+    sortAlphanumerically.setNumericMode(true);
+    sortAlphanumerically.setCaseSensitivity(Qt::CaseInsensitive);
+}
+
+
+void StudentTableProxyModel::setSection(const TeamingOptions::SectionType sectionType, const QString &sectionName)
+{
+    const InternedString newSectionName(sectionName);
+    if((sectionType == this->sectionType) && (newSectionName == this->sectionName)) {
+        return;
+    }
+    this->sectionType = sectionType;
+    this->sectionName = newSectionName;
+    invalidateFilter();
+}
+
+
+void StudentTableProxyModel::sort(int column, Qt::SortOrder order)
+{
+    if(!isSortable(column)) {
+        return;
+    }
+    QSortFilterProxyModel::sort(column, order);
+    emit headerDataChanged(Qt::Horizontal, 0, columnCount() - 1);
+}
+
+
+QVariant StudentTableProxyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    // sortable columns show that they can be sorted, except the one that is sorted, which shows the sort indicator arrow instead
+    if((orientation == Qt::Horizontal) && (role == Qt::DecorationRole) && isSortable(section)) {
+        return QIcon((section == sortColumn())? ":/icons_new/blank_arrow.png" : ":/icons_new/upDownButton_white.png");
+    }
+    return QSortFilterProxyModel::headerData(section, orientation, role);
+}
+
+
+bool StudentTableProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    Q_UNUSED(sourceParent)
+    const auto *const studentModel = qobject_cast<const StudentTableModel *>(sourceModel());
+    const StudentRecord &student = studentModel->student(sourceRow);
+    return !student.deleted &&
+           ((sectionType == TeamingOptions::SectionType::allTogether) ||
+            (sectionType == TeamingOptions::SectionType::allSeparately) ||
+            (sectionType == TeamingOptions::SectionType::noSections) ||
+            (student.section == sectionName));
+}
+
+
+bool StudentTableProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
+{
+    const QVariant leftData = left.data(StudentTableModel::SortRole);
+    const QVariant rightData = right.data(StudentTableModel::SortRole);
+    if(leftData.typeId() == QMetaType::QDateTime) {
+        return leftData.toDateTime() < rightData.toDateTime();
+    }
+    return (sortAlphanumerically.compare(leftData.toString(), rightData.toString()) < 0);
+}
+
+
+bool StudentTableProxyModel::isSortable(const int column) const
+{
+    const auto *const studentModel = qobject_cast<const StudentTableModel *>(sourceModel());
+    if((studentModel == nullptr) || (column < 0) || (column >= studentModel->columnCount())) {
+        return false;
+    }
+    const StudentTableModel::Column columnType = studentModel->columnType(column);
+    return (columnType != StudentTableModel::Column::edit) && (columnType != StudentTableModel::Column::remove);
+}
+
+
+//////////////////
+// Delegate that paints the edit and remove actions as icons, highlighted in the hovered row and marked for possible duplicates
+//////////////////
+void StudentTableActionDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    painter->save();
+    if(option.state & QStyle::State_Selected) {
+        painter->fillRect(option.rect, QColor(BUBBLYHEX));
+    }
+    else if(index.data(StudentTableModel::DuplicateRole).toBool()) {
+        painter->fillRect(option.rect, QColor(STARFISHHEX));
+    }
+    const QIcon icon = index.data(Qt::DecorationRole).value<QIcon>();
+    icon.paint(painter, option.rect, Qt::AlignCenter);
+    painter->restore();
+}
+
+
+//////////////////
+// The table view itself
+//////////////////
 StudentTableWidget::StudentTableWidget(QWidget *parent)
-    : QTableWidget(parent)
+    : QTableView(parent)
 {
     horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
-    verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    // rows are all the same height, so that only the visible rows are ever laid out
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    verticalHeader()->setDefaultSectionSize(ROWHEIGHT);
     horizontalHeader()->setStyleSheet("QHeaderView{border-top: none; border-left: none; border-right: 1px solid lightGray; border-bottom: none;"
                                                    "background-color:" DEEPWATERHEX "; font-family: 'DM Sans'; font-size: 12pt; "
                                                    "color: white; text-align:left;}"
@@ -29,113 +298,109 @@ StudentTableWidget::StudentTableWidget(QWidget *parent)
     setStyleSheet(QString("QTableView{gridline-color: lightGray; font-family: 'DM Sans'; font-size: 12pt;}"
                            "QTableCornerButton::section{border-top: none; border-left: none; border-right: 1px solid gray; "
                                                         "border-bottom: none; background-color: " DEEPWATERHEX ";}"
-                           "QTableWidget::item{border-right: 1px solid lightGray; color: black;}"
-                           "QTableWidget::item:selected{background-color: " BUBBLYHEX ";}"
-                           "QTableWidget::item:hover{background-color: " BUBBLYHEX ";}") +
+                           "QTableView::item{border-right: 1px solid lightGray; color: black;}"
+                           "QTableView::item:selected{background-color: " BUBBLYHEX ";}"
+                           "QTableView::item:hover{background-color: " BUBBLYHEX ";}") +
                   SCROLLBARSTYLE);
 
-    connect(this, &QTableWidget::entered, this, &StudentTableWidget::itemEntered);
-    connect(this, &QTableWidget::viewportEntered, this, [this] {leaveEvent(nullptr);});
-    connect(this->horizontalHeader(), &QHeaderView::sectionClicked, this, &StudentTableWidget::sortByColumn);
+    sortedStudents = new StudentTableProxyModel(this);
+    actionDelegate = new StudentTableActionDelegate(this);
+    setModel(sortedStudents);
+
+    connect(this, &QTableView::entered, this, &StudentTableWidget::itemEntered);
+    connect(this, &QTableView::clicked, this, &StudentTableWidget::itemClicked);
+    connect(this, &QTableView::viewportEntered, this, [this] {leaveEvent(nullptr);});
+    connect(horizontalHeader(), &QHeaderView::sortIndicatorChanged, this, &StudentTableWidget::sortIndicatorChanged);
 }
 
 
-void StudentTableWidget::resetTable()
+void StudentTableWidget::setStudents(const StudentList &students, const DataOptions *const dataOptions)
 {
-    QTableWidget::sortByColumn(0, Qt::AscendingOrder);
-    horizontalHeader()->setSortIndicatorShown(true);
-    horizontalHeader()->setSortIndicator(0, Qt::AscendingOrder);
-    horizontalHeaderItem(0)->setIcon(QIcon(":/icons_new/blank_arrow.png"));
-    prevSortColumn = 0;
-    prevSortOrder = Qt::AscendingOrder;
+    if(studentModel == nullptr) {
+        studentModel = new StudentTableModel(students, this);
+        sortedStudents->setSourceModel(studentModel);
+    }
+    studentModel->setDataOptions(dataOptions);
+
+    // the edit and remove actions are always the last two columns
+    const int numColumns = studentModel->columnCount();
+    for(int column = 0; column < numColumns; column++) {
+        setItemDelegateForColumn(column, (column >= numColumns - 2)? actionDelegate : nullptr);
+    }
+    resizeColumnsToContents();
 }
 
 
-void StudentTableWidget::clearSortIndicator()
+void StudentTableWidget::showSection(const TeamingOptions::SectionType sectionType, const QString &sectionName)
 {
-    horizontalHeaderItem(horizontalHeader()->sortIndicatorSection())->setIcon(QIcon(":/icons_new/blank_arrow.png"));
+    sortedStudents->setSection(sectionType, sectionName);
 }
 
 
-void StudentTableWidget::sortByColumn(int column)
+void StudentTableWidget::refreshStudents()
 {
-    // disallow sorting on the last two columns (edit button and remove button)
-    if(column < columnCount()-2) {
-        QTableWidget::sortByColumn(column, horizontalHeader()->sortIndicatorOrder());
-        horizontalHeaderItem(column)->setIcon(QIcon(":/icons_new/blank_arrow.png"));
-        if(column != prevSortColumn) {
-            horizontalHeaderItem(prevSortColumn)->setIcon(QIcon(":/icons_new/upDownButton_white.png"));
-        }
-        prevSortColumn = column;
-        prevSortOrder = horizontalHeader()->sortIndicatorOrder();
+    if(studentModel == nullptr) {
+        return;
     }
-    else {
-        QTableWidget::sortByColumn(prevSortColumn, prevSortOrder);
-        horizontalHeader()->setSortIndicator(prevSortColumn, prevSortOrder);
+    const int numRowsBefore = studentModel->rowCount();
+    studentModel->refreshStudents();
+    if(studentModel->rowCount() != numRowsBefore) {
+        resizeColumnsToContents();
     }
 }
 
 
-void StudentTableWidget::leaveEvent(QEvent *event)
+int StudentTableWidget::numStudentsShown() const
 {
-    selectionModel()->clearSelection();
-    for(int row = 0; row < rowCount(); row++) {
-        cellLeft(row);
-    }
-    if(event != nullptr) {
-        QWidget::leaveEvent(event);
-    }
+    return sortedStudents->rowCount();
 }
 
 
-void StudentTableWidget::cellLeft(const int row)
+void StudentTableWidget::resetTable()
 {
-    selectionModel()->clearSelection();
-    const int numCols = columnCount();
-    if(cellWidget(row, numCols-1)->property("duplicate").toBool()) {
-        cellWidget(row, numCols-1)->setStyleSheet(EDITREMOVEBUTTONDUPLICATESTYLE);
-        cellWidget(row, numCols-2)->setStyleSheet(EDITREMOVEBUTTONDUPLICATESTYLE);
+    horizontalHeader()->setSortIndicatorShown(true);
+    sortByColumn(0, Qt::AscendingOrder);
+    prevSortColumn = 0;
+    prevSortOrder = Qt::AscendingOrder;
+}
+
+
+void StudentTableWidget::sortIndicatorChanged(int column, Qt::SortOrder order)
+{
+    // disallow sorting on the last two columns (edit button and remove button); the proxy model ignores these, so just put back the indicator
+    if(column < sortedStudents->columnCount() - 2) {
+        prevSortColumn = column;
+        prevSortOrder = order;
     }
     else {
-        cellWidget(row, numCols-1)->setStyleSheet("");
-        cellWidget(row, numCols-2)->setStyleSheet("");
+        horizontalHeader()->setSortIndicator(prevSortColumn, prevSortOrder);
+    }
+}
+
 
+void StudentTableWidget::leaveEvent(QEvent *event)
+{
+    selectionModel()->clearSelection();
+    if(event != nullptr) {
+        QWidget::leaveEvent(event);
     }
 }
 
 
 void StudentTableWidget::itemEntered(const QModelIndex &index)
 {
-    setSelection(this->visualRect(index), QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
-    cellEntered(index.row());
+    selectRow(index.row());
 }
 
 
-void StudentTableWidget::cellEntered(const int row)
+void StudentTableWidget::itemClicked(const QModelIndex &index)
 {
-    // select the current row, reset the background color of the edit and remover buttons in previously selected row
-    // and change their color in the current row
-    selectRow(row);
-    static int prevID = -1;
-    const int numCols = columnCount();
-    const int numRows = rowCount();
-    if(prevID != -1) {
-        int prevRow = 0;
-        while((prevRow < numRows) && (prevID != cellWidget(prevRow, numCols-1)->property("StudentID").toInt())) {
-            prevRow++;
-        }
-        if(prevRow < numRows) {
-            if(cellWidget(prevRow, numCols-1)->property("duplicate").toBool()) {
-                cellWidget(prevRow, numCols-1)->setStyleSheet(EDITREMOVEBUTTONDUPLICATESTYLE);
-                cellWidget(prevRow, numCols-2)->setStyleSheet(EDITREMOVEBUTTONDUPLICATESTYLE);
-            }
-            else {
-                cellWidget(prevRow, numCols-1)->setStyleSheet("");
-                cellWidget(prevRow, numCols-2)->setStyleSheet("");
-            }
-        }
+    const int numColumns = sortedStudents->columnCount();
+    const long long ID = index.data(StudentTableModel::StudentIDRole).toLongLong();
+    if(index.column() == numColumns - 2) {
+        emit editStudent(ID);
+    }
+    else if(index.column() == numColumns - 1) {
+        emit removeStudent(ID);
     }
-    prevID = cellWidget(row, numCols-1)->property("StudentID").toInt();
-    cellWidget(row, numCols-1)->setStyleSheet(EDITREMOVEBUTTONSELECTEDSTYLE);
-    cellWidget(row, numCols-2)->setStyleSheet(EDITREMOVEBUTTONSELECTEDSTYLE);
 }
@@ -1,31 +1,118 @@
 #ifndef STUDENTTABLEWIDGET_H
 #define STUDENTTABLEWIDGET_H
 
-#include <QTableWidget>
+// a subclassed QTableView to show the students, with edit and remove actions in each row
+// includes the model of the students, a proxy model to filter them by section and sort them, and a delegate to paint the actions
 
-class StudentTableWidget : public QTableWidget
+#include "dataOptions.h"
+#include "studentRecord.h"
+#include "teamingOptions.h"
+#include <QAbstractTableModel>
+#include <QCollator>
+#include <QSortFilterProxyModel>
+#include <QStyledItemDelegate>
+#include <QTableView>
+
+
+///////////////////////////////////////////////////////////////////////
+
+class StudentTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum class Column{timestamp, firstName, lastName, section, edit, remove};
+    enum Role{StudentIDRole = Qt::UserRole, SortRole, DuplicateRole};
+
+    StudentTableModel(const StudentList &students, QObject *parent = nullptr);
+    void setDataOptions(const DataOptions *const dataOptions);      // chooses the columns shown and resets the model
+    void refreshStudents();                 // adds rows for new students and updates the rows whose displayed data changed
+    Column columnType(const int column) const {return columns.at(column);};
+    const StudentRecord &student(const int row) const {return students.at(row);};
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    // what was last shown for each student, to find the rows that need updating
+    struct DisplayedStudent {QDateTime timestamp; QString firstname; QString lastname; InternedString section; bool deleted = false; bool duplicate = false;
+                             explicit DisplayedStudent(const StudentRecord &student);
+                             bool operator==(const DisplayedStudent &other) const;};
+    const StudentList &students;
+    const DataOptions *dataOptions = nullptr;
+    QList<Column> columns;
+    QList<DisplayedStudent> displayedStudents;
+};
+
+///////////////////////////////////////////////////////////////////////
+
+class StudentTableProxyModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+public:
+    StudentTableProxyModel(QObject *parent = nullptr);
+    void setSection(const TeamingOptions::SectionType sectionType, const QString &sectionName);   // hides students not in the section(s) being teamed
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;                   // ignored for the edit and remove columns
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+    bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+
+private:
+    bool isSortable(const int column) const;
+    TeamingOptions::SectionType sectionType = TeamingOptions::SectionType::noSections;
+    InternedString sectionName;
+    QCollator sortAlphanumerically;
+};
+
+///////////////////////////////////////////////////////////////////////
+
+class StudentTableActionDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+};
+
+///////////////////////////////////////////////////////////////////////
+
+class StudentTableWidget : public QTableView
 {
     Q_OBJECT
 
 public:
     StudentTableWidget(QWidget *parent = nullptr);
+    void setStudents(const StudentList &students, const DataOptions *const dataOptions);
+    void showSection(const TeamingOptions::SectionType sectionType, const QString &sectionName);
+    void refreshStudents();
+    int numStudentsShown() const;
     void resetTable();
-    void clearSortIndicator();
-    void cellEntered(const int row);
-    void cellLeft(const int row);
 
-public slots:
-    void sortByColumn(int column);
+signals:
+    void editStudent(long long ID);
+    void removeStudent(long long ID);
 
 protected:
     void leaveEvent(QEvent *event) override;
 
 private slots:
     void itemEntered(const QModelIndex &index);         // select entire row when hovering over any part of it
+    void itemClicked(const QModelIndex &index);
+    void sortIndicatorChanged(int column, Qt::SortOrder order);
 
 private:
+    StudentTableModel *studentModel = nullptr;
+    StudentTableProxyModel *sortedStudents = nullptr;
+    StudentTableActionDelegate *actionDelegate = nullptr;
     int prevSortColumn = 0;
     Qt::SortOrder prevSortOrder = Qt::AscendingOrder;
+    inline static const int ROWHEIGHT = 36;
 };
 
 #endif // STUDENTTABLEWIDGET_H
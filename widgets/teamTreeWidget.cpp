@@ -47,8 +47,8 @@ void TeamTreeWidget::itemCollapse(QTreeWidgetItem *item)
     }
     const bool itemIsTeam = (newItem->treeItemType == TeamTreeWidgetItem::TreeItemType::team);
     if(itemIsTeam) {
-        for(int column = 0; column < columnCount(); column++) {
-            resizeColumnToContents(column);
+        if(!expandingOrCollapsingAll) {
+            resizeColumnsToContents();
         }
     }
     else {
@@ -63,6 +63,24 @@ void TeamTreeWidget::itemExpand(QTreeWidgetItem *item)
     if(newItem == nullptr) {
         return;
     }
+    // create the student items the first time a team is expanded
+    if((newItem->treeItemType == TeamTreeWidgetItem::TreeItemType::team) && (newItem->childCount() == 0) && teamPopulator) {
+        teamPopulator(newItem);
+    }
+    if(!expandingOrCollapsingAll) {
+        resizeColumnsToContents();
+    }
+}
+
+
+void TeamTreeWidget::setTeamPopulator(const std::function<void(TeamTreeWidgetItem *teamItem)> &populator)
+{
+    teamPopulator = populator;
+}
+
+
+void TeamTreeWidget::resizeColumnsToContents()
+{
     for(int column = 0; column < columnCount(); column++) {
         resizeColumnToContents(column);
     }
@@ -72,6 +90,7 @@ void TeamTreeWidget::itemExpand(QTreeWidgetItem *item)
 void TeamTreeWidget::collapseAll()
 {
     setUpdatesEnabled(false);
+    expandingOrCollapsingAll = true;
 
     // iterate through tree, collapsing only the teams
     auto item = dynamic_cast<TeamTreeWidgetItem*>(topLevelItem(0));
@@ -79,13 +98,12 @@ void TeamTreeWidget::collapseAll()
         const bool itemIsTeam = (item->treeItemType == TeamTreeWidgetItem::TreeItemType::team);
         if(itemIsTeam) {
             QTreeWidget::collapseItem(item);
-            for(int column = 0; column < columnCount(); column++) {
-                resizeColumnToContents(column);
-            }
         }
         item = dynamic_cast<TeamTreeWidgetItem*>(itemBelow(item));
     }
 
+    expandingOrCollapsingAll = false;
+    resizeColumnsToContents();
     setUpdatesEnabled(true);
 }
 
@@ -93,6 +111,7 @@ void TeamTreeWidget::collapseAll()
 void TeamTreeWidget::expandAll()
 {
     setUpdatesEnabled(false);
+    expandingOrCollapsingAll = true;
 
     // iterate through tree, expanding every section and team
     auto item = dynamic_cast<TeamTreeWidgetItem*>(topLevelItem(0));
@@ -100,12 +119,12 @@ void TeamTreeWidget::expandAll()
         const bool itemIsStudent = (item->treeItemType == TeamTreeWidgetItem::TreeItemType::student);
         if(!itemIsStudent) {
             QTreeWidget::expandItem(item);
-            for(int column = 0; column < columnCount(); column++) {
-                resizeColumnToContents(column);
-            }
         }
         item = dynamic_cast<TeamTreeWidgetItem*>(itemBelow(item));
     }
+
+    expandingOrCollapsingAll = false;
+    resizeColumnsToContents();
     setUpdatesEnabled(true);
 }
 
@@ -227,7 +246,9 @@ void TeamTreeWidget::refreshTeam(RefreshType refreshType, TeamTreeWidgetItem *te
     teamItem->setData(column, TEAMINFO_DISPLAY_ROLE, tr("Team ") + team.name);
     teamItem->setData(column, TEAMINFO_SORT_ROLE, teamNum); //sort based on team name
     teamItem->setData(column, TEAM_NUMBER_ROLE, teamNum);
-    teamItem->setToolTip(column, team.tooltip);
+    const QString &teamTooltip = team.getTooltip();
+    const TeamInfo &teamInfo = team.info();
+    teamItem->setToolTip(column, teamTooltip);
     column++;
     //Column 2 is the score
     // teamItem->setText(column, ((team.size > 1)? (QString::number(double(team.score), 'f', 2)) : ("  --  ")));
@@ -268,11 +289,11 @@ void TeamTreeWidget::refreshTeam(RefreshType refreshType, TeamTreeWidgetItem *te
 
 
     if(teamingOptions->sectionType == TeamingOptions::SectionType::allTogether) {
-        teamItem->setText(column, QString::number(team.numSections));
+        teamItem->setText(column, QString::number(teamInfo.numSections));
         teamItem->setTextAlignment(column, Qt::AlignLeft | Qt::AlignVCenter);
-        teamItem->setData(column, TEAMINFO_DISPLAY_ROLE, QString::number(team.numSections));
-        teamItem->setData(column, TEAMINFO_SORT_ROLE, team.numSections);
-        teamItem->setToolTip(column, team.tooltip);
+        teamItem->setData(column, TEAMINFO_DISPLAY_ROLE, QString::number(teamInfo.numSections));
+        teamItem->setData(column, TEAMINFO_SORT_ROLE, teamInfo.numSections);
+        teamItem->setToolTip(column, teamTooltip);
         column++;
     }
     //Column 3 are the heuristics (so replace these with the Criterion* objects and their associated score first, then display the rest)
@@ -291,48 +312,48 @@ void TeamTreeWidget::refreshTeam(RefreshType refreshType, TeamTreeWidgetItem *te
             genderInitials = QString(PRONOUNSINITIALS).split('/');
         }
         QString genderText;
-        if(team.numWomen > 0) {
-            genderText += QString::number(team.numWomen) + genderInitials.at(static_cast<int>(Gender::woman));
-            if(team.numMen > 0 || team.numNonbinary > 0 || team.numUnknown > 0) {
+        if(teamInfo.numWomen > 0) {
+            genderText += QString::number(teamInfo.numWomen) + genderInitials.at(static_cast<int>(Gender::woman));
+            if(teamInfo.numMen > 0 || teamInfo.numNonbinary > 0 || teamInfo.numUnknown > 0) {
                 genderText += ", ";
             }
         }
-        if(team.numMen > 0) {
-            genderText += QString::number(team.numMen) + genderInitials.at(static_cast<int>(Gender::man));
-            if(team.numNonbinary > 0 || team.numUnknown > 0) {
+        if(teamInfo.numMen > 0) {
+            genderText += QString::number(teamInfo.numMen) + genderInitials.at(static_cast<int>(Gender::man));
+            if(teamInfo.numNonbinary > 0 || teamInfo.numUnknown > 0) {
                 genderText += ", ";
             }
         }
-        if(team.numNonbinary > 0) {
-            genderText += QString::number(team.numNonbinary) + genderInitials.at(static_cast<int>(Gender::nonbinary));
-            if(team.numUnknown > 0) {
+        if(teamInfo.numNonbinary > 0) {
+            genderText += QString::number(teamInfo.numNonbinary) + genderInitials.at(static_cast<int>(Gender::nonbinary));
+            if(teamInfo.numUnknown > 0) {
                 genderText += ", ";
             }
         }
-        if(team.numUnknown > 0) {
-            genderText += QString::number(team.numUnknown) + genderInitials.at(static_cast<int>(Gender::unknown));
+        if(teamInfo.numUnknown > 0) {
+            genderText += QString::number(teamInfo.numUnknown) + genderInitials.at(static_cast<int>(Gender::unknown));
         }
         teamItem->setText(column, genderText);
         teamItem->setTextAlignment(column, Qt::AlignCenter);
         teamItem->setData(column, TEAMINFO_DISPLAY_ROLE, genderText);
-        teamItem->setData(column, TEAMINFO_SORT_ROLE, team.numMen - team.numWomen);
-        teamItem->setToolTip(column, team.tooltip);
+        teamItem->setData(column, TEAMINFO_SORT_ROLE, teamInfo.numMen - teamInfo.numWomen);
+        teamItem->setToolTip(column, teamTooltip);
         column++;
     }
     if(dataOptions->URMIncluded) {
-        teamItem->setText(column, QString::number(team.numURM));
+        teamItem->setText(column, QString::number(teamInfo.numURM));
         teamItem->setTextAlignment(column, Qt::AlignCenter);
-        teamItem->setData(column, TEAMINFO_DISPLAY_ROLE, QString::number(team.numURM));
-        teamItem->setData(column, TEAMINFO_SORT_ROLE, team.numURM);
-        teamItem->setToolTip(column, team.tooltip);
+        teamItem->setData(column, TEAMINFO_DISPLAY_ROLE, QString::number(teamInfo.numURM));
+        teamItem->setData(column, TEAMINFO_SORT_ROLE, teamInfo.numURM);
+        teamItem->setToolTip(column, teamTooltip);
         column++;
     }
     const int numAttributesWOTimezone = dataOptions->numAttributes - (dataOptions->timezoneIncluded? 1 : 0);
     for(int attribute = 0; attribute < numAttributesWOTimezone; attribute++) {
         QString attributeText;
         int sortData;
-        auto firstTeamVal = team.attributeVals[attribute].cbegin();
-        auto lastTeamVal = team.attributeVals[attribute].crbegin();
+        auto firstTeamVal = teamInfo.attributeVals[attribute].cbegin();
+        auto lastTeamVal = teamInfo.attributeVals[attribute].crbegin();
         if((dataOptions->attributeType[attribute] == DataOptions::AttributeType::ordered) ||
             (dataOptions->attributeType[attribute] == DataOptions::AttributeType::multiordered)) {
             // attribute is ordered/numbered, so important info is the range of values (but ignore any "unset/unknown" values of -1)
@@ -343,7 +364,7 @@ void TeamTreeWidget::refreshTeam(RefreshType refreshType, TeamTreeWidgetItem *te
             float sum = 0.0f;
             int count = 0;
 
-            for (auto it = team.attributeVals[attribute].cbegin(); it != team.attributeVals[attribute].cend(); ++it) {
+            for (auto it = teamInfo.attributeVals[attribute].cbegin(); it != teamInfo.attributeVals[attribute].cend(); ++it) {
                 sum += *it;  // Add the current value to the sum
                 count++;  // Increment the count
             }
@@ -352,7 +373,7 @@ void TeamTreeWidget::refreshTeam(RefreshType refreshType, TeamTreeWidgetItem *te
             float average = (count > 0) ? sum / count : 0.0f;
             attributeText = QString("Average: ") + QString::number(average);
             sortData = average;
-            // if(firstTeamVal != team.attributeVals[attribute].cend()) {
+            // if(firstTeamVal != teamInfo.attributeVals[attribute].cend()) {
             //     if(*firstTeamVal == *lastTeamVal) {
             //         attributeText = QString::number(*firstTeamVal);
             //     }
@@ -371,23 +392,23 @@ void TeamTreeWidget::refreshTeam(RefreshType refreshType, TeamTreeWidgetItem *te
             // attribute is categorical or multicategorical, so important info is the list of values
             // if attribute has "unset/unknown" value of -1, char is nicely '?'; if attribute value is > 26, letters are repeated as needed
             attributeText = (*firstTeamVal <= 26 ? QString(char(*firstTeamVal - 1 + 'A')) : QString(char((*firstTeamVal - 1)%26 + 'A')).repeated(1+((*firstTeamVal - 1)/26)));
-            for(auto val = std::next(firstTeamVal); val != team.attributeVals[attribute].end(); val++) {
+            for(auto val = std::next(firstTeamVal); val != teamInfo.attributeVals[attribute].end(); val++) {
                 attributeText += ", ";
                 attributeText += (*val <= 26 ? QString(char(*val - 1 + 'A')) : QString(char((*val - 1)%26 + 'A')).repeated(1+((*val - 1)/26)));
             }
             // sort by first item, then number of items, then second item
-            sortData = (*firstTeamVal * 10000) + (int(team.attributeVals[attribute].size()) * 100) + (int(team.attributeVals[attribute].size()) > 1 ? *lastTeamVal : 0);
+            sortData = (*firstTeamVal * 10000) + (int(teamInfo.attributeVals[attribute].size()) * 100) + (int(teamInfo.attributeVals[attribute].size()) > 1 ? *lastTeamVal : 0);
         }
         teamItem->setText(column, attributeText);
         teamItem->setTextAlignment(column, Qt::AlignCenter);
         teamItem->setData(column, TEAMINFO_DISPLAY_ROLE, attributeText);
         teamItem->setData(column, TEAMINFO_SORT_ROLE, sortData);
-        teamItem->setToolTip(column, team.tooltip);
+        teamItem->setToolTip(column, teamTooltip);
         column++;
     }
     if(dataOptions->timezoneIncluded) {
-        const float firstTeamVal = *(team.timezoneVals.cbegin());
-        const float lastTeamVal = *(team.timezoneVals.crbegin());
+        const float firstTeamVal = *(teamInfo.timezoneVals.cbegin());
+        const float lastTeamVal = *(teamInfo.timezoneVals.crbegin());
         QString timezoneText;
         if(firstTeamVal == lastTeamVal) {
             const int hour = int(firstTeamVal);
@@ -408,16 +429,16 @@ void TeamTreeWidget::refreshTeam(RefreshType refreshType, TeamTreeWidgetItem *te
         teamItem->setTextAlignment(column, Qt::AlignCenter);
         teamItem->setData(column, TEAMINFO_DISPLAY_ROLE, timezoneText);
         teamItem->setData(column, TEAMINFO_SORT_ROLE, sortData);
-        teamItem->setToolTip(column, team.tooltip);
+        teamItem->setToolTip(column, teamTooltip);
         column++;
     }
     if(!dataOptions->dayNames.isEmpty()) {
-        const int numAvailTimes = team.numMeetingTimes;
+        const int numAvailTimes = teamInfo.numMeetingTimes;
         teamItem->setText(column, ((team.size > 1)? (QString::number(numAvailTimes)) : ("  --  ")));
         teamItem->setTextAlignment(column, Qt::AlignCenter);
         teamItem->setData(column, TEAMINFO_DISPLAY_ROLE, QString::number(numAvailTimes));
         teamItem->setData(column, TEAMINFO_SORT_ROLE, numAvailTimes);
-        teamItem->setToolTip(column, team.tooltip);
+        teamItem->setToolTip(column, teamTooltip);
         column++;
     }
     if(refreshType == RefreshType::newTeam) {
@@ -436,9 +457,10 @@ void TeamTreeWidget::refreshStudent(TeamTreeWidgetItem *studentItem, const Stude
     }
 
     int column = 0;
+    const QString studentTooltip = stu.getTooltip(*dataOptions);
     studentItem->setText(column, stu.firstname + " " + stu.lastname);
     studentItem->setData(column, Qt::UserRole, stu.ID);
-    studentItem->setToolTip(column, stu.tooltip);
+    studentItem->setToolTip(column, studentTooltip);
     studentItem->setTextAlignment(column, Qt::AlignLeft | Qt::AlignVCenter);
     column++;
     // // blank teamscore column, but show a tooltip if hovered
@@ -453,7 +475,7 @@ void TeamTreeWidget::refreshStudent(TeamTreeWidgetItem *studentItem, const Stude
     // }
     if(teamingOptions->sectionType == TeamingOptions::SectionType::allTogether) {
         studentItem->setText(column, stu.section);
-        studentItem->setToolTip(column, stu.tooltip);
+        studentItem->setToolTip(column, studentTooltip);
         column++;
     }
     if(dataOptions->genderIncluded) {
@@ -480,7 +502,7 @@ void TeamTreeWidget::refreshStudent(TeamTreeWidgetItem *studentItem, const Stude
             firstGender = false;
         }
         studentItem->setText(column, genderText);
-        studentItem->setToolTip(column, stu.tooltip);
+        studentItem->setToolTip(column, studentTooltip);
         studentItem->setTextAlignment(column, Qt::AlignCenter);
         column++;
     }
@@ -492,7 +514,7 @@ void TeamTreeWidget::refreshStudent(TeamTreeWidgetItem *studentItem, const Stude
         else {
             studentItem->setText(column,"");
         }
-        studentItem->setToolTip(column, stu.tooltip);
+        studentItem->setToolTip(column, studentTooltip);
         studentItem->setTextAlignment(column, Qt::AlignCenter);
         column++;
     }
@@ -534,7 +556,7 @@ void TeamTreeWidget::refreshStudent(TeamTreeWidgetItem *studentItem, const Stude
         else {
             studentItem->setText(column, "?");
         }
-        studentItem->setToolTip(column, stu.tooltip);
+        studentItem->setToolTip(column, studentTooltip);
         studentItem->setTextAlignment(column, Qt::AlignCenter);
         column++;
     }
@@ -542,14 +564,14 @@ void TeamTreeWidget::refreshStudent(TeamTreeWidgetItem *studentItem, const Stude
         const int hour = int(stu.timezone);
         const int minutes = 60*(stu.timezone - int(stu.timezone));
         studentItem->setText(column, QString("%1%2:%3").arg(hour >= 0 ? "+" : "").arg(hour).arg(minutes, 2, 10, QChar('0')));
-        studentItem->setToolTip(column, stu.tooltip);
+        studentItem->setToolTip(column, studentTooltip);
         studentItem->setTextAlignment(column, Qt::AlignCenter);
         column++;
     }
     if(!dataOptions->dayNames.isEmpty()) {
-        const int availableTimes = stu.ambiguousSchedule? 0 : int(stu.availabilityChart.count("√"));
+        const int availableTimes = stu.ambiguousSchedule? 0 : stu.numAvailableTimeBlocks(int(dataOptions->dayNames.size()), int(dataOptions->timeNames.size()));
         studentItem->setText(column, availableTimes == 0? "--" : QString::number(availableTimes));
-        studentItem->setToolTip(column, stu.tooltip);
+        studentItem->setToolTip(column, studentTooltip);
         studentItem->setTextAlignment(column, Qt::AlignCenter);
     }
 }
@@ -557,6 +579,7 @@ void TeamTreeWidget::refreshStudent(TeamTreeWidgetItem *studentItem, const Stude
 
 void TeamTreeWidget::dragEnterEvent(QDragEnterEvent *event)
 {
+    scorePreviews.clear();
     draggedItem = dynamic_cast<TeamTreeWidgetItem*>(currentItem());
     if(draggedItem == nullptr) {
         return;
@@ -621,21 +644,31 @@ void TeamTreeWidget::dragMoveEvent(QDragMoveEvent *event)
     }
     else if(draggedItemIsStudent && droppedItemIsStudent) {
         // dragging student->student
+        bool penaltyAdded = false;
+        QString swapPreview;
+        if(draggedItemParent != nullptr && droppedItemParent != nullptr) {
+            swapPreview = scorePreviewText({draggedItemParent->data(0, TEAM_NUMBER_ROLE).toInt(),
+                                            draggedItem->data(0, Qt::UserRole).toInt(),
+                                            droppedItemParent->data(0, TEAM_NUMBER_ROLE).toInt(),
+                                            droppedItem->data(0, Qt::UserRole).toInt()},
+                                           draggedItemParent->text(0), droppedItemParent->text(0), penaltyAdded);
+        }
         // show warning if there are separated sections and dragging between different sections
         if(draggedItemParent != nullptr && droppedItemParent != nullptr &&
             draggedItemParent->parent() != nullptr && droppedItemParent->parent() != nullptr &&
             draggedItemParent->parent() != droppedItemParent->parent()) {
                 dragDropEventLabel->setText(R"(<img style="vertical-align:middle" src=":/icons_new/swap.png" width=")" + iconSizeStr + "\" height=\"" + iconSizeStr + "\">"
                                             + tr("Swap the placement of") + " <b>" + draggedItem->text(0) + "</b> " + tr("and") + " <b>" + droppedItem->text(0) + "</b><br>"
-                                            + tr("NOTE: these students are on teams in different sections.") + "</div>");
+                                            + tr("NOTE: these students are on teams in different sections.") + swapPreview + "</div>");
                 dragDropEventLabel->setStyleSheet(DRAGDROPLABELWARNSTYLE);
                 dragDropEventLabel->show();
                 dragDropEventLabel->adjustSize();
         }
         else {
             dragDropEventLabel->setText(R"(<img style="vertical-align:middle" src=":/icons_new/swap.png" width=")" + iconSizeStr + "\" height=\"" + iconSizeStr + "\">"
-                                        + tr("Swap the placement of") + " <b>" + draggedItem->text(0) + "</b> " + tr("and") + " <b>" + droppedItem->text(0) + "</b></div>");
-            dragDropEventLabel->setStyleSheet(DRAGDROPLABELGOODSTYLE);
+                                        + tr("Swap the placement of") + " <b>" + draggedItem->text(0) + "</b> " + tr("and") + " <b>" + droppedItem->text(0) + "</b>"
+                                        + swapPreview + "</div>");
+            dragDropEventLabel->setStyleSheet(penaltyAdded? DRAGDROPLABELWARNSTYLE : DRAGDROPLABELGOODSTYLE);
             dragDropEventLabel->show();
             dragDropEventLabel->adjustSize();
         }
@@ -645,29 +678,40 @@ void TeamTreeWidget::dragMoveEvent(QDragMoveEvent *event)
         // dragging student->team
         // disallow if this is the only student left on the team (leaving team empty)
         // and warn if this team is in a differen section
-        if(draggedItemParent->childCount() == 1) {
+        if((draggedItemParent != nullptr) && (draggedItemParent->childCount() == 1)) {
             dragDropEventLabel->setText(tr("Cannot move") + " <b>" + draggedItem->text(0) + "</b> " + tr("onto another team.<br>")
                                          + " <b>" + draggedItem->parent()->text(0) + "</b> " + tr("cannot be left empty."));
             dragDropEventLabel->setStyleSheet(DRAGDROPLABELSTOPSTYLE);
             dragDropEventLabel->show();
             dragDropEventLabel->adjustSize();
         }
-        else if(draggedItemParent != nullptr && droppedItemParent != nullptr &&
+        else {
+            bool penaltyAdded = false;
+            QString movePreview;
+            if(draggedItemParent != nullptr) {
+                movePreview = scorePreviewText({draggedItemParent->data(0, TEAM_NUMBER_ROLE).toInt(),
+                                                draggedItem->data(0, Qt::UserRole).toInt(),
+                                                droppedItem->data(0, TEAM_NUMBER_ROLE).toInt()},
+                                               draggedItemParent->text(0), droppedItem->text(0), penaltyAdded);
+            }
+            if(draggedItemParent != nullptr && droppedItemParent != nullptr &&
                 draggedItemParent->parent() != nullptr && draggedItemParent->parent() != droppedItemParent) {
-            dragDropEventLabel->setText(R"(<img style="vertical-align:middle" src=":/icons_new/swap.png" width=")" + iconSizeStr + "\" height=\"" + iconSizeStr + "\">"
-                                        + tr("Move") + " <b>" + draggedItem->text(0) + "</b> " + tr("onto") + " <b>" + droppedItem->text(0) + "</b><br>"
-                                        + tr("NOTE: this students is on a team in different a section.") + "</div>");
-            dragDropEventLabel->setStyleSheet(DRAGDROPLABELWARNSTYLE);
-            dragDropEventLabel->show();
-            dragDropEventLabel->adjustSize();
+                dragDropEventLabel->setText(R"(<img style="vertical-align:middle" src=":/icons_new/swap.png" width=")" + iconSizeStr + "\" height=\"" + iconSizeStr + "\">"
+                                            + tr("Move") + " <b>" + draggedItem->text(0) + "</b> " + tr("onto") + " <b>" + droppedItem->text(0) + "</b><br>"
+                                            + tr("NOTE: this students is on a team in different a section.") + movePreview + "</div>");
+                dragDropEventLabel->setStyleSheet(DRAGDROPLABELWARNSTYLE);
+                dragDropEventLabel->show();
+                dragDropEventLabel->adjustSize();
 
-        }
-        else {
-            dragDropEventLabel->setText(R"(<img style="vertical-align:middle" src=":/icons_new/move.png" width=")" + iconSizeStr + "\" height=\"" + iconSizeStr + "\">"
-                                         + tr("Move") + " <b>" + draggedItem->text(0) + "</b> " + tr("onto") + " <b>" + droppedItem->text(0) + "</b></div>");
-            dragDropEventLabel->setStyleSheet(DRAGDROPLABELGOODSTYLE);
-            dragDropEventLabel->show();
-            dragDropEventLabel->adjustSize();
+            }
+            else {
+                dragDropEventLabel->setText(R"(<img style="vertical-align:middle" src=":/icons_new/move.png" width=")" + iconSizeStr + "\" height=\"" + iconSizeStr + "\">"
+                                             + tr("Move") + " <b>" + draggedItem->text(0) + "</b> " + tr("onto") + " <b>" + droppedItem->text(0) + "</b>"
+                                             + movePreview + "</div>");
+                dragDropEventLabel->setStyleSheet(penaltyAdded? DRAGDROPLABELWARNSTYLE : DRAGDROPLABELGOODSTYLE);
+                dragDropEventLabel->show();
+                dragDropEventLabel->adjustSize();
+            }
         }
     }
     else if(!draggedItemIsStudent && !droppedItemIsStudent) {
@@ -695,8 +739,48 @@ void TeamTreeWidget::dragMoveEvent(QDragMoveEvent *event)
 }
 
 
+void TeamTreeWidget::setScorePreviewer(const std::function<ScorePreview(const QList<int> &arguments)> &previewer)
+{
+    scorePreviewer = previewer;
+    scorePreviews.clear();
+}
+
+
+QString TeamTreeWidget::scorePreviewText(const QList<int> &arguments, const QString &teamAName, const QString &teamBName, bool &penaltyAdded)
+{
+    // nothing changes when rearranging students within a team
+    penaltyAdded = false;
+    if(!scorePreviewer || (arguments.at(0) == arguments.at(2))) {
+        return "";
+    }
+
+    // the preview for each pair of items is calculated once per drag, as the cursor will pass over the same items repeatedly
+    const QPair<QTreeWidgetItem*, QTreeWidgetItem*> dragPair(draggedItem, droppedItem);
+    auto preview = scorePreviews.constFind(dragPair);
+    if(preview == scorePreviews.constEnd()) {
+        preview = scorePreviews.insert(dragPair, scorePreviewer(arguments));
+    }
+
+    const auto signedScore = [](const float change){return ((change >= 0)? "+" : "") + QString::number(double(change), 'f', 1);};
+    QString text = "<br>" + tr("Change in score") + ":  " + teamAName + " " + signedScore(preview->teamAChange) + ",  " +
+                   teamBName + " " + signedScore(preview->teamBChange) + ",  " + tr("overall") + " " + signedScore(preview->netChange);
+    const QList<QPair<QString, PenaltyChange>> penaltyChanges = {{teamAName, preview->teamAPenalty}, {teamBName, preview->teamBPenalty}};
+    for(const auto &penaltyChange : penaltyChanges) {
+        if(penaltyChange.second == PenaltyChange::added) {
+            text += "<br><b>" + penaltyChange.first + " " + tr("would now be penalized for an unmet rule") + "</b>";
+            penaltyAdded = true;
+        }
+        else if(penaltyChange.second == PenaltyChange::removed) {
+            text += "<br><b>" + penaltyChange.first + " " + tr("would no longer be penalized") + "</b>";
+        }
+    }
+    return text;
+}
+
+
 void TeamTreeWidget::dropEvent(QDropEvent *event)
 {
+    scorePreviews.clear();
     if(dragDropEventLabel != nullptr) {
         dragDropEventLabel->hide();
         delete dragDropEventLabel;
@@ -842,6 +926,10 @@ TeamTreeWidgetItem::TeamTreeWidgetItem(TreeItemType type, int columns, float tea
         }
         setScoreColor(teamScore);
     }
+    if(treeItemType == TreeItemType::team) {
+        //students are added when the team is first expanded, so always show that it can be
+        setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+    }
     if(treeItemType == TreeItemType::section) {
         //sections are fixed--they cannot be dragged or dropped onto
         setFlags(flags() & ~Qt::ItemIsDragEnabled & ~Qt::ItemIsDropEnabled);
@@ -11,6 +11,7 @@
 #include <QHeaderView>
 #include <QLabel>
 #include <QTreeWidget>
+#include <functional>
 
 
 ///////////////////////////////////////////////////////////////////////
@@ -49,6 +50,16 @@ public:
     void refreshStudent(TeamTreeWidgetItem *studentItem, const StudentRecord &stu,
                         const DataOptions *const dataOptions, const TeamingOptions *const teamingOptions);
 
+    // the predicted change in scores from a swap or a move, shown while dragging
+    enum class PenaltyChange{none, added, removed};
+    struct ScorePreview {float teamAChange = 0; float teamBChange = 0; float netChange = 0;
+                         PenaltyChange teamAPenalty = PenaltyChange::none; PenaltyChange teamBPenalty = PenaltyChange::none;};
+    // previewer is given the same arguments as would be sent by the swapStudents or moveStudent signal
+    void setScorePreviewer(const std::function<ScorePreview(const QList<int> &arguments)> &previewer);
+
+    // team items are created without their student items; populator is given a team item to fill in the first time it is expanded
+    void setTeamPopulator(const std::function<void(TeamTreeWidgetItem *teamItem)> &populator);
+
 protected:
     void dragEnterEvent(QDragEnterEvent *event) override;        // remember which item is being dragged
     void dragLeaveEvent(QDragLeaveEvent *event) override;        // get rid of tooltip if drag leaves
@@ -74,6 +85,12 @@ private:
     TeamTreeWidgetItem *draggedItem = nullptr;
     TeamTreeWidgetItem *droppedItem = nullptr;
     QLabel *dragDropEventLabel = nullptr;
+    std::function<ScorePreview(const QList<int> &arguments)> scorePreviewer;
+    std::function<void(TeamTreeWidgetItem *teamItem)> teamPopulator;
+    bool expandingOrCollapsingAll = false;          // columns are resized once at the end rather than after each item
+    void resizeColumnsToContents();
+    QHash<QPair<QTreeWidgetItem*, QTreeWidgetItem*>, ScorePreview> scorePreviews;      // for each <dragged, dropped> pair during a drag
+    QString scorePreviewText(const QList<int> &arguments, const QString &teamAName, const QString &teamBName, bool &penaltyAdded);
 };
 
 ///////////////////////////////////////////////////////////////////////
@@ -11,19 +11,23 @@
 #include <QHBoxLayout>
 #include <QJsonArray>
 #include <QLineEdit>
+#include <QMenu>
 #include <QMessageBox>
 #include <QPainter>
 #include <QPrintDialog>
 #include <QTextDocument>
 #include <QTextStream>
 #include <QTimer>
+#include <QtConcurrentMap>
 #include <QtConcurrentRun>
 #include <QVBoxLayout>
+#include <limits>
+#include <numeric>
 
 const QStringList TeamsTabItem::teamnameCategories = QString(TEAMNAMECATEGORIES).split(",");
 const QStringList TeamsTabItem::teamnameLists = QString(TEAMNAMELISTS).split(';');
 
-TeamsTabItem::TeamsTabItem(TeamingOptions &incomingTeamingOptions, const TeamSet &incomingTeamSet, QList<StudentRecord> &incomingStudents,
+TeamsTabItem::TeamsTabItem(TeamingOptions &incomingTeamingOptions, const TeamSet &incomingTeamSet, StudentList &incomingStudents,
                            const QStringList &incomingSectionNames, const QString &incomingTabName, QPushButton *letsDoItButton, QWidget *parent)
     : QWidget(parent)
 {
@@ -31,6 +35,10 @@ TeamsTabItem::TeamsTabItem(TeamingOptions &incomingTeamingOptions, const TeamSet
     sectionNames = incomingSectionNames;
     teams = incomingTeamSet;
     students = incomingStudents;
+    const auto studentsSnapshot = std::make_shared<const StudentList>(students);   // info is calculated from this tab's own copy of the students
+    for(auto &team : teams) {
+        team.refreshTeamInfo(studentsSnapshot, teamingOptions->realMeetingBlockSize);
+    }
     numStudents = students.size();
     tabName = incomingTabName;
 
@@ -38,7 +46,7 @@ TeamsTabItem::TeamsTabItem(TeamingOptions &incomingTeamingOptions, const TeamSet
 }
 
 //initialize from previous data
-TeamsTabItem::TeamsTabItem(const QJsonObject &jsonTeamsTab, TeamingOptions &incomingTeamingOptions, QList<StudentRecord> &incomingStudents,
+TeamsTabItem::TeamsTabItem(const QJsonObject &jsonTeamsTab, TeamingOptions &incomingTeamingOptions, StudentList &incomingStudents,
                            const QStringList &incomingSectionNames, QPushButton *letsDoItButton, QWidget *parent)
     :QWidget(parent)
 {
@@ -51,10 +59,10 @@ TeamsTabItem::TeamsTabItem(const QJsonObject &jsonTeamsTab, TeamingOptions &inco
         students.emplaceBack(student.toObject());
     }
     QJsonArray teamsArray = jsonTeamsTab["teams"].toArray();
-    teams.dataOptions = DataOptions(teamsArray.begin()->toObject()["dataOptions"].toObject());
+    teams.dataOptions = std::make_shared<const DataOptions>(teamsArray.begin()->toObject()["dataOptions"].toObject());
     teams.reserve(teamsArray.size());
     for(const auto &team : qAsConst(teamsArray)) {
-        teams.emplaceBack(&teams.dataOptions, team.toObject(), students);
+        teams.emplaceBack(teams.dataOptions.get(), team.toObject(), students);
     }
     randomizedTeamNames = jsonTeamsTab["randomizedNames"].toBool();
     sectionsInTeamNames = jsonTeamsTab["sectionsInNames"].toBool();
@@ -63,7 +71,7 @@ TeamsTabItem::TeamsTabItem(const QJsonObject &jsonTeamsTab, TeamingOptions &inco
     init(incomingTeamingOptions, incomingStudents, letsDoItButton, TabType::fromJSON);
 }
 
-void TeamsTabItem::init(TeamingOptions &incomingTeamingOptions, QList<StudentRecord> &incomingStudents, QPushButton *letsDoItButton, TabType tabType)
+void TeamsTabItem::init(TeamingOptions &incomingTeamingOptions, StudentList &incomingStudents, QPushButton *letsDoItButton, TabType tabType)
 {
     //pointers to items back out in gruepr, so they can be used for "create new teams with all new teammates"
     externalTeamingOptions = &incomingTeamingOptions;
@@ -114,7 +122,7 @@ void TeamsTabItem::init(TeamingOptions &incomingTeamingOptions, QList<StudentRec
     for (auto* _criterionBeingScored : teamingOptions->criterionTypes){
         if (dynamic_cast<MultipleChoiceStyleCriterion*>(_criterionBeingScored)){
             auto criterionCasted = dynamic_cast<MultipleChoiceStyleCriterion*>(_criterionBeingScored);
-            QString MCQtext = " MCQ: " + teams.dataOptions.attributeQuestionText.at(criterionCasted->attributeIndex) + " ";
+            QString MCQtext = " MCQ: " + teams.dataOptions->attributeQuestionText.at(criterionCasted->attributeIndex) + " ";
             headerLabels << tr(MCQtext.toUtf8());
         } else if (dynamic_cast<MixedGenderCriterion*>(_criterionBeingScored)){
             headerLabels << tr (" Mixed Gender ");
@@ -223,6 +231,13 @@ void TeamsTabItem::init(TeamingOptions &incomingTeamingOptions, QList<StudentRec
     connect(redoButton, &QPushButton::clicked, this, &TeamsTabItem::undoRedoDragDrop);
     rowsLayout->addWidget(redoButton);
 
+    suggestButton = new QPushButton(tr("Suggest Improvements"), this);
+    suggestButton->setStyleSheet(SMALLBUTTONSTYLEINVERTED);
+    suggestButton->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    suggestButton->setToolTip(tr("Find the swaps and moves of students that would most improve the overall score"));
+    connect(suggestButton, &QPushButton::clicked, this, &TeamsTabItem::suggestImprovements);
+    rowsLayout->addWidget(suggestButton);
+
     rowsLayout->addStretch(0);
 
     auto *expandAllButton = new QPushButton(tr("Expand All Teams"), this);
@@ -315,7 +330,7 @@ void TeamsTabItem::init(TeamingOptions &incomingTeamingOptions, QList<StudentRec
     connect(postTeamsButton, &QPushButton::clicked, this, &TeamsTabItem::postTeamsToCanvas);
     savePrintLayout->addWidget(postTeamsButton);
 
-    teamDataTree->resetDisplay(&teams.dataOptions, teamingOptions);
+    teamDataTree->resetDisplay(teams.dataOptions.get(), teamingOptions);
     if(tabType == TabType::newTab) {
         teamDataTree->sortByColumn(0, Qt::AscendingOrder);
         teamDataTree->headerItem()->setIcon(0, QIcon(":/icons_new/blank_arrow.png"));
@@ -324,18 +339,25 @@ void TeamsTabItem::init(TeamingOptions &incomingTeamingOptions, QList<StudentRec
         teamDataTree->sortByColumn(teamDataTree->columnCount() - 1, Qt::AscendingOrder);
         teamDataTree->headerItem()->setIcon(0, QIcon(":/icons_new/upDownButton_white.png"));
     }
+    teamDataTree->setTeamPopulator([this](TeamTreeWidgetItem *teamItem){populateTeamItem(teamItem);});
     refreshTeamDisplay();
     refreshDisplayOrder();
     if(teamingOptions->sectionType == TeamingOptions::SectionType::allSeparately) {
-        //expand the sections, then collapse the teams
-        teamDataTree->expandAll();
-        teamDataTree->collapseAll();
+        //expand the sections, leaving the teams collapsed
+        for(int section = 0; section < teamDataTree->topLevelItemCount(); section++) {
+            teamDataTree->topLevelItem(section)->setExpanded(true);
+        }
     }
 
     connect(teamDataTree, &TeamTreeWidget::swapStudents, this, &TeamsTabItem::swapStudents);
     connect(teamDataTree, &TeamTreeWidget::reorderTeams, this, &TeamsTabItem::moveATeam);
     connect(teamDataTree, &TeamTreeWidget::moveStudent, this, &TeamsTabItem::moveAStudent);
     connect(teamDataTree, &TeamTreeWidget::updateTeamOrder, this, &TeamsTabItem::refreshDisplayOrder);
+
+    for(const auto &team : qAsConst(teams)) {
+        studentIDsInTeams.insert(team.studentIDs.constBegin(), team.studentIDs.constEnd());
+    }
+    teamDataTree->setScorePreviewer([this](const QList<int> &arguments){return previewScores(arguments);});
 }
 
 TeamsTabItem::~TeamsTabItem()
@@ -433,15 +455,30 @@ void TeamsTabItem::refreshSummaryTable(TeamingOptions teamingOptions){
 }
 
 
-QJsonObject TeamsTabItem::toJson() const
+TeamsTabItem::SavedContents TeamsTabItem::savedContents() const
 {
+    SavedContents contents;
+    contents.teamingOptions = teamingOptions->toJson();
+    contents.teams = teams;
+    for(const auto &team : qAsConst(contents.teams)) {
+        team.info();    // so that the info is already calculated, and shared with these copies, before they are used on another thread
+    }
     // Get team numbers in the order that they are currently displayed/sorted
-    const QList<int> teamDisplayNums = getTeamNumbersInDisplayOrder();
+    contents.teamDisplayOrder = getTeamNumbersInDisplayOrder();
+    contents.students = students;
+    contents.numStudents = numStudents;
+    contents.randomizedTeamNames = randomizedTeamNames;
+    contents.sectionsInTeamNames = sectionsInTeamNames;
+    contents.tabName = tabName;
+    return contents;
+}
 
+
+QJsonObject TeamsTabItem::SavedContents::toJson() const
+{
     QJsonArray teamsArray;
-    for(const auto teamNum : teamDisplayNums) {
-        auto &team = teams[teamNum];
-        teamsArray.append(team.toJson());
+    for(const auto teamNum : teamDisplayOrder) {
+        teamsArray.append(teams.at(teamNum).toJson());
     }
     QJsonArray studentsArray;
     for(const auto &student : students) {
@@ -449,7 +486,7 @@ QJsonObject TeamsTabItem::toJson() const
     }
 
     QJsonObject content {
-        {"teamingOptions", teamingOptions->toJson()},
+        {"teamingOptions", teamingOptions},
         {"teams", teamsArray},
         {"students", studentsArray},
         {"numStudents", numStudents},
@@ -602,8 +639,8 @@ void TeamsTabItem::changeTeamNames(int index)
     if((addSectionToTeamnamesCheckBox != nullptr) && addSectionToTeamnamesCheckBox->isChecked()) {
         for(const auto teamNum : teamDisplayNums) {
             auto &team = teams[teamNum];
-            const StudentRecord *const firstStudent = findStudentFromID(team.studentIDs.at(0));
-            team.name.prepend(firstStudent->section + "-");
+            const StudentRecord *const firstStudent = students.findByID(team.studentIDs.at(0));
+            team.name.prepend(firstStudent->section.toString() + "-");
         }
     }
 
@@ -623,9 +660,9 @@ void TeamsTabItem::toggleSectionsInTeamNames(bool addSectionNames)
 
     for(const auto teamNum : teamDisplayNums) {
         auto &team = teams[teamNum];
-        const StudentRecord *const firstStudent = findStudentFromID(team.studentIDs.at(0));
+        const StudentRecord *const firstStudent = students.findByID(team.studentIDs.at(0));
         if(firstStudent != nullptr) {
-            const QString sectionNotifier = firstStudent->section + "-";
+            const QString sectionNotifier = firstStudent->section.toString() + "-";
             if(addSectionNames) {
                 team.name.prepend(sectionNotifier);
             }
@@ -648,19 +685,16 @@ void TeamsTabItem::randomizeTeamnames(bool random)
 
 void TeamsTabItem::updateTeamNamesInTableAndTooltips()
 {
-    auto item = dynamic_cast<TeamTreeWidgetItem*>(teamDataTree->topLevelItem(0));
-    while(item != nullptr) {
-        if(item->treeItemType == TeamTreeWidgetItem::TreeItemType::team) {
-            int teamNum = item->data(0, TEAM_NUMBER_ROLE).toInt();
-            teams[teamNum].createTooltip();
-            item->setText(0, tr("Team ") + teams[teamNum].name);
-            item->setTextAlignment(0, Qt::AlignLeft | Qt::AlignVCenter);
-            item->setData(0, TEAMINFO_DISPLAY_ROLE, tr("Team ") + teams[teamNum].name);
-            for(int column = 0, numColsForToolTips = teamDataTree->columnCount()-1; column < numColsForToolTips; column++) {
-                item->setToolTip(column, teams[teamNum].tooltip);
-            }
+    for(auto teamItem = teamItemsByNumber.cbegin(); teamItem != teamItemsByNumber.cend(); teamItem++) {
+        const int teamNum = teamItem.key();
+        auto *item = teamItem.value();
+        teams[teamNum].invalidateTooltip();
+        item->setText(0, tr("Team ") + teams[teamNum].name);
+        item->setTextAlignment(0, Qt::AlignLeft | Qt::AlignVCenter);
+        item->setData(0, TEAMINFO_DISPLAY_ROLE, tr("Team ") + teams[teamNum].name);
+        for(int column = 0, numColsForToolTips = teamDataTree->columnCount()-1; column < numColsForToolTips; column++) {
+            item->setToolTip(column, teams[teamNum].getTooltip());
         }
-        item = dynamic_cast<TeamTreeWidgetItem*>(teamDataTree->itemBelow(item));
     }
 
     teamDataTree->resizeColumnToContents(0);
@@ -687,11 +721,11 @@ void TeamsTabItem::swapStudents(const QList<int> &arguments) // QList<int> argum
     //Get references to each team and student
     auto &studentATeam = teams[studentATeamNum];
     auto &studentBTeam = teams[studentBTeamNum];
-    const StudentRecord* studentA = findStudentFromID(studentAID);
+    const StudentRecord* studentA = students.findByID(studentAID);
     if(studentA == nullptr) {
         return;
     }
-    const StudentRecord* studentB = findStudentFromID(studentBID);
+    const StudentRecord* studentB = students.findByID(studentBID);
     if(studentB == nullptr) {
         return;
     }
@@ -718,36 +752,13 @@ void TeamsTabItem::swapStudents(const QList<int> &arguments) // QList<int> argum
         std::swap(studentATeam.studentIDs[studentATeam.studentIDs.indexOf(studentA->ID)],
                   studentBTeam.studentIDs[studentBTeam.studentIDs.indexOf(studentB->ID)]);      //(of course, studentATeam == studentBTeam)
 
-        // Re-score the teams and refresh all the info
-        gruepr::calcTeamScores(students, numStudents, teams, teamingOptions);
-        teams[studentATeamNum].refreshTeamInfo(students, teamingOptions->realMeetingBlockSize);
-        teams[studentATeamNum].createTooltip();
-
-        //get the team item in the tree
-        auto teamItem = dynamic_cast<TeamTreeWidgetItem*>(teamDataTree->topLevelItem(0));
-        while((teamItem != nullptr) &&
-               ((teamItem->treeItemType != TeamTreeWidgetItem::TreeItemType::team) ||
-                (teamItem->data(0, TEAM_NUMBER_ROLE).toInt() != studentATeamNum))) {
-            teamItem = dynamic_cast<TeamTreeWidgetItem*>(teamDataTree->itemBelow(teamItem));
-        }
-        if((teamItem != nullptr) && (teamItem->treeItemType == TeamTreeWidgetItem::TreeItemType::team)) {
-            //clear and refresh this team's student items in table
-            for(auto &child : teamItem->takeChildren()) {
-                delete child;
-            }
-            const int numStudentsOnTeam = studentATeam.size;
-            QList<TeamTreeWidgetItem*> childItems;
-            childItems.resize(numStudentsOnTeam);
-            for(int studentNum = 0; studentNum < numStudentsOnTeam; studentNum++) {
-                //Find each teammate based on the ID and make them a leaf on the old team
-                const StudentRecord* teammate = findStudentFromID(studentATeam.studentIDs.at(studentNum));
-                if(teammate == nullptr) {
-                    continue;
-                }
-                childItems[studentNum] = new TeamTreeWidgetItem(TeamTreeWidgetItem::TreeItemType::student);
-                teamDataTree->refreshStudent(childItems[studentNum], *teammate, &teams.dataOptions, teamingOptions);
-                teamItem->addChild(childItems[studentNum]);
-            }
+        // The team's score and info are unchanged by the order of its students, so just trade the two students' rows (if the team has been expanded)
+        TeamTreeWidgetItem *const teamItem = teamItemsByNumber.value(studentATeamNum, nullptr);
+        TeamTreeWidgetItem *const studentAItem = findStudentItem(teamItem, studentA->ID);
+        TeamTreeWidgetItem *const studentBItem = findStudentItem(teamItem, studentB->ID);
+        if((studentAItem != nullptr) && (studentBItem != nullptr)) {
+            teamDataTree->refreshStudent(studentAItem, *studentB, teams.dataOptions.get(), teamingOptions);
+            teamDataTree->refreshStudent(studentBItem, *studentA, teams.dataOptions.get(), teamingOptions);
         }
     }
     else {
@@ -755,76 +766,19 @@ void TeamsTabItem::swapStudents(const QList<int> &arguments) // QList<int> argum
         studentATeam.studentIDs.replace(studentATeam.studentIDs.indexOf(studentA->ID), studentB->ID);
         studentBTeam.studentIDs.replace(studentBTeam.studentIDs.indexOf(studentB->ID), studentA->ID);
 
-        //get the team items in the tree
-        auto studentATeamItem = dynamic_cast<TeamTreeWidgetItem*>(teamDataTree->topLevelItem(0));
-        while((studentATeamItem != nullptr) &&
-               ((studentATeamItem->treeItemType != TeamTreeWidgetItem::TreeItemType::team) ||
-                (studentATeamItem->data(0, TEAM_NUMBER_ROLE).toInt() != studentATeamNum))) {
-            studentATeamItem = dynamic_cast<TeamTreeWidgetItem*>(teamDataTree->itemBelow(studentATeamItem));
-        }
-        auto studentBTeamItem = dynamic_cast<TeamTreeWidgetItem*>(teamDataTree->topLevelItem(0));
-        while((studentBTeamItem != nullptr) &&
-               ((studentBTeamItem->treeItemType != TeamTreeWidgetItem::TreeItemType::team) ||
-                (studentBTeamItem->data(0, TEAM_NUMBER_ROLE).toInt() != studentBTeamNum))) {
-            studentBTeamItem = dynamic_cast<TeamTreeWidgetItem*>(teamDataTree->itemBelow(studentBTeamItem));
-        }
-
         //refresh the info for both teams
-        if((studentATeamItem != nullptr) && (studentATeamItem->treeItemType == TeamTreeWidgetItem::TreeItemType::team) &&
-            (studentBTeamItem != nullptr) && (studentBTeamItem->treeItemType == TeamTreeWidgetItem::TreeItemType::team)) {
-            gruepr::calcTeamScores(students, numStudents, teams, teamingOptions);
-            studentATeam.refreshTeamInfo(students, teamingOptions->realMeetingBlockSize);
-            studentATeam.createTooltip();
-            studentBTeam.refreshTeamInfo(students, teamingOptions->realMeetingBlockSize);
-            studentBTeam.createTooltip();
-            for(const auto &stu : qAsConst(students)) {
-                if(studentATeam.studentIDs.first() == stu.ID) {
-                    const QString firstStudentName = stu.lastname + stu.firstname;
-                    teamDataTree->refreshTeam(TeamTreeWidget::RefreshType::existingTeam, studentATeamItem, studentATeam,
-                                              studentATeamNum, firstStudentName, &teams.dataOptions, teamingOptions);
-                }
-                else if(studentBTeam.studentIDs.first() == stu.ID) {
-                    const QString firstStudentName = stu.lastname + stu.firstname;
-                    teamDataTree->refreshTeam(TeamTreeWidget::RefreshType::existingTeam, studentBTeamItem, studentBTeam,
-                                              studentBTeamNum, firstStudentName, &teams.dataOptions, teamingOptions);
-                }
-            }
-            studentATeamItem->setScoreColor(studentATeam.score);
-            studentBTeamItem->setScoreColor(studentBTeam.score);
-
-            //clear and refresh student items on both teams in table
-            for(auto &child : studentATeamItem->takeChildren()) {
-                delete child;
-            }
-            for(auto &child : studentBTeamItem->takeChildren()) {
-                delete child;
-            }
-            const int numStudentsOnTeamA = studentATeam.size;
-            const int numStudentsOnTeamB = studentBTeam.size;
-            QList<TeamTreeWidgetItem*> childItemsTeamA;
-            childItemsTeamA.resize(numStudentsOnTeamA);
-            for(int studentNum = 0; studentNum < numStudentsOnTeamA; studentNum++) {
-                //Find each teammate based on the ID and make them a leaf on the team
-                const StudentRecord* teammate = findStudentFromID(studentATeam.studentIDs.at(studentNum));
-                if(teammate == nullptr) {
-                    continue;
-                }
-                childItemsTeamA[studentNum] = new TeamTreeWidgetItem(TeamTreeWidgetItem::TreeItemType::student);
-                teamDataTree->refreshStudent(childItemsTeamA[studentNum], *teammate, &teams.dataOptions, teamingOptions);
-                studentATeamItem->addChild(childItemsTeamA[studentNum]);
-            }
-            QList<TeamTreeWidgetItem*> childItemsTeamB;
-            childItemsTeamB.resize(numStudentsOnTeamB);
-            for(int studentNum = 0; studentNum < numStudentsOnTeamB; studentNum++) {
-                //Find each teammate based on the ID and make them a leaf on the team
-                const StudentRecord* teammate = findStudentFromID(studentBTeam.studentIDs.at(studentNum));
-                if(teammate == nullptr) {
-                    continue;
-                }
-                childItemsTeamB[studentNum] = new TeamTreeWidgetItem(TeamTreeWidgetItem::TreeItemType::student);
-                teamDataTree->refreshStudent(childItemsTeamB[studentNum], *teammate, &teams.dataOptions, teamingOptions);
-                studentBTeamItem->addChild(childItemsTeamB[studentNum]);
-            }
+        gruepr::calcTeamScores(students, teams, teamingOptions, {studentATeamNum, studentBTeamNum}, &studentIDsInTeams);
+        refreshTeamItem(studentATeamNum);
+        refreshTeamItem(studentBTeamNum);
+
+        //each student's row now shows the other student (if the team has been expanded)
+        TeamTreeWidgetItem *const studentAItem = findStudentItem(teamItemsByNumber.value(studentATeamNum, nullptr), studentA->ID);
+        if(studentAItem != nullptr) {
+            teamDataTree->refreshStudent(studentAItem, *studentB, teams.dataOptions.get(), teamingOptions);
+        }
+        TeamTreeWidgetItem *const studentBItem = findStudentItem(teamItemsByNumber.value(studentBTeamNum, nullptr), studentB->ID);
+        if(studentBItem != nullptr) {
+            teamDataTree->refreshStudent(studentBItem, *studentA, teams.dataOptions.get(), teamingOptions);
         }
     }
     refreshSummaryTable(*teamingOptions);
@@ -833,6 +787,55 @@ void TeamsTabItem::swapStudents(const QList<int> &arguments) // QList<int> argum
 }
 
 
+TeamTreeWidget::ScorePreview TeamsTabItem::previewScores(const QList<int> &arguments) const
+{
+    // arguments are either for a swap (int studentAteam, int studentAID, int studentBteam, int studentBID) or a move (int oldTeam, int studentID, int newTeam)
+    TeamTreeWidget::ScorePreview preview;
+    const int teamANum = arguments.at(0), teamBNum = arguments.at(2);
+    if((teamANum < 0) || (teamANum >= teams.size()) || (teamBNum < 0) || (teamBNum >= teams.size()) || (teamANum == teamBNum)) {
+        return preview;
+    }
+    const TeamRecord &teamA = teams.at(teamANum);
+    const TeamRecord &teamB = teams.at(teamBNum);
+    QList<long long> newTeamA = teamA.studentIDs, newTeamB = teamB.studentIDs;
+    if(arguments.size() == 4) {
+        const int studentAIndex = int(newTeamA.indexOf(arguments.at(1))), studentBIndex = int(newTeamB.indexOf(arguments.at(3)));
+        if((studentAIndex == -1) || (studentBIndex == -1)) {
+            return preview;
+        }
+        newTeamA[studentAIndex] = arguments.at(3);
+        newTeamB[studentBIndex] = arguments.at(1);
+    }
+    else {
+        if(!newTeamA.removeOne(arguments.at(1))) {
+            return preview;
+        }
+        newTeamB << arguments.at(1);
+    }
+
+    // score both teams as they are and as they would be, all together so that the before and after are consistent
+    const QList<gruepr::TeamScores> scores = gruepr::scoreTeams(students, {teamA.studentIDs, teamB.studentIDs, newTeamA, newTeamB},
+                                                                teamingOptions, teams.dataOptions.get(), &studentIDsInTeams);
+    const gruepr::TeamScores &teamABefore = scores.at(0), &teamBBefore = scores.at(1), &teamAAfter = scores.at(2), &teamBAfter = scores.at(3);
+    preview.teamAChange = teamAAfter.score - teamABefore.score;
+    preview.teamBChange = teamBAfter.score - teamBBefore.score;
+    preview.netChange = teams.netScoreWith({{teamANum, teamAAfter.score, int(newTeamA.size())}, {teamBNum, teamBAfter.score, int(newTeamB.size())}}) -
+                        teams.netScoreWith({{teamANum, teamABefore.score, int(teamA.studentIDs.size())}, {teamBNum, teamBBefore.score, int(teamB.studentIDs.size())}});
+    const auto penaltyChange = [](const gruepr::TeamScores &before, const gruepr::TeamScores &after) {
+        if((before.penaltyPoints == 0) && (after.penaltyPoints > 0)) {
+            return TeamTreeWidget::PenaltyChange::added;
+        }
+        if((before.penaltyPoints > 0) && (after.penaltyPoints == 0)) {
+            return TeamTreeWidget::PenaltyChange::removed;
+        }
+        return TeamTreeWidget::PenaltyChange::none;
+    };
+    preview.teamAPenalty = penaltyChange(teamABefore, teamAAfter);
+    preview.teamBPenalty = penaltyChange(teamBBefore, teamBAfter);
+    return preview;
+}
+
+
 void TeamsTabItem::moveAStudent(const QList<int> &arguments) // QList<int> arguments = int oldTeam, int studentID, int newTeam
 {
     if(arguments.size() != 3) {
@@ -856,7 +859,7 @@ void TeamsTabItem::moveAStudent(const QList<int> &arguments) // QList<int> argum
         return;
     }
 
-    const StudentRecord* student = findStudentFromID(studentID);
+    const StudentRecord* student = students.findByID(studentID);
     if(student == nullptr) {
         return;
     }
@@ -884,77 +887,22 @@ void TeamsTabItem::moveAStudent(const QList<int> &arguments) // QList<int> argum
     newTeam.studentIDs << studentID;
     newTeam.size++;
 
-    //get the team items in the tree
-    auto oldTeamItem = dynamic_cast<TeamTreeWidgetItem*>(teamDataTree->topLevelItem(0));
-    while((oldTeamItem != nullptr) &&
-           ((oldTeamItem->treeItemType != TeamTreeWidgetItem::TreeItemType::team) ||
-            (oldTeamItem->data(0, TEAM_NUMBER_ROLE).toInt() != oldTeamNum))) {
-        oldTeamItem = dynamic_cast<TeamTreeWidgetItem*>(teamDataTree->itemBelow(oldTeamItem));
-    }
-    auto newTeamItem = dynamic_cast<TeamTreeWidgetItem*>(teamDataTree->topLevelItem(0));
-    while((newTeamItem != nullptr) &&
-           ((newTeamItem->treeItemType != TeamTreeWidgetItem::TreeItemType::team) ||
-            (newTeamItem->data(0, TEAM_NUMBER_ROLE).toInt() != newTeamNum))) {
-        newTeamItem = dynamic_cast<TeamTreeWidgetItem*>(teamDataTree->itemBelow(newTeamItem));
-    }
-
-    //refresh the info, tooltip, treeitem for both teams
-    if((oldTeamItem != nullptr) && (oldTeamItem->treeItemType == TeamTreeWidgetItem::TreeItemType::team) &&
-        (newTeamItem != nullptr) && (newTeamItem->treeItemType == TeamTreeWidgetItem::TreeItemType::team)) {
-        gruepr::calcTeamScores(students, numStudents, teams, teamingOptions);
-        oldTeam.refreshTeamInfo(students, teamingOptions->realMeetingBlockSize);
-        oldTeam.createTooltip();
-        newTeam.refreshTeamInfo(students, teamingOptions->realMeetingBlockSize);
-        newTeam.createTooltip();
-        for(const auto &stu : qAsConst(students)) {
-            if(oldTeam.studentIDs.first() == stu.ID) {
-                const QString firstStudentName = stu.lastname + stu.firstname;
-                teamDataTree->refreshTeam(TeamTreeWidget::RefreshType::existingTeam, oldTeamItem, oldTeam,
-                                          oldTeamNum, firstStudentName, &teams.dataOptions, teamingOptions);
-            }
-            else if(newTeam.studentIDs.first() == stu.ID) {
-                const QString firstStudentName = stu.lastname + stu.firstname;
-                teamDataTree->refreshTeam(TeamTreeWidget::RefreshType::existingTeam, newTeamItem, newTeam,
-                                          newTeamNum, firstStudentName, &teams.dataOptions, teamingOptions);
-            }
-        }
-        oldTeamItem->setScoreColor(oldTeam.score);
-        newTeamItem->setScoreColor(newTeam.score);
-
-        //clear and refresh student items on both teams in table
-        for(auto &child : oldTeamItem->takeChildren()) {
-            delete child;
-        }
-        for(auto &child : newTeamItem->takeChildren()) {
-            delete child;
-        }
-        //clear and refresh student items on both teams in table
-        const int numStudentsOnOldTeam = oldTeam.size;
-        const int numStudentsOnNewTeam = newTeam.size;
-        QList<TeamTreeWidgetItem*> childItemsOldTeam;
-        childItemsOldTeam.resize(std::max(numStudentsOnOldTeam, numStudentsOnNewTeam));
-        for(int studentNum = 0; studentNum < numStudentsOnOldTeam; studentNum++) {
-            //Find each teammate based on the ID and make them a leaf on the old team
-            const StudentRecord* teammate = findStudentFromID(oldTeam.studentIDs.at(studentNum));
-            if(teammate == nullptr) {
-                continue;
-            }
-            childItemsOldTeam[studentNum] = new TeamTreeWidgetItem(TeamTreeWidgetItem::TreeItemType::student);
-            teamDataTree->refreshStudent(childItemsOldTeam[studentNum], *teammate, &teams.dataOptions, teamingOptions);
-            oldTeamItem->addChild(childItemsOldTeam[studentNum]);
-        }
-        QList<TeamTreeWidgetItem*> childItemsNewTeam;
-        childItemsNewTeam.resize(std::max(numStudentsOnOldTeam, numStudentsOnNewTeam));
-        for(int studentNum = 0; studentNum < numStudentsOnNewTeam; studentNum++) {
-            //Find each teammate based on the ID and make them a leaf on the new team
-            const StudentRecord* teammate = findStudentFromID(newTeam.studentIDs.at(studentNum));
-            if(teammate == nullptr) {
-                continue;
-            }
-            childItemsNewTeam[studentNum] = new TeamTreeWidgetItem(TeamTreeWidgetItem::TreeItemType::student);
-            teamDataTree->refreshStudent(childItemsNewTeam[studentNum], *teammate, &teams.dataOptions, teamingOptions);
-            newTeamItem->addChild(childItemsNewTeam[studentNum]);
-        }
+    //refresh the info for both teams
+    gruepr::calcTeamScores(students, teams, teamingOptions, {oldTeamNum, newTeamNum}, &studentIDsInTeams);
+    refreshTeamItem(oldTeamNum);
+    refreshTeamItem(newTeamNum);
+
+    //the student's row leaves the old team and joins the new team (for each team that has been expanded)
+    TeamTreeWidgetItem *const oldTeamItem = teamItemsByNumber.value(oldTeamNum, nullptr);
+    TeamTreeWidgetItem *const movedStudentItem = findStudentItem(oldTeamItem, studentID);
+    if(movedStudentItem != nullptr) {
+        delete oldTeamItem->takeChild(oldTeamItem->indexOfChild(movedStudentItem));
+    }
+    TeamTreeWidgetItem *const newTeamItem = teamItemsByNumber.value(newTeamNum, nullptr);
+    if((newTeamItem != nullptr) && (newTeamItem->childCount() > 0)) {
+        auto *studentItem = new TeamTreeWidgetItem(TeamTreeWidgetItem::TreeItemType::student);
+        teamDataTree->refreshStudent(studentItem, *student, teams.dataOptions.get(), teamingOptions);
+        newTeamItem->addChild(studentItem);
     }
     refreshSummaryTable(*teamingOptions);
     teamDataTree->setUpdatesEnabled(true);
@@ -1113,6 +1061,208 @@ void TeamsTabItem::undoRedoDragDrop()
 }
 
 
+void TeamsTabItem::suggestImprovements()
+{
+    QApplication::setOverrideCursor(QCursor(Qt::BusyCursor));
+    const QList<SuggestedChange> suggestions = findBestChanges(MAXSUGGESTIONS);
+    QApplication::restoreOverrideCursor();
+
+    // offer the suggestions in a menu; each one chosen is made just like a drag-and-drop, so it can be undone
+    QMenu suggestionsMenu(this);
+    if(suggestions.isEmpty()) {
+        suggestionsMenu.addAction(tr("No swap or move of a student would improve the overall score"))->setEnabled(false);
+    }
+    for(const auto &suggestion : suggestions) {
+        const QList<int> &arguments = suggestion.arguments;
+        const StudentRecord *const studentA = students.findByID(arguments.at(1));
+        if(studentA == nullptr) {
+            continue;
+        }
+        QString text;
+        if(arguments.size() == 4) {
+            const StudentRecord *const studentB = students.findByID(arguments.at(3));
+            if(studentB == nullptr) {
+                continue;
+            }
+            text = tr("Swap ") + studentA->firstname + " " + studentA->lastname + " (" + teams.at(arguments.at(0)).name + ")" + tr(" and ") +
+                   studentB->firstname + " " + studentB->lastname + " (" + teams.at(arguments.at(2)).name + ")";
+        }
+        else {
+            text = tr("Move ") + studentA->firstname + " " + studentA->lastname + tr(" from ") + teams.at(arguments.at(0)).name +
+                   tr(" to ") + teams.at(arguments.at(2)).name;
+        }
+        text += ":  " + tr("overall score") + " +" + QString::number(double(suggestion.netChange), 'f', 1);
+        QAction *action = suggestionsMenu.addAction(QIcon((arguments.size() == 4)? ":/icons_new/swap.png" : ":/icons_new/move.png"), text);
+        connect(action, &QAction::triggered, this, [this, arguments]{
+            if(arguments.size() == 4) {
+                swapStudents(arguments);
+            }
+            else {
+                moveAStudent(arguments);
+            }
+        });
+    }
+    suggestionsMenu.exec(suggestButton->mapToGlobal(QPoint(0, suggestButton->height())));
+}
+
+
+//////////////////
+// Evaluate every swap of two students on different teams and every move of a student to another team, returning the ones that most improve the
+// net score of the set, best first. Only changes that could be made by hand are considered: within a section if teams are made in separate sections,
+// without separating required teammates or joining prevented ones, and with moves only if the team sizes stay within their current range.
+//////////////////
+QList<TeamsTabItem::SuggestedChange> TeamsTabItem::findBestChanges(const int maxSuggestions)
+{
+    // score a copy of the teams, so that each change is measured against up-to-date scores without changing the ones displayed
+    TeamSet currentTeams = teams;
+    gruepr::calcTeamScores(students, currentTeams, teamingOptions);
+    const int numTeams = int(currentTeams.size());
+    const float currentNetScore = currentTeams.netScore();   // also brings the copy's running score totals up to date before they are read in parallel
+    if(students.isEmpty() || (numTeams < 2)) {
+        return {};
+    }
+    const StudentList &studentList = students;
+
+    // the students on each team as indexes into the student list, resolved once here rather than for each change scored
+    QHash<long long, int> indexOfStudent;
+    indexOfStudent.reserve(studentList.size());
+    for(int index = 0; index < studentList.size(); index++) {
+        indexOfStudent.insert(studentList.at(index).ID, index);
+    }
+    int minTeamSize = std::numeric_limits<int>::max(), maxTeamSize = 0;
+    QList<QList<int>> teamIndexes(numTeams);
+    QList<int> teamSections(numTeams, 0);
+    QList<bool> canLeaveTeam(studentList.size(), true);
+    for(int teamNum = 0; teamNum < numTeams; teamNum++) {
+        const TeamRecord &team = currentTeams.at(teamNum);
+        minTeamSize = std::min(minTeamSize, int(team.studentIDs.size()));
+        maxTeamSize = std::max(maxTeamSize, int(team.studentIDs.size()));
+        QList<int> &indexes = teamIndexes[teamNum];
+        indexes.reserve(team.studentIDs.size());
+        for(const auto studentID : team.studentIDs) {
+            indexes << indexOfStudent.value(studentID);
+        }
+        if(indexes.isEmpty()) {
+            continue;
+        }
+        teamSections[teamNum] = studentList.at(indexes.constFirst()).section.id();
+        for(const auto index : qAsConst(indexes)) {
+            const StudentRecord &student = studentList.at(index);
+            for(const auto teammateIndex : qAsConst(indexes)) {
+                const StudentRecord &teammate = studentList.at(teammateIndex);
+                if(student.requiredWith.contains(teammate.ID) || teammate.requiredWith.contains(student.ID)) {
+                    canLeaveTeam[index] = false;
+                }
+            }
+        }
+    }
+    const bool separateSections = (teamingOptions->sectionType == TeamingOptions::SectionType::allSeparately);
+
+    // whether a student could join the students on a team (other than one being swapped off of it) without a prevented teammate
+    const auto canJoin = [&studentList](const int studentIndex, const QList<int> &team, const int leavingIndex) {
+        const StudentRecord &student = studentList.at(studentIndex);
+        for(const auto teammateIndex : team) {
+            const StudentRecord &teammate = studentList.at(teammateIndex);
+            if((teammateIndex != leavingIndex) && (student.preventedWith.contains(teammate.ID) || teammate.preventedWith.contains(student.ID))) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // for each team, look at all of the changes between it and each team after it; keep the best of these in a min-heap (the worst kept is on top)
+    const auto worseChange = [](const SuggestedChange &a, const SuggestedChange &b){return a.netChange > b.netChange;};
+    const auto findBestChangesFromTeam = [&](const int teamANum) {
+        QList<SuggestedChange> bestChanges;
+        bestChanges.reserve(maxSuggestions + 1);
+
+        // each changed pair of teams is written into one genome, A then B, and scored without allocating anything per change
+        gruepr::TeamScorer scorer(studentList.constData(), teamingOptions, currentTeams.dataOptions.get(), &studentIDsInTeams, 2);
+        QList<int> genome(2 * maxTeamSize + 1);
+        int teamSizes[2] = {0, 0};
+        const auto writeTeam = [&genome](int position, const QList<int> &team, const int leavingPosition, const int joiningIndex) {
+            for(int member = 0; member < team.size(); member++) {
+                if(member != leavingPosition) {
+                    genome[position++] = team.at(member);
+                }
+            }
+            if(joiningIndex != -1) {
+                genome[position++] = joiningIndex;
+            }
+            return position;
+        };
+        const auto consider = [&](QList<int> &&arguments, const int teamBNum, const QList<int> &teamA, const int leavingA, const int joiningA,
+                                  const QList<int> &teamB, const int leavingB, const int joiningB) {
+            teamSizes[0] = writeTeam(0, teamA, leavingA, joiningA);
+            teamSizes[1] = writeTeam(teamSizes[0], teamB, leavingB, joiningB) - teamSizes[0];
+            const float *const newScores = scorer.score(genome.constData(), 2, teamSizes);
+            const float netChange = currentTeams.netScoreWith({{teamANum, newScores[0], teamSizes[0]}, {teamBNum, newScores[1], teamSizes[1]}}) - currentNetScore;
+            if((netChange < MINSUGGESTEDCHANGE) || ((bestChanges.size() == maxSuggestions) && (netChange <= bestChanges.constFirst().netChange))) {
+                return;
+            }
+            bestChanges.append({std::move(arguments), netChange});
+            std::push_heap(bestChanges.begin(), bestChanges.end(), worseChange);
+            if(bestChanges.size() > maxSuggestions) {
+                std::pop_heap(bestChanges.begin(), bestChanges.end(), worseChange);
+                bestChanges.removeLast();
+            }
+        };
+
+        const QList<int> &teamA = teamIndexes.at(teamANum);
+        for(int teamBNum = teamANum + 1; teamBNum < numTeams; teamBNum++) {
+            if(separateSections && (teamSections.at(teamANum) != teamSections.at(teamBNum))) {
+                continue;
+            }
+            const QList<int> &teamB = teamIndexes.at(teamBNum);
+            for(int a = 0; a < teamA.size(); a++) {
+                const int studentA = teamA.at(a);
+                if(!canLeaveTeam.at(studentA)) {
+                    continue;
+                }
+                const int studentAID = int(studentList.at(studentA).ID);
+                // swaps
+                for(int b = 0; b < teamB.size(); b++) {
+                    const int studentB = teamB.at(b);
+                    if(!canLeaveTeam.at(studentB) || !canJoin(studentA, teamB, studentB) || !canJoin(studentB, teamA, studentA)) {
+                        continue;
+                    }
+                    consider({teamANum, studentAID, teamBNum, int(studentList.at(studentB).ID)}, teamBNum, teamA, a, studentB, teamB, b, studentA);
+                }
+                // moves from A to B
+                if((teamA.size() > minTeamSize) && (teamB.size() < maxTeamSize) && (teamA.size() > 1) && canJoin(studentA, teamB, -1)) {
+                    consider({teamANum, studentAID, teamBNum}, teamBNum, teamA, a, -1, teamB, -1, studentA);
+                }
+            }
+            // moves from B to A
+            if((teamB.size() > minTeamSize) && (teamA.size() < maxTeamSize) && (teamB.size() > 1)) {
+                for(int b = 0; b < teamB.size(); b++) {
+                    const int studentB = teamB.at(b);
+                    if(!canLeaveTeam.at(studentB) || !canJoin(studentB, teamA, -1)) {
+                        continue;
+                    }
+                    consider({teamBNum, int(studentList.at(studentB).ID), teamANum}, teamBNum, teamA, -1, studentB, teamB, b, -1);
+                }
+            }
+        }
+        return bestChanges;
+    };
+
+    QList<int> teamNums(numTeams);
+    std::iota(teamNums.begin(), teamNums.end(), 0);
+    const QList<QList<SuggestedChange>> bestChangesFromEachTeam = QtConcurrent::blockingMapped<QList<QList<SuggestedChange>>>(teamNums, findBestChangesFromTeam);
+
+    QList<SuggestedChange> bestChanges;
+    for(const auto &changes : bestChangesFromEachTeam) {
+        bestChanges << changes;
+    }
+    std::sort(bestChanges.begin(), bestChanges.end(), [](const SuggestedChange &a, const SuggestedChange &b){return a.netChange > b.netChange;});
+    if(bestChanges.size() > maxSuggestions) {
+        bestChanges.resize(maxSuggestions);
+    }
+    return bestChanges;
+}
+
+
 void TeamsTabItem::makeNewSetWithAllNewTeammates()
 {
     if(teamingOptions->haveAnyRequiredTeammates || teamingOptions->haveAnyRequestedTeammates) {
@@ -1134,17 +1284,12 @@ void TeamsTabItem::makeNewSetWithAllNewTeammates()
 
     for(const auto &team : qAsConst(teams)) {
         for(const auto ID1 : qAsConst(team.studentIDs)) {
+            StudentRecord *const stu = externalStudents->findByID(ID1);
+            if(stu == nullptr) {
+                continue;
+            }
             for(const auto ID2 : qAsConst(team.studentIDs)) {
                 if(ID1 != ID2) {
-                    StudentRecord* stu = nullptr;
-                    for(auto &student1 : *externalStudents) {
-                        if(student1.ID == ID1) {
-                            stu = &student1;
-                        }
-                    }
-                    if(stu == nullptr) {
-                        continue;
-                    }
                     stu->preventedWith << ID2;
                 }
             }
@@ -1152,6 +1297,7 @@ void TeamsTabItem::makeNewSetWithAllNewTeammates()
     }
 
     externalTeamingOptions->haveAnyPreventedTeammates = true;
+    emit studentsChanged();
     externalDoItButton->animateClick();
 }
 
@@ -1166,7 +1312,7 @@ void TeamsTabItem::saveTeams()
                                   tr("(Custom contents)")};
 
     //Open specialized dialog box to choose which file(s) to save
-    auto *window = new WhichFilesDialog(WhichFilesDialog::Action::save, &teams.dataOptions, teamingOptions->sectionType, previews, this);
+    auto *window = new WhichFilesDialog(WhichFilesDialog::Action::save, teams.dataOptions.get(), teamingOptions->sectionType, previews, this);
     if(window->exec() == QDialog::Accepted) {
         if(window->fileType == WhichFilesDialog::FileType::custom) {
             fileContents[customFile] = createCustomFileContents(window->customFileOptions);
@@ -1222,7 +1368,7 @@ void TeamsTabItem::printTeams()
                                   tr("(Custom contents)")};
 
     //Open specialized dialog box to choose which file(s) to print
-    auto *window = new WhichFilesDialog(WhichFilesDialog::Action::print, &teams.dataOptions, teamingOptions->sectionType, previews, this);
+    auto *window = new WhichFilesDialog(WhichFilesDialog::Action::print, teams.dataOptions.get(), teamingOptions->sectionType, previews, this);
     if(window->exec() == QDialog::Accepted) {
         if(window->fileType == WhichFilesDialog::FileType::custom) {
             fileContents[customFile] = createCustomFileContents(window->customFileOptions);
@@ -1294,7 +1440,7 @@ void TeamsTabItem::postTeamsToCanvas()
         teamRoster.clear();
         //loop through each teammate in the team
         for(const auto studentID : qAsConst(team.studentIDs)) {
-            teamRoster << *findStudentFromID(studentID);
+            teamRoster << *students.findByID(studentID);
         }
         teamRosters << teamRoster;
     }
@@ -1326,15 +1472,78 @@ void TeamsTabItem::postTeamsToCanvas()
 }
 
 
+void TeamsTabItem::populateTeamItem(TeamTreeWidgetItem *teamItem)
+{
+    const int teamNum = teamItem->data(0, TEAM_NUMBER_ROLE).toInt();
+    if((teamNum < 0) || (teamNum >= teams.size()) || (teamItem->childCount() > 0)) {
+        return;
+    }
+
+    QList<QTreeWidgetItem*> studentItems;
+    studentItems.reserve(teams.at(teamNum).studentIDs.size());
+    for(const auto studentID : teams.at(teamNum).studentIDs) {
+        const StudentRecord *const student = students.findByID(studentID);
+        if(student == nullptr) {
+            continue;
+        }
+        auto *studentItem = new TeamTreeWidgetItem(TeamTreeWidgetItem::TreeItemType::student);
+        teamDataTree->refreshStudent(studentItem, *student, teams.dataOptions.get(), teamingOptions);
+        studentItems << studentItem;
+    }
+    teamItem->addChildren(studentItems);
+}
+
+
+void TeamsTabItem::refreshTeamItem(const int teamNum)
+{
+    // update the team's info and tooltip, then its row
+    auto &team = teams[teamNum];
+    team.refreshTeamInfo(std::make_shared<const StudentList>(students), teamingOptions->realMeetingBlockSize);
+    team.invalidateTooltip();
+
+    TeamTreeWidgetItem *const teamItem = teamItemsByNumber.value(teamNum, nullptr);
+    const StudentRecord *const firstStudent = students.findByID(team.studentIDs.constFirst());
+    if((teamItem == nullptr) || (firstStudent == nullptr)) {
+        return;
+    }
+    teamDataTree->refreshTeam(TeamTreeWidget::RefreshType::existingTeam, teamItem, team, teamNum,
+                              firstStudent->lastname + firstStudent->firstname, teams.dataOptions.get(), teamingOptions);
+    teamItem->setScoreColor(team.score);
+}
+
+
+TeamTreeWidgetItem *TeamsTabItem::findStudentItem(const TeamTreeWidgetItem *teamItem, const long long studentID) const
+{
+    if(teamItem == nullptr) {
+        return nullptr;
+    }
+    for(int child = 0; child < teamItem->childCount(); child++) {
+        auto *studentItem = dynamic_cast<TeamTreeWidgetItem*>(teamItem->child(child));
+        if((studentItem != nullptr) && (studentItem->data(0, Qt::UserRole).toLongLong() == studentID)) {
+            return studentItem;
+        }
+    }
+    return nullptr;
+}
+
+
 void TeamsTabItem::refreshTeamDisplay()
 {
-    //Create TeamTreeWidgetItems for the sections, teams, and students
+    //Create TeamTreeWidgetItems for the sections and teams; the student items on a team are created when it is first expanded
     QList<TeamTreeWidgetItem*> sectionItems;
     sectionItems.reserve(sectionNames.size());
     QList<TeamTreeWidgetItem*> teamItems;
     teamItems.reserve(teams.size());
-    QList<TeamTreeWidgetItem*> studentItems;
-    studentItems.reserve(numStudents);
+    teamItemsByNumber.clear();
+    teamItemsByNumber.reserve(teams.size());
+    const auto createTeamItem = [this, &teamItems](const TeamRecord &team, const int teamNum, const StudentRecord *const firstStudent) {
+        const QString firstStudentName = firstStudent->lastname + firstStudent->firstname;
+        teamItems << new TeamTreeWidgetItem(TeamTreeWidgetItem::TreeItemType::team, teamDataTree->columnCount(), team.score);
+        teamDataTree->refreshTeam(TeamTreeWidget::RefreshType::newTeam, teamItems.last(), team, teamNum,
+                                  firstStudentName, teams.dataOptions.get(), teamingOptions);
+        teamItemsByNumber.insert(teamNum, teamItems.last());
+        return teamItems.last();
+    };
 
     //iterate through sections or teams
     if(teamingOptions->sectionType == TeamingOptions::SectionType::allSeparately) {
@@ -1342,67 +1551,22 @@ void TeamsTabItem::refreshTeamDisplay()
             sectionItems << new TeamTreeWidgetItem(TeamTreeWidgetItem::TreeItemType::section);
             teamDataTree->refreshSection(sectionItems.last(), sectionName);
 
-            //remove all team items in the section
-            for(auto &teamItem : sectionItems.last()->takeChildren()) {
-                sectionItems.last()->removeChild(teamItem);
-                delete teamItem;
-            }
-
             //iterate through teams
             int teamNum = 0;
             for(const auto &team : qAsConst(teams)) {
-                const StudentRecord *const firstStudent = findStudentFromID(team.studentIDs.at(0));
-                const QString firstStudentName = firstStudent->lastname + firstStudent->firstname;
-                if(firstStudent->section == sectionName) {
-                    teamItems << new TeamTreeWidgetItem(TeamTreeWidgetItem::TreeItemType::team, teamDataTree->columnCount(), team.score);
-                    teamDataTree->refreshTeam(TeamTreeWidget::RefreshType::newTeam, teamItems.last(), team, teamNum,
-                                              firstStudentName, &teams.dataOptions, teamingOptions);
-
-                    //remove all student items in the team
-                    for(auto &studentItem : teamItems.last()->takeChildren()) {
-                        teamItems.last()->removeChild(studentItem);
-                        delete studentItem;
-                    }
-
-                    //add new student items
-                    for(const auto studentID : team.studentIDs) {
-                        studentItems << new TeamTreeWidgetItem(TeamTreeWidgetItem::TreeItemType::student);
-                        teamDataTree->refreshStudent(studentItems.last(), *findStudentFromID(studentID), &teams.dataOptions, teamingOptions);
-                        teamItems.last()->addChild(studentItems.last());
-                    }
-
-                    teamItems.last()->setExpanded(false);
-                    sectionItems.last()->addChild(teamItems.last());
+                const StudentRecord *const firstStudent = students.findByID(team.studentIDs.at(0));
+                if(firstStudent->section.toString() == sectionName) {
+                    sectionItems.last()->addChild(createTeamItem(team, teamNum, firstStudent));
                 }
                 teamNum++;
             }
-            sectionItems.last()->setExpanded(true);
         }
     }
     else {
         //iterate through teams
         int teamNum = 0;
         for(const auto &team : qAsConst(teams)) {
-            teamItems << new TeamTreeWidgetItem(TeamTreeWidgetItem::TreeItemType::team, teamDataTree->columnCount(), team.score);
-            const StudentRecord *const firstStudent = findStudentFromID(team.studentIDs.at(0));
-            const QString firstStudentName = firstStudent->lastname + firstStudent->firstname;
-            teamDataTree->refreshTeam(TeamTreeWidget::RefreshType::newTeam, teamItems.last(), team,
-                                      teamNum, firstStudentName, &teams.dataOptions, teamingOptions);
-
-            //remove all student items in the team
-            for(auto &studentItem : teamItems.last()->takeChildren()) {
-                teamItems.last()->removeChild(studentItem);
-                delete studentItem;
-            }
-
-            //add new student items
-            for(const auto studentID : team.studentIDs) {
-                studentItems << new TeamTreeWidgetItem(TeamTreeWidgetItem::TreeItemType::student);
-                teamDataTree->refreshStudent(studentItems.last(), *findStudentFromID(studentID), &teams.dataOptions, teamingOptions);
-                teamItems.last()->addChild(studentItems.last());
-            }
-
-            teamItems.last()->setExpanded(false);
+            createTeamItem(team, teamNum, students.findByID(team.studentIDs.at(0)));
             teamNum++;
         }
     }
@@ -1465,17 +1629,6 @@ QList<int> TeamsTabItem::getTeamNumbersInDisplayOrder() const
 }
 
 
-inline StudentRecord* TeamsTabItem::findStudentFromID(const long long ID)
-{
-    for(auto &student : students) {
-        if(student.ID == ID) {
-            return &student;
-        }
-    }
-    return nullptr;
-}
-
-
 QStringList TeamsTabItem::createStdFileContents()
 {
     QStringList fileContents(NUMEXPORTFILES);
@@ -1485,28 +1638,28 @@ QStringList TeamsTabItem::createStdFileContents()
 
     spreadsheetFileContents = tr("Section") + "\t" + tr("Team") + "\t" + tr("Name") + "\t" + tr("Email") + "\n";
 
-    instructorsFileContents = tr("Source: ") + teams.dataOptions.dataSourceName;
-    if(teams.dataOptions.sectionIncluded) {
+    instructorsFileContents = tr("Source: ") + teams.dataOptions->dataSourceName;
+    if(teams.dataOptions->sectionIncluded) {
         instructorsFileContents += "\n" + tr("Section: ") + teamingOptions->sectionName;
     }
     instructorsFileContents += "\n\n" + tr("Teaming Options") + ":";
-    if(teams.dataOptions.genderIncluded) {
+    if(teams.dataOptions->genderIncluded) {
         instructorsFileContents += (teamingOptions->isolatedWomenPrevented? ("\n" + tr("Isolated women prevented")) : "");
         instructorsFileContents += (teamingOptions->isolatedMenPrevented? ("\n" + tr("Isolated men prevented")) : "");
         instructorsFileContents += (teamingOptions->isolatedNonbinaryPrevented? ("\n" + tr("Isolated nonbinary students prevented")) : "");
         instructorsFileContents += (teamingOptions->singleGenderPrevented? ("\n" + tr("Single gender teams prevented")) : "");
     }
-    if(teams.dataOptions.URMIncluded && teamingOptions->isolatedURMPrevented) {
+    if(teams.dataOptions->URMIncluded && teamingOptions->isolatedURMPrevented) {
         instructorsFileContents += "\n" + tr("Isolated URM students prevented");
     }
-    if(!teams.dataOptions.dayNames.isEmpty() && teamingOptions->scheduleWeight > 0) {
+    if(!teams.dataOptions->dayNames.isEmpty() && teamingOptions->scheduleWeight > 0) {
         instructorsFileContents += "\n" + tr("Meeting block size is ") + QString::number(teamingOptions->meetingBlockSize) +
                                                                          tr(" hour") + ((teamingOptions->meetingBlockSize == 1) ? "" : tr("s"));
         instructorsFileContents += "\n" + tr("Minimum number of meeting times = ") + QString::number(teamingOptions->minTimeBlocksOverlap);
         instructorsFileContents += "\n" + tr("Desired number of meeting times = ") + QString::number(teamingOptions->desiredTimeBlocksOverlap);
         instructorsFileContents += "\n" + tr("Schedule weight = ") + QString::number(double(teamingOptions->scheduleWeight));
     }
-    for(int attrib = 0; attrib < teams.dataOptions.numAttributes; attrib++) {
+    for(int attrib = 0; attrib < teams.dataOptions->numAttributes; attrib++) {
         instructorsFileContents += "\n" + tr("Multiple choice Q") + QString::number(attrib+1) + ": "
                                    + tr("weight") + " = " + QString::number(double(teamingOptions->attributeWeights[attrib]));
         // Check the attribute diversity type explicitly
@@ -1519,20 +1672,20 @@ QStringList TeamsTabItem::createStdFileContents()
         }
     }
     instructorsFileContents += "\n\n\n";
-    for(int attrib = 0; attrib < teams.dataOptions.numAttributes; attrib++) {
+    for(int attrib = 0; attrib < teams.dataOptions->numAttributes; attrib++) {
         QString questionWithResponses = tr("Multiple choice Q") + QString::number(attrib+1) + "\n" +
-                                        teams.dataOptions.attributeQuestionText.at(attrib) + "\n" + tr("Responses:");
-        for(int response = 0; response < teams.dataOptions.attributeQuestionResponses[attrib].size(); response++) {
-            if((teams.dataOptions.attributeType[attrib] == DataOptions::AttributeType::ordered) ||
-                (teams.dataOptions.attributeType[attrib] == DataOptions::AttributeType::multiordered) ||
-                (teams.dataOptions.attributeType[attrib] == DataOptions::AttributeType::timezone)) {
-                questionWithResponses += "\n\t" + teams.dataOptions.attributeQuestionResponses[attrib].at(response);
+                                        teams.dataOptions->attributeQuestionText.at(attrib) + "\n" + tr("Responses:");
+        for(int response = 0; response < teams.dataOptions->attributeQuestionResponses[attrib].size(); response++) {
+            if((teams.dataOptions->attributeType[attrib] == DataOptions::AttributeType::ordered) ||
+                (teams.dataOptions->attributeType[attrib] == DataOptions::AttributeType::multiordered) ||
+                (teams.dataOptions->attributeType[attrib] == DataOptions::AttributeType::timezone)) {
+                questionWithResponses += "\n\t" + teams.dataOptions->attributeQuestionResponses[attrib].at(response);
             }
-            else if((teams.dataOptions.attributeType[attrib] == DataOptions::AttributeType::categorical) ||
-                    (teams.dataOptions.attributeType[attrib] == DataOptions::AttributeType::multicategorical)) {
+            else if((teams.dataOptions->attributeType[attrib] == DataOptions::AttributeType::categorical) ||
+                    (teams.dataOptions->attributeType[attrib] == DataOptions::AttributeType::multicategorical)) {
                 questionWithResponses += "\n\t" + (response < 26 ? QString(char(response + 'A')) :
                                                                    QString(char(response%26 + 'A')).repeated(1 + (response/26)));
-                questionWithResponses += ". " + teams.dataOptions.attributeQuestionResponses[attrib].at(response);
+                questionWithResponses += ". " + teams.dataOptions->attributeQuestionResponses[attrib].at(response);
             }
         }
         questionWithResponses += "\n\n\n";
@@ -1541,16 +1694,16 @@ QStringList TeamsTabItem::createStdFileContents()
 
     // get the relevant gender terminology
     QStringList genderOptions;
-    if(teams.dataOptions.genderType == GenderType::biol) {
+    if(teams.dataOptions->genderType == GenderType::biol) {
         genderOptions = QString(BIOLGENDERS7CHAR).split('/');
     }
-    else if(teams.dataOptions.genderType == GenderType::adult) {
+    else if(teams.dataOptions->genderType == GenderType::adult) {
         genderOptions = QString(ADULTGENDERS7CHAR).split('/');
     }
-    else if(teams.dataOptions.genderType == GenderType::child) {
+    else if(teams.dataOptions->genderType == GenderType::child) {
         genderOptions = QString(CHILDGENDERS7CHAR).split('/');
     }
-    else { //if(teams.dataOptions.genderType == GenderType::pronoun)
+    else { //if(teams.dataOptions->genderType == GenderType::pronoun)
         genderOptions = QString(PRONOUNS7CHAR).split('/');
     }
 
@@ -1566,11 +1719,11 @@ QStringList TeamsTabItem::createStdFileContents()
 
         //loop through each teammate in the team
         for(const auto studentID : team.studentIDs) {
-            const auto *const student = findStudentFromID(studentID);
+            const auto *const student = students.findByID(studentID);
             if(student == nullptr) {
                 continue;
             }
-            if(teams.dataOptions.genderIncluded) {
+            if(teams.dataOptions->genderIncluded) {
                 QString genderText;
                 bool firstGender = true;
                 for(const auto gen : student->gender) {
@@ -1582,7 +1735,7 @@ QStringList TeamsTabItem::createStdFileContents()
                 }
                 instructorsFileContents += " " + genderText + " ";
             }
-            if(teams.dataOptions.URMIncluded) {
+            if(teams.dataOptions->URMIncluded) {
                 if(student->URM) {
                     instructorsFileContents += tr(" URM ");
                 }
@@ -1590,20 +1743,20 @@ QStringList TeamsTabItem::createStdFileContents()
                     instructorsFileContents += "     ";
                 }
             }
-            for(int attribute = 0; attribute < teams.dataOptions.numAttributes; attribute++) {
+            for(int attribute = 0; attribute < teams.dataOptions->numAttributes; attribute++) {
                 auto value = student->attributeVals[attribute].constBegin();
                 if(*value != -1) {
-                    if(teams.dataOptions.attributeType[attribute] == DataOptions::AttributeType::ordered) {
+                    if(teams.dataOptions->attributeType[attribute] == DataOptions::AttributeType::ordered) {
                         instructorsFileContents += (QString::number(*value)).leftJustified(3);
                     }
-                    else if(teams.dataOptions.attributeType[attribute] == DataOptions::AttributeType::timezone) {
+                    else if(teams.dataOptions->attributeType[attribute] == DataOptions::AttributeType::timezone) {
                         instructorsFileContents += (QString::number(student->timezone)).leftJustified(5);
                     }
-                    else if(teams.dataOptions.attributeType[attribute] == DataOptions::AttributeType::categorical) {
+                    else if(teams.dataOptions->attributeType[attribute] == DataOptions::AttributeType::categorical) {
                         instructorsFileContents += ((*value) <= 26 ? (QString(char((*value)-1 + 'A'))).leftJustified(3) :
                                                                      (QString(char(((*value)-1)%26 + 'A')).repeated(1+(((*value)-1)/26)))).leftJustified(3);
                     }
-                    else if(teams.dataOptions.attributeType[attribute] == DataOptions::AttributeType::multicategorical) {
+                    else if(teams.dataOptions->attributeType[attribute] == DataOptions::AttributeType::multicategorical) {
                         const auto lastValue = student->attributeVals[attribute].constEnd();
                         QString attributeList;
                         while(value != lastValue) {
@@ -1616,7 +1769,7 @@ QStringList TeamsTabItem::createStdFileContents()
                         }
                         instructorsFileContents += attributeList.leftJustified(3);
                     }
-                    else if(teams.dataOptions.attributeType[attribute] == DataOptions::AttributeType::multiordered) {
+                    else if(teams.dataOptions->attributeType[attribute] == DataOptions::AttributeType::multiordered) {
                         const auto lastValue = student->attributeVals[attribute].constEnd();
                         QString attributeList;
                         while(value != lastValue) {
@@ -1633,7 +1786,7 @@ QStringList TeamsTabItem::createStdFileContents()
                     instructorsFileContents += (QString("?")).leftJustified(3);
                 }
             }
-            if(teams.dataOptions.sectionIncluded && teamingOptions->sectionType == TeamingOptions::SectionType::allTogether) {
+            if(teams.dataOptions->sectionIncluded && teamingOptions->sectionType == TeamingOptions::SectionType::allTogether) {
                 instructorsFileContents += student->section;
             }
             const int nameSize = int((student->firstname + " " + student->lastname).size());
@@ -1641,14 +1794,14 @@ QStringList TeamsTabItem::createStdFileContents()
                                         QString(std::max(2,30-nameSize), ' ') + student->email + "\n";
             studentsFileContents += student->firstname + " " + student->lastname +
                                     QString(std::max(2,30-nameSize), ' ') + student->email + "\n";
-            spreadsheetFileContents += student->section + "\t" + team.name + "\t" + student->firstname +
+            spreadsheetFileContents += student->section.toString() + "\t" + team.name + "\t" + student->firstname +
                                        " " + student->lastname + "\t" + student->email + "\n";
         }
-        if(!teams.dataOptions.dayNames.isEmpty()) {
+        if(!teams.dataOptions->dayNames.isEmpty()) {
             instructorsFileContents += "\n" + tr("Availability:") + "\n            ";
             studentsFileContents += "\n" + tr("Availability:") + "\n            ";
 
-            for(const auto &dayName : qAsConst(teams.dataOptions.dayNames)) {
+            for(const auto &dayName : qAsConst(teams.dataOptions->dayNames)) {
                 // using first 3 characters in day name as abbreviation
                 instructorsFileContents += "  " + dayName.left(3) + "  ";
                 studentsFileContents += "  " + dayName.left(3) + "  ";
@@ -1656,19 +1809,19 @@ QStringList TeamsTabItem::createStdFileContents()
             instructorsFileContents += "\n";
             studentsFileContents += "\n";
 
-            for(int time = 0; time < teams.dataOptions.timeNames.size(); time++) {
-                instructorsFileContents += teams.dataOptions.timeNames.at(time) + QString((11-teams.dataOptions.timeNames.at(time).size()), ' ');
-                studentsFileContents += teams.dataOptions.timeNames.at(time) + QString((11-teams.dataOptions.timeNames.at(time).size()), ' ');
-                for(int day = 0; day < teams.dataOptions.dayNames.size(); day++) {
+            for(int time = 0; time < teams.dataOptions->timeNames.size(); time++) {
+                instructorsFileContents += teams.dataOptions->timeNames.at(time) + QString((11-teams.dataOptions->timeNames.at(time).size()), ' ');
+                studentsFileContents += teams.dataOptions->timeNames.at(time) + QString((11-teams.dataOptions->timeNames.at(time).size()), ' ');
+                for(int day = 0; day < teams.dataOptions->dayNames.size(); day++) {
                     QString percentage;
-                    if(team.size > team.numStudentsWithAmbiguousSchedules) {
-                        percentage = QString::number((100*team.numStudentsAvailable[day][time]) /
-                                                     (team.size-team.numStudentsWithAmbiguousSchedules)) + "% ";
+                    if(team.size > team.info().numStudentsWithAmbiguousSchedules) {
+                        percentage = QString::number((100*team.info().numStudentsAvailable[day][time]) /
+                                                     (team.size-team.info().numStudentsWithAmbiguousSchedules)) + "% ";
                     }
                     else {
                         percentage = "?";
                     }
-                    const QStringView left3 = QStringView{teams.dataOptions.dayNames.at(day).left(3)};
+                    const QStringView left3 = QStringView{teams.dataOptions->dayNames.at(day).left(3)};
                     instructorsFileContents += QString((4+left3.size())-percentage.size(), ' ') + percentage;
                     studentsFileContents += QString((4+left3.size())-percentage.size(), ' ') + percentage;
                 }
@@ -1688,31 +1841,31 @@ QString TeamsTabItem::createCustomFileContents(WhichFilesDialog::CustomFileOptio
     QString customFileContents = "";
 
     if(customFileOptions.includeFileData) {
-        customFileContents = tr("Source: ") + teams.dataOptions.dataSourceName;
-        if(teams.dataOptions.sectionIncluded) {
+        customFileContents = tr("Source: ") + teams.dataOptions->dataSourceName;
+        if(teams.dataOptions->sectionIncluded) {
             customFileContents += "\n" + tr("Section: ") + teamingOptions->sectionName;
         }
         customFileContents += "\n\n";
     }
     if(customFileOptions.includeTeamingData) {
         customFileContents += tr("Teaming Options") + ":";
-        if(teams.dataOptions.genderIncluded) {
+        if(teams.dataOptions->genderIncluded) {
             customFileContents += (teamingOptions->isolatedWomenPrevented? ("\n" + tr("Isolated women prevented")) : "");
             customFileContents += (teamingOptions->isolatedMenPrevented? ("\n" + tr("Isolated men prevented")) : "");
             customFileContents += (teamingOptions->isolatedNonbinaryPrevented? ("\n" + tr("Isolated nonbinary students prevented")) : "");
             customFileContents += (teamingOptions->singleGenderPrevented? ("\n" + tr("Single gender teams prevented")) : "");
         }
-        if(teams.dataOptions.URMIncluded && teamingOptions->isolatedURMPrevented) {
+        if(teams.dataOptions->URMIncluded && teamingOptions->isolatedURMPrevented) {
             customFileContents += "\n" + tr("Isolated URM students prevented");
         }
-        if(!teams.dataOptions.dayNames.isEmpty() && teamingOptions->scheduleWeight > 0) {
+        if(!teams.dataOptions->dayNames.isEmpty() && teamingOptions->scheduleWeight > 0) {
             customFileContents += "\n" + tr("Meeting block size is ") + QString::number(teamingOptions->meetingBlockSize)
                                        + tr(" hour") + ((teamingOptions->meetingBlockSize == 1) ? "" : tr("s"));
             customFileContents += "\n" + tr("Minimum number of meeting times = ") + QString::number(teamingOptions->minTimeBlocksOverlap);
             customFileContents += "\n" + tr("Desired number of meeting times = ") + QString::number(teamingOptions->desiredTimeBlocksOverlap);
             customFileContents += "\n" + tr("Schedule weight = ") + QString::number(double(teamingOptions->scheduleWeight));
         }
-        for(int attrib = 0; attrib < teams.dataOptions.numAttributes; attrib++) {
+        for(int attrib = 0; attrib < teams.dataOptions->numAttributes; attrib++) {
             customFileContents += "\n" + tr("Multiple choice Q") + QString::number(attrib+1) + ": "
                                   + tr("weight") + " = " + QString::number(double(teamingOptions->attributeWeights[attrib]));
             if (teamingOptions->attributeDiversity[attrib] == 1) {
@@ -1724,20 +1877,20 @@ QString TeamsTabItem::createCustomFileContents(WhichFilesDialog::CustomFileOptio
             }
         }
         customFileContents += "\n\n\n";
-        for(int attrib = 0; attrib < teams.dataOptions.numAttributes; attrib++) {
+        for(int attrib = 0; attrib < teams.dataOptions->numAttributes; attrib++) {
             QString questionWithResponses = tr("Multiple choice Q") + QString::number(attrib+1) + "\n" +
-                                            teams.dataOptions.attributeQuestionText.at(attrib) + "\n" + tr("Responses:");
-            for(int response = 0; response < teams.dataOptions.attributeQuestionResponses[attrib].size(); response++) {
-                if((teams.dataOptions.attributeType[attrib] == DataOptions::AttributeType::ordered) ||
-                    (teams.dataOptions.attributeType[attrib] == DataOptions::AttributeType::multiordered) ||
-                    (teams.dataOptions.attributeType[attrib] == DataOptions::AttributeType::timezone)) {
-                    questionWithResponses += "\n\t" + teams.dataOptions.attributeQuestionResponses[attrib].at(response);
+                                            teams.dataOptions->attributeQuestionText.at(attrib) + "\n" + tr("Responses:");
+            for(int response = 0; response < teams.dataOptions->attributeQuestionResponses[attrib].size(); response++) {
+                if((teams.dataOptions->attributeType[attrib] == DataOptions::AttributeType::ordered) ||
+                    (teams.dataOptions->attributeType[attrib] == DataOptions::AttributeType::multiordered) ||
+                    (teams.dataOptions->attributeType[attrib] == DataOptions::AttributeType::timezone)) {
+                    questionWithResponses += "\n\t" + teams.dataOptions->attributeQuestionResponses[attrib].at(response);
                 }
-                else if((teams.dataOptions.attributeType[attrib] == DataOptions::AttributeType::categorical) ||
-                         (teams.dataOptions.attributeType[attrib] == DataOptions::AttributeType::multicategorical)) {
+                else if((teams.dataOptions->attributeType[attrib] == DataOptions::AttributeType::categorical) ||
+                         (teams.dataOptions->attributeType[attrib] == DataOptions::AttributeType::multicategorical)) {
                     questionWithResponses += "\n\t" + (response < 26 ? QString(char(response + 'A')) :
                                                            QString(char(response%26 + 'A')).repeated(1 + (response/26)));
-                    questionWithResponses += ". " + teams.dataOptions.attributeQuestionResponses[attrib].at(response);
+                    questionWithResponses += ". " + teams.dataOptions->attributeQuestionResponses[attrib].at(response);
                 }
             }
             questionWithResponses += "\n\n\n";
@@ -1747,16 +1900,16 @@ QString TeamsTabItem::createCustomFileContents(WhichFilesDialog::CustomFileOptio
 
     // get the relevant gender terminology
     QStringList genderOptions;
-    if(teams.dataOptions.genderType == GenderType::biol) {
+    if(teams.dataOptions->genderType == GenderType::biol) {
         genderOptions = QString(BIOLGENDERS7CHAR).split('/');
     }
-    else if(teams.dataOptions.genderType == GenderType::adult) {
+    else if(teams.dataOptions->genderType == GenderType::adult) {
         genderOptions = QString(ADULTGENDERS7CHAR).split('/');
     }
-    else if(teams.dataOptions.genderType == GenderType::child) {
+    else if(teams.dataOptions->genderType == GenderType::child) {
         genderOptions = QString(CHILDGENDERS7CHAR).split('/');
     }
-    else { //if(teams.dataOptions.genderType == GenderType::pronoun)
+    else { //if(teams.dataOptions->genderType == GenderType::pronoun)
         genderOptions = QString(PRONOUNS7CHAR).split('/');
     }
 
@@ -1774,11 +1927,11 @@ QString TeamsTabItem::createCustomFileContents(WhichFilesDialog::CustomFileOptio
 
         //loop through each teammate in the team
         for(const auto studentID : team.studentIDs) {
-            const auto *const student = findStudentFromID(studentID);
+            const auto *const student = students.findByID(studentID);
             if(student == nullptr) {
                 continue;
             }
-            if(teams.dataOptions.genderIncluded && customFileOptions.includeGender) {
+            if(teams.dataOptions->genderIncluded && customFileOptions.includeGender) {
                 QString genderText;
                 bool firstGender = true;
                 for(const auto gen : student->gender) {
@@ -1790,7 +1943,7 @@ QString TeamsTabItem::createCustomFileContents(WhichFilesDialog::CustomFileOptio
                 }
                 customFileContents += " " + genderText + " ";
             }
-            if(teams.dataOptions.URMIncluded && customFileOptions.includeURM) {
+            if(teams.dataOptions->URMIncluded && customFileOptions.includeURM) {
                 if(student->URM) {
                     customFileContents += tr(" URM ");
                 }
@@ -1798,21 +1951,21 @@ QString TeamsTabItem::createCustomFileContents(WhichFilesDialog::CustomFileOptio
                     customFileContents += "     ";
                 }
             }
-            for(int attribute = 0; attribute < teams.dataOptions.numAttributes; attribute++) {
+            for(int attribute = 0; attribute < teams.dataOptions->numAttributes; attribute++) {
                 if(customFileOptions.includeMultiChoice.at(attribute)) {
                     auto value = student->attributeVals[attribute].constBegin();
                     if(*value != -1) {
-                        if(teams.dataOptions.attributeType[attribute] == DataOptions::AttributeType::ordered) {
+                        if(teams.dataOptions->attributeType[attribute] == DataOptions::AttributeType::ordered) {
                             customFileContents += (QString::number(*value)).leftJustified(3);
                         }
-                        else if(teams.dataOptions.attributeType[attribute] == DataOptions::AttributeType::timezone) {
+                        else if(teams.dataOptions->attributeType[attribute] == DataOptions::AttributeType::timezone) {
                             customFileContents += (QString::number(student->timezone)).leftJustified(5);
                         }
-                        else if(teams.dataOptions.attributeType[attribute] == DataOptions::AttributeType::categorical) {
+                        else if(teams.dataOptions->attributeType[attribute] == DataOptions::AttributeType::categorical) {
                             customFileContents += ((*value) <= 26 ? (QString(char((*value)-1 + 'A'))).leftJustified(3) :
                                                                     (QString(char(((*value)-1)%26 + 'A')).repeated(1+(((*value)-1)/26)))).leftJustified(3);
                         }
-                        else if(teams.dataOptions.attributeType[attribute] == DataOptions::AttributeType::multicategorical) {
+                        else if(teams.dataOptions->attributeType[attribute] == DataOptions::AttributeType::multicategorical) {
                             const auto lastValue = student->attributeVals[attribute].constEnd();
                             QString attributeList;
                             while(value != lastValue) {
@@ -1825,7 +1978,7 @@ QString TeamsTabItem::createCustomFileContents(WhichFilesDialog::CustomFileOptio
                             }
                             customFileContents += attributeList.leftJustified(3);
                         }
-                        else if(teams.dataOptions.attributeType[attribute] == DataOptions::AttributeType::multiordered) {
+                        else if(teams.dataOptions->attributeType[attribute] == DataOptions::AttributeType::multiordered) {
                             const auto lastValue = student->attributeVals[attribute].constEnd();
                             QString attributeList;
                             while(value != lastValue) {
@@ -1843,11 +1996,11 @@ QString TeamsTabItem::createCustomFileContents(WhichFilesDialog::CustomFileOptio
                     }
                 }
             }
-            if(teams.dataOptions.sectionIncluded && customFileOptions.includeSect) {
+            if(teams.dataOptions->sectionIncluded && customFileOptions.includeSect) {
                 customFileContents += student->section;
             }
-            if((teams.dataOptions.firstNameField != DataOptions::FIELDNOTPRESENT && customFileOptions.includeFirstName) ||
-               (teams.dataOptions.lastNameField != DataOptions::FIELDNOTPRESENT && customFileOptions.includeLastName)) {
+            if((teams.dataOptions->firstNameField != DataOptions::FIELDNOTPRESENT && customFileOptions.includeFirstName) ||
+               (teams.dataOptions->lastNameField != DataOptions::FIELDNOTPRESENT && customFileOptions.includeLastName)) {
                 int nameSize = 0, nameWidth = 0;
                 customFileContents += "\t";
                 if(customFileOptions.includeFirstName) {
@@ -1865,32 +2018,32 @@ QString TeamsTabItem::createCustomFileContents(WhichFilesDialog::CustomFileOptio
                 }
                 customFileContents += QString(std::max(2, nameWidth-nameSize), ' ');
             }
-            if(teams.dataOptions.emailField != DataOptions::FIELDNOTPRESENT && customFileOptions.includeEmail) {
+            if(teams.dataOptions->emailField != DataOptions::FIELDNOTPRESENT && customFileOptions.includeEmail) {
                 customFileContents += student->email;
             }
             customFileContents += "\n";
         }
-        if(!teams.dataOptions.dayNames.isEmpty() & customFileOptions.includeSechedule) {
+        if(!teams.dataOptions->dayNames.isEmpty() & customFileOptions.includeSechedule) {
             customFileContents += "\n" + tr("Availability:") + "\n            ";
 
-            for(const auto &dayName : qAsConst(teams.dataOptions.dayNames)) {
+            for(const auto &dayName : qAsConst(teams.dataOptions->dayNames)) {
                 // using first 3 characters in day name as abbreviation
                 customFileContents += "  " + dayName.left(3) + "  ";
             }
             customFileContents += "\n";
 
-            for(int time = 0; time < teams.dataOptions.timeNames.size(); time++) {
-                customFileContents += teams.dataOptions.timeNames.at(time) + QString((11-teams.dataOptions.timeNames.at(time).size()), ' ');
-                for(int day = 0; day < teams.dataOptions.dayNames.size(); day++) {
+            for(int time = 0; time < teams.dataOptions->timeNames.size(); time++) {
+                customFileContents += teams.dataOptions->timeNames.at(time) + QString((11-teams.dataOptions->timeNames.at(time).size()), ' ');
+                for(int day = 0; day < teams.dataOptions->dayNames.size(); day++) {
                     QString percentage;
-                    if(team.size > team.numStudentsWithAmbiguousSchedules) {
-                        percentage = QString::number((100*team.numStudentsAvailable[day][time]) /
-                                                     (team.size-team.numStudentsWithAmbiguousSchedules)) + "% ";
+                    if(team.size > team.info().numStudentsWithAmbiguousSchedules) {
+                        percentage = QString::number((100*team.info().numStudentsAvailable[day][time]) /
+                                                     (team.size-team.info().numStudentsWithAmbiguousSchedules)) + "% ";
                     }
                     else {
                         percentage = "?";
                     }
-                    const QStringView left3 = QStringView{teams.dataOptions.dayNames.at(day).left(3)};
+                    const QStringView left3 = QStringView{teams.dataOptions->dayNames.at(day).left(3)};
                     customFileContents += QString((4+left3.size())-percentage.size(), ' ') + percentage;
                 }
                 customFileContents += "\n";
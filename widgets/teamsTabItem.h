@@ -9,6 +9,7 @@
 #include "widgets/teamTreeWidget.h"
 #include <QCheckBox>
 #include <QComboBox>
+#include <QHash>
 #include <QJsonObject>
 #include <QLabel>
 #include <QPrinter>
@@ -20,26 +21,31 @@ class TeamsTabItem : public QWidget
 Q_OBJECT
 
 public:
-    explicit TeamsTabItem(TeamingOptions &incomingTeamingOptions, const TeamSet &incomingTeamSet, QList<StudentRecord> &incomingStudents,
+    explicit TeamsTabItem(TeamingOptions &incomingTeamingOptions, const TeamSet &incomingTeamSet, StudentList &incomingStudents,
                           const QStringList &incomingSectionNames, const QString &incomingTabName, QPushButton *letsDoItButton, QWidget *parent = nullptr);
-    explicit TeamsTabItem(const QJsonObject &jsonTeamsTab, TeamingOptions &incomingTeamingOptions, QList<StudentRecord> &incomingStudents,
+    explicit TeamsTabItem(const QJsonObject &jsonTeamsTab, TeamingOptions &incomingTeamingOptions, StudentList &incomingStudents,
                           const QStringList &incomingSectionNames, QPushButton *letsDoItButton, QWidget *parent = nullptr);
     // handle the rest of the constructor work after loading data
     enum class TabType{newTab, fromJSON};
-    void init(TeamingOptions &incomingTeamingOptions, QList<StudentRecord> &incomingStudents, QPushButton *letsDoItButton, TabType tabType);
+    void init(TeamingOptions &incomingTeamingOptions, StudentList &incomingStudents, QPushButton *letsDoItButton, TabType tabType);
     ~TeamsTabItem() override;
     TeamsTabItem(const TeamsTabItem&) = delete;
     TeamsTabItem operator= (const TeamsTabItem&) = delete;
     TeamsTabItem(TeamsTabItem&&) = delete;
     TeamsTabItem& operator= (TeamsTabItem&&) = delete;
 
-    QJsonObject toJson() const;
+    // everything in the tab that is saved, copied (mostly implicitly shared) so that it can be converted to JSON on another thread
+    struct SavedContents {QJsonObject teamingOptions; TeamSet teams; QList<int> teamDisplayOrder; StudentList students; int numStudents = 1;
+                          bool randomizedTeamNames = false; bool sectionsInTeamNames = false; QString tabName;
+                          QJsonObject toJson() const;};
+    SavedContents savedContents() const;
 
     QString tabName;
 
 signals:
     void connectedToPrinter();
     void saveState();
+    void studentsChanged();     // the students out in gruepr were changed
 
 private slots:
     QWidget* createScoreLegend();
@@ -52,6 +58,7 @@ private slots:
     void moveAStudent(const QList<int> &arguments); // arguments = int oldTeam, int studentID, int newTeam
     void moveATeam(const QList<int> &arguments);    // arguments = int teamA, int teamB
     void undoRedoDragDrop();
+    void suggestImprovements();
 
     void makeNewSetWithAllNewTeammates();
 
@@ -66,13 +73,20 @@ private:
     void refreshTeamDisplay();
     void refreshDisplayOrder();
     QList<int> getTeamNumbersInDisplayOrder() const;
-    inline StudentRecord* findStudentFromID(const long long ID);
+    void populateTeamItem(TeamTreeWidgetItem *teamItem);          // adds the student items, the first time the team is expanded
+    void refreshTeamItem(const int teamNum);                       // refreshes the team's info and its row, but not its students' rows
+    TeamTreeWidgetItem *findStudentItem(const TeamTreeWidgetItem *teamItem, const long long studentID) const;   // nullptr if not (yet) shown
+    TeamTreeWidget::ScorePreview previewScores(const QList<int> &arguments) const;    // arguments as for swapStudents or moveAStudent
+    struct SuggestedChange {QList<int> arguments; float netChange = 0;};                 // arguments as for swapStudents or moveAStudent
+    QList<SuggestedChange> findBestChanges(int maxSuggestions);
 
     TeamingOptions *teamingOptions = nullptr;
     QStringList sectionNames;
     TeamSet teams;
-    QList<StudentRecord> students;
+    StudentList students;
     int numStudents = 1;
+    QHash<int, TeamTreeWidgetItem*> teamItemsByNumber;      // the item in teamDataTree for each team number
+    std::set<long long> studentIDsInTeams;      // for checking teammate rules when scoring just some of the teams
 
     struct UndoRedoItem{void (TeamsTabItem::*action)(const QList<int> &arguments);
                         QList<int> arguments;
@@ -81,6 +95,9 @@ private:
     QList<UndoRedoItem> redoItems;
     QPushButton *undoButton = nullptr;
     QPushButton *redoButton = nullptr;
+    QPushButton *suggestButton = nullptr;
+    inline static const int MAXSUGGESTIONS = 10;
+    inline static const float MINSUGGESTEDCHANGE = 0.01F;   // smallest increase in the net score worth suggesting
 
     static const QStringList teamnameCategories;
     static const QStringList teamnameLists;
@@ -92,7 +109,7 @@ private:
 
     //pointers to items back out in gruepr, so they can be used for "create new teams with all new teammates"
     TeamingOptions *externalTeamingOptions = nullptr;
-    QList<StudentRecord> *externalStudents = nullptr;
+    StudentList *externalStudents = nullptr;
     QPushButton *externalDoItButton = nullptr;
 
     enum files{studentFile = 0, instructorFile = 1, spreadsheetFile = 2, customFile = 3};